@@ -1,93 +1,172 @@
-/*
- * JDY-09.h
- *
- *  Created on: April 24, 2023
- *      Author: Ezrah Buki
- */
-#include "ringbuffer.h"
-
-#ifndef INC_JDY_09_H_
-#define INC_JDY_09_H_
-
-// To define by user, all characters until this character will be transfered to buffer
-#define JDY09_LASTCHARACTER				'\n'
-
-#define JDY09_MAX_CMD_LENGHT			32
-#define JDY09_UART_TIMEOUET				1000
-
-// Predefined baud rate
-#define JDY09_BAUDRATE_9600 			4
-#define JDY09_BAUDRATE_19200 			5
-#define JDY09_BAUDRATE_38400 			6
-#define JDY09_BAUDRATE_57600 			7
-#define JDY09_BAUDRATE_115200 			8
-#define JDY09_BAUDRATE_128000 			9
-
-// Maximum message size
-#define JDY09_RECIEVEBUFFERSIZE			64
-
-// Message pending
-#define JDY09_NOMESSAGE					0
-#define JDY09_MESSAGEPENDING			1
-
-// Maximum pin and lenght
-#define JDY09_MAX_NAME_LENGHT			18
-#define JDY09_MAX_PIN_LENGHT			4
-
-// Define RX - IT/DMA
-#define JDY09_UART_RX_IT				0
-
-#if (JDY09_UART_RX_IT == 0)
-#define JDY09_UART_RX_DMA				1
-#endif
-
-// Commands to MCU
-typedef enum JDY09{
-	JDY09_CMD_GETVERSION,
-	JDY09_CMD_RESET,
-	JDY09_CMD_GETADRESS,
-	JDY09_CMD_GETBAUDRATE,
-	JDY09_CMD_GETPASSWORD,
-	JDY09_CMD_GETNAME,
-	JDY09_CMD_SETDEFAULTSETTINGS
-}JDY09_CMD;
-
-typedef struct JDY09_t
-{
-	UART_HandleTypeDef*	huart; 						// Uart handle
-
-	uint8_t RecieveBufferDMA[JDY09_RECIEVEBUFFERSIZE]; // buffer for received messages in DMA mode
-
-	uint8_t RecieveBufferIT;// 1 byte buffer for a single char received in IRQ mode
-
-	Ringbuffer_t RingBuffer;						// ring buffer to save data
-
-	volatile uint8_t LinesRecieved;					// lines that were received
-
-	uint8_t MessagePending;							// status that message is ready to parse
-
-	GPIO_TypeDef*	StateGPIOPort;					// handle for state pin
-
-	uint16_t		StatePinNumber;					// pin number for state pin
-
-
-}JDY09_t;
-
-
-void JDY09_Init(JDY09_t *jdy09, UART_HandleTypeDef *huart, GPIO_TypeDef *StateGPIOPort, uint16_t StateGPIOPin);
-void JDY09_SendCommand(JDY09_t* jdy09, JDY09_CMD Command);
-void JDY09_SendData(JDY09_t *jdy09, uint8_t* Data);
-void JDY09_SetBaudRate(JDY09_t* jdy09,uint8_t Baudrate);
-void JDY09_SetName(JDY09_t* jdy09,uint8_t* Name);
-void JDY09_SetPassword(JDY09_t* jdy09,uint8_t* Password);
-void JDY09_Disconnect(JDY09_t *jdy09);
-void JDY09_ClearMsgPendingFlag(JDY09_t* jdy09);
-uint8_t JDY09_CheckPendingMessages(JDY09_t* jdy09,uint8_t* MsgBuffer);
-#if (JDY09_UART_RX_IT == 1)
-void JDY09_RxCpltCallbackIT(JDY09_t *jdy09, UART_HandleTypeDef *huart);
-#endif
-#if (JDY09_UART_RX_DMA == 1)
-void JDY09_RxCpltCallbackDMA(JDY09_t *jdy09, UART_HandleTypeDef *huart,uint16_t size);
-#endif
-void JDY09_EXTICallback(JDY09_t *jdy09, uint16_t GPIO_Pin);
-#endif /* INC_JDY_09_H_ */
+/*
+ * JDY-09.h
+ *
+ *  Created on: April 24, 2023
+ *      Author: Ezrah Buki
+ */
+#include "ringbuffer.h"
+
+#ifndef INC_JDY_09_H_
+#define INC_JDY_09_H_
+
+// To define by user, all characters until this character will be transfered to buffer
+#define JDY09_LASTCHARACTER				'\n'
+
+#define JDY09_MAX_CMD_LENGHT			32
+#define JDY09_UART_TIMEOUET				1000
+
+// Predefined baud rate
+#define JDY09_BAUDRATE_9600 			4
+#define JDY09_BAUDRATE_19200 			5
+#define JDY09_BAUDRATE_38400 			6
+#define JDY09_BAUDRATE_57600 			7
+#define JDY09_BAUDRATE_115200 			8
+#define JDY09_BAUDRATE_128000 			9
+
+// Baud rate negotiation
+#define JDY09_PROBE_TIMEOUT				200		// time to wait for response on probe command [ms]
+#define JDY09_RESET_DELAY				500		// time for module to restart after AT+RESET [ms]
+
+// Maximum message size
+#define JDY09_RECIEVEBUFFERSIZE			64
+
+// Frames waiting for transmission, every frame is a pool block
+#define JDY09_TX_QUEUE_SIZE				4
+
+// Refused DMA starts of one frame before it is dropped, so dead UART does not block the queue
+#define JDY09_TX_MAX_RETRIES			16
+
+// Maximum line lenght stored in ring buffer, buffer for a line needs 2 more bytes (end of line and 0)
+#define JDY09_MAX_LINE_LENGHT			(JDY09_RECIEVEBUFFERSIZE - 2)
+
+// What to do with lines longer than JDY09_MAX_LINE_LENGHT @oversize
+#define JDY09_LINE_TRUNCATE				0		// keep beginning of the line
+#define JDY09_LINE_DISCARD				1		// drop whole line
+#define JDY09_LINE_OVERSIZE_POLICY		JDY09_LINE_TRUNCATE
+
+// State of line currently received
+#define JDY09_LINESTATE_OK				0
+#define JDY09_LINESTATE_TRUNCATED		1
+#define JDY09_LINESTATE_DROPPED			2
+
+// Message pending
+#define JDY09_NOMESSAGE					0
+#define JDY09_MESSAGEPENDING			1
+
+// Status codes @status
+#define JDY09_OK						0
+#define JDY09_ERR_NORESPONSE			1
+#define JDY09_ERR_WRONGRESPONSE			2
+#define JDY09_ERR_ONLINE				3
+#define JDY09_ERR_WRONGBAUD				4
+#define JDY09_ERR_FALLBACK				5
+#define JDY09_ERR_NOMEMORY				6		// no free pool block for response
+#define JDY09_ERR_BUSY					7		// transmit queue full, frame dropped
+
+// Maximum pin and lenght
+#define JDY09_MAX_NAME_LENGHT			18
+#define JDY09_MAX_PIN_LENGHT			4
+
+// Define RX - IT/DMA
+#define JDY09_UART_RX_IT				0
+
+#if (JDY09_UART_RX_IT == 0)
+#define JDY09_UART_RX_DMA				1
+#endif
+
+// Commands to MCU
+typedef enum JDY09{
+	JDY09_CMD_GETVERSION,
+	JDY09_CMD_RESET,
+	JDY09_CMD_GETADRESS,
+	JDY09_CMD_GETBAUDRATE,
+	JDY09_CMD_GETPASSWORD,
+	JDY09_CMD_GETNAME,
+	JDY09_CMD_SETDEFAULTSETTINGS
+}JDY09_CMD;
+
+// Receive statistics
+typedef struct
+{
+	uint32_t OverflowBytes;		// bytes lost because ring buffer was full
+	uint32_t DroppedLines;		// lines dropped (overflow, oversize, missing end of line)
+	uint32_t TruncatedLines;	// lines cut to JDY09_MAX_LINE_LENGHT
+}JDY09_RxStats_t;
+
+// Transmit statistics
+typedef struct
+{
+	uint32_t Frames;			// frames handed to DMA
+	uint32_t Retries;			// DMA start refused (HAL_BUSY), frame kept in queue
+	uint32_t Dropped;			// frames lost, queue full, no pool block or too many retries
+	uint32_t RetryDrops;		// frames dropped after JDY09_TX_MAX_RETRIES, also in Dropped
+}JDY09_TxStats_t;
+
+typedef struct JDY09_t
+{
+	UART_HandleTypeDef*	huart; 						// Uart handle
+
+	uint8_t RecieveBufferDMA[JDY09_RECIEVEBUFFERSIZE]; // buffer for received messages in DMA mode
+
+	uint8_t RecieveBufferIT;// 1 byte buffer for a single char received in IRQ mode
+
+	Ringbuffer_t RingBuffer;						// ring buffer to save data
+
+	volatile uint8_t LinesRecieved;					// lines that were received
+
+	uint16_t		LineStart;						// ring buffer head where current line starts
+
+	uint16_t		LineLenght;						// bytes of current line stored in ring buffer
+
+	uint8_t			LineState;						// state of current line
+
+	volatile uint8_t LineErrorPending;				// line without end of line, error is sent from main loop
+
+	JDY09_RxStats_t	RxStats;						// receive statistics
+
+	uint8_t			*TxQueue[JDY09_TX_QUEUE_SIZE];	// frames waiting for transmission
+	uint16_t		TxLenght[JDY09_TX_QUEUE_SIZE];	// bytes of waiting frames
+	uint8_t			TxHead;							// place for next frame
+	uint8_t			TxTail;							// next frame to send
+	volatile uint8_t TxCount;						// frames in queue
+	uint8_t			TxRetries;						// refused DMA starts of frame at TxTail
+
+	uint8_t *volatile TxFrame;						// frame sent by DMA now
+
+	JDY09_TxStats_t	TxStats;						// transmit statistics
+
+	uint8_t MessagePending;							// status that message is ready to parse
+
+	GPIO_TypeDef*	StateGPIOPort;					// handle for state pin
+
+	uint16_t		StatePinNumber;					// pin number for state pin
+
+	uint8_t			BaudRate;						// predefined baud rate currently used on uart
+
+}JDY09_t;
+
+
+void JDY09_Init(JDY09_t *jdy09, UART_HandleTypeDef *huart, GPIO_TypeDef *StateGPIOPort, uint16_t StateGPIOPin);
+void JDY09_SendCommand(JDY09_t* jdy09, JDY09_CMD Command);
+void JDY09_SendData(JDY09_t *jdy09, uint8_t* Data);
+uint8_t JDY09_SetBaudRate(JDY09_t* jdy09,uint8_t Baudrate);
+uint8_t JDY09_DetectBaudRate(JDY09_t* jdy09);
+void JDY09_SetName(JDY09_t* jdy09,uint8_t* Name);
+void JDY09_SetPassword(JDY09_t* jdy09,uint8_t* Password);
+void JDY09_Disconnect(JDY09_t *jdy09);
+uint8_t JDY09_IsConnected(JDY09_t *jdy09);
+void JDY09_ClearMsgPendingFlag(JDY09_t* jdy09);
+uint8_t JDY09_CheckPendingMessages(JDY09_t* jdy09,uint8_t* MsgBuffer);
+uint8_t JDY09_Transmit(JDY09_t *jdy09, uint8_t *Frame, uint16_t Lenght, uint32_t Timeout);
+void JDY09_TxProcess(JDY09_t *jdy09);
+uint8_t JDY09_WaitTxIdle(JDY09_t *jdy09, uint32_t Timeout);
+uint8_t JDY09_IsTxBusy(JDY09_t *jdy09);
+void JDY09_TxCpltCallback(JDY09_t *jdy09, UART_HandleTypeDef *huart);
+#if (JDY09_UART_RX_IT == 1)
+void JDY09_RxCpltCallbackIT(JDY09_t *jdy09, UART_HandleTypeDef *huart);
+#endif
+#if (JDY09_UART_RX_DMA == 1)
+void JDY09_RxCpltCallbackDMA(JDY09_t *jdy09, UART_HandleTypeDef *huart,uint16_t size);
+#endif
+void JDY09_EXTICallback(JDY09_t *jdy09, uint16_t GPIO_Pin);
+#endif /* INC_JDY_09_H_ */
@@ -0,0 +1,64 @@
+/*
+ * clockgov.h
+ *
+ *  Created on: 19 October 2026
+ */
+
+#ifndef INC_CLOCKGOV_H_
+#define INC_CLOCKGOV_H_
+
+#include "main.h"
+
+/*
+ * Clock levels @level
+ */
+#define CLOCKGOV_LEVEL_IDLE				0		// HSI 16 MHz, PLL off
+#define CLOCKGOV_LEVEL_RUN				1		// PLL 84 MHz, as set by SystemClock_Config
+#define CLOCKGOV_LEVELS					2
+
+// PLL of run level, same as SystemClock_Config: HSI / 16 * 336 / 4 = 84 MHz
+#define CLOCKGOV_PLLM					16
+#define CLOCKGOV_PLLN					336
+#define CLOCKGOV_PLLP					RCC_PLLP_DIV4
+#define CLOCKGOV_PLLQ					7
+
+// HSI frequency, SYSCLK of idle level
+#define CLOCKGOV_HSI_FREQ				16000000
+
+// AHB divider of idle level 1, 2, 4 or 8. It is lowered while PCLK1 would be under
+// the minimum of I2C speed in use, 2 MHz for standard mode, 4 MHz for fast mode.
+#define CLOCKGOV_IDLE_AHB_DIVIDER		1
+#define CLOCKGOV_I2C_MIN_PCLK1_SM		2000000
+#define CLOCKGOV_I2C_MIN_PCLK1_FM		4000000
+
+// Time without work before clock is dropped to idle level, in ms
+#define CLOCKGOV_IDLE_TIME				500
+
+// TIM1 counter frequency kept on every level, 84 MHz / (8399 + 1)
+#define CLOCKGOV_TIM1_TICK				10000
+
+/*
+ * Clock governor status @status
+ */
+#define CLOCKGOV_OK						0
+#define CLOCKGOV_ERR_BUSY				1		// transfer in progress, level not changed
+#define CLOCKGOV_ERR_RCC				2
+#define CLOCKGOV_ERR_I2C				3		// I2C can not run on new clock, level not changed
+
+typedef struct
+{
+	uint8_t		Level;							// current @level
+	uint32_t	LevelStart;						// tick when current level was set
+	uint32_t	LastBusyTime;					// tick when work was last reported
+	uint32_t	Residency[CLOCKGOV_LEVELS];		// ms spent on every level, without current stay
+	uint32_t	Switches;						// number of level changes
+}ClockGov_t;
+
+void ClockGov_Init(void);
+uint8_t ClockGov_SetLevel(uint8_t Level);
+void ClockGov_Process(uint8_t Busy);
+uint8_t ClockGov_GetLevel(void);
+uint32_t ClockGov_GetResidency(uint8_t Level);
+uint32_t ClockGov_GetSwitches(void);
+
+#endif /* INC_CLOCKGOV_H_ */
@@ -0,0 +1,100 @@
+/*
+ * crash.h
+ *
+ *  Created on: 19 October 2026
+ */
+
+#ifndef INC_CRASH_H_
+#define INC_CRASH_H_
+
+#include "main.h"
+
+/*
+ * Crash record is kept in RAM which is not cleared by startup code.
+ * Linker script has to have this section in RAM, outside of .data and .bss,
+ * crash.c uses its symbols, so without it the image is not linked:
+ *
+ *   .noinit (NOLOAD) :
+ *   {
+ *     . = ALIGN(4);
+ *     _snoinit = .;
+ *     *(.noinit*)
+ *     . = ALIGN(4);
+ *     _enoinit = .;
+ *   } >RAM
+ *
+ * Generated fault handlers in stm32f4xx_it.c branch to Crash_HardFault,
+ * Crash_MemManage, Crash_BusFault and Crash_UsageFault.
+ */
+#define CRASH_NOINIT					__attribute__((section(".noinit")))
+
+#define CRASH_MAGIC						0x48535243		// "CRSH"
+#define CRASH_NO_TASK					0xFF
+
+// Code addresses found on stack above exception frame
+#define CRASH_TRACE_SIZE				8
+// Stack words searched for trace
+#define CRASH_TRACE_DEPTH				64
+
+// Flash range used to recognise return addresses in trace
+#define CRASH_CODE_START				0x08000000
+#define CRASH_CODE_END					0x08040000
+// Start of RAM, stacked frame below it is not read
+#define CRASH_RAM_START					0x20000000
+
+// Stack used by fault handler, faulting stack may be overflowed [B]
+#define CRASH_STACK_SIZE				256
+
+/*
+ * Crash type @type
+ */
+#define CRASH_TYPE_NONE					0
+#define CRASH_TYPE_HARDFAULT			1
+#define CRASH_TYPE_MEMMANAGE			2
+#define CRASH_TYPE_BUSFAULT				3
+#define CRASH_TYPE_USAGEFAULT			4
+#define CRASH_TYPE_ERROR				5		// Error_Handler, PC is its caller
+#define CRASH_TYPE_WATCHDOG				6		// IWDG reset, Task missed its deadline
+
+/*
+ * Crash record, written by fault handler just before reset
+ */
+typedef struct
+{
+	uint32_t	Magic;						// CRASH_MAGIC - record is valid
+	uint32_t	Type;						// @type
+	uint32_t	Uptime;						// HAL tick at crash
+	uint32_t	R0;							// stacked frame
+	uint32_t	R1;
+	uint32_t	R2;
+	uint32_t	R3;
+	uint32_t	R12;
+	uint32_t	LR;
+	uint32_t	PC;
+	uint32_t	PSR;
+	uint32_t	ExcReturn;					// LR at exception entry
+	uint32_t	CFSR;						// configurable fault status
+	uint32_t	HFSR;						// hard fault status
+	uint32_t	MMFAR;						// memory manage fault address
+	uint32_t	BFAR;						// bus fault address
+	uint32_t	Task;						// supervised task, CRASH_NO_TASK - none or unknown
+	uint32_t	Trace[CRASH_TRACE_SIZE];	// possible return addresses, newest first
+	uint32_t	TraceCount;
+	uint32_t	Check;						// sum of all words above
+}Crash_Record_t;
+
+void Crash_Init(void);
+uint8_t Crash_GetLast(Crash_Record_t *Record);
+uint32_t Crash_GetCount(void);
+uint8_t Crash_IsReportPending(void);
+void Crash_ClearReportPending(void);
+void Crash_Error(uint32_t Caller);
+void Crash_Watchdog(uint32_t Task);
+void Crash_Handler(uint32_t *Frame, uint32_t ExcReturn, uint32_t Type);
+void Crash_HardFault(void);
+void Crash_MemManage(void);
+void Crash_BusFault(void);
+void Crash_UsageFault(void);
+const char *Crash_TypeName(uint32_t Type);
+
+#endif /* INC_CRASH_H_ */
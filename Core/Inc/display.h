@@ -0,0 +1,110 @@
+/*
+ * display.h
+ *
+ *  Created on: 19 October 2026
+ */
+
+#ifndef INC_DISPLAY_H_
+#define INC_DISPLAY_H_
+
+// only standard types, rendering is built also on host
+#include "stdint.h"
+
+// Longest display of all backends
+#define DISPLAY_MAX_DIGITS				6
+
+// Values out of range are shown as Err, range of temperature sensors
+#define DISPLAY_FLOAT_MIN				-150.0f
+#define DISPLAY_FLOAT_MAX				150.0f
+// Float values are rendered in hundredths, up to 2 decimals
+#define DISPLAY_FLOAT_SCALE				100
+#define DISPLAY_FLOAT_DECIMALS			2
+
+/*	Segments of one digit :
+ * 				  A
+ *				 ---
+ * 			   F|	|B
+ * 				|G	|
+ * 				 ---
+ * 			   E|	|C
+ * 				|	|
+ * 				 ---
+ * 				  D
+ *
+ * 		bx 	1111 1111
+ * 			SGFE DCBA
+ *
+ * 		S - separator
+ */
+#define DISPLAY_SEG_SEPARATOR			0x80
+#define DISPLAY_SEG_MINUS				0x40
+#define DISPLAY_SEG_BLANK				0x00
+
+// Separator position of Display_ShowDecimal, digit counted from right
+#define DISPLAY_NO_SEPARATOR			0xFF
+
+/*
+ * Render status @render
+ */
+#define DISPLAY_OK						0
+#define DISPLAY_ERR_RANGE				1	// value does not fit, Err rendered
+
+/*
+ * Value kept in render cache @cache
+ */
+#define DISPLAY_CACHE_NONE				0
+#define DISPLAY_CACHE_FLOAT				1
+#define DISPLAY_CACHE_DECIMAL			2
+
+/*
+ * Segment driver, frame is written from the left digit
+ */
+typedef struct
+{
+	const char		*Name;
+	uint8_t			Digits;
+
+	void			(*Init)(void);
+	void			(*WriteFrame)(const uint8_t *Frame, uint8_t Digits);
+	void			(*SetBrightness)(uint8_t Brightness);	// 0 - off, 1-8
+}Display_Backend_t;
+
+typedef struct
+{
+	const Display_Backend_t	*Backend;
+
+	// render cache - same value is not rendered again
+	uint8_t			CacheKind;		// @cache
+	int32_t			CacheValue;		// hundredths for float
+	uint8_t			CacheOption;	// separator of decimal
+	uint8_t			CacheStatus;	// @render
+
+	// frame on display - same frame is not written again
+	uint8_t			Frame[DISPLAY_MAX_DIGITS];
+	uint8_t			FrameValid;
+
+	uint32_t		Renders;
+	uint32_t		Writes;
+}Display_t;
+
+/*
+ * Backends
+ */
+extern const Display_Backend_t TM1637_Display;
+
+void Display_Init(Display_t *Display, const Display_Backend_t *Backend);
+uint8_t Display_ShowFloat(Display_t *Display, float Value);
+uint8_t Display_ShowDecimal(Display_t *Display, int32_t Value, uint8_t Separator);
+void Display_ShowFrame(Display_t *Display, const uint8_t *Frame);
+void Display_ShowText(Display_t *Display, const char *Text);
+void Display_Clear(Display_t *Display);
+void Display_SetBrightness(Display_t *Display, uint8_t Brightness);
+void Display_Invalidate(Display_t *Display);
+
+// pure rendering, no hardware
+uint8_t Display_RenderFixed(int32_t Value, uint8_t Digits, uint8_t *Frame);
+uint8_t Display_RenderDecimal(int32_t Value, uint8_t Separator, uint8_t Digits, uint8_t *Frame);
+void Display_RenderError(uint8_t Digits, uint8_t *Frame);
+void Display_RenderText(const char *Text, uint8_t Digits, uint8_t *Frame);
+
+#endif /* INC_DISPLAY_H_ */
@@ -0,0 +1,30 @@
+/*
+ * encode.h
+ *
+ *  Created on: 19 October 2026
+ */
+
+#ifndef INC_ENCODE_H_
+#define INC_ENCODE_H_
+
+#include "stdint.h"
+
+// Maximum size of one varint (32 bit value, 7 bits per byte)
+#define ENCODE_MAX_VARINT_SIZE			5
+
+// Worst case size of encoded batch: count + timestamp/value pair per sample
+#define ENCODE_BATCH_SIZE(count)		(ENCODE_MAX_VARINT_SIZE + ((count) * (ENCODE_MAX_VARINT_SIZE + 3)))
+
+// Characters of base64 text for bytes, with padding, without ending 0
+#define ENCODE_BASE64_SIZE(bytes)		(4 * (((bytes) + 2) / 3))
+
+uint16_t Encode_Varint(uint32_t Value, uint8_t *Buffer);
+uint16_t Encode_ZigZagVarint(int32_t Value, uint8_t *Buffer);
+uint16_t Decode_Varint(const uint8_t *Buffer, uint16_t Lenght, uint32_t *Value);
+uint16_t Decode_ZigZagVarint(const uint8_t *Buffer, uint16_t Lenght, int32_t *Value);
+uint16_t Encode_DeltaBatch(const int16_t *Values, const uint32_t *Timestamps, uint8_t Count, uint8_t *Buffer, uint16_t BufferSize);
+uint8_t Decode_DeltaBatch(const uint8_t *Buffer, uint16_t Lenght, int16_t *Values, uint32_t *Timestamps, uint8_t MaxCount);
+uint16_t Encode_Base64(const uint8_t *Data, uint16_t Lenght, char *Text);
+uint16_t Decode_Base64(const char *Text, uint16_t Lenght, uint8_t *Data, uint16_t MaxSize);
+
+#endif /* INC_ENCODE_H_ */
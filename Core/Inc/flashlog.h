@@ -0,0 +1,92 @@
+/*
+ * flashlog.h
+ *
+ *  Created on: 19 October 2026
+ */
+
+#ifndef INC_FLASHLOG_H_
+#define INC_FLASHLOG_H_
+
+#include "tmp102_array.h"
+
+/*
+ * Reserved flash, sectors 6 and 7 of STM32F401RE (2 x 128 KB).
+ * Linker script has to end FLASH region at 0x08040000 so code never lands here.
+ */
+#define FLASHLOG_SECTOR_COUNT			2
+#define FLASHLOG_SECTOR_SIZE			0x20000
+#define FLASHLOG_FIRST_SECTOR			FLASH_SECTOR_6
+#define FLASHLOG_FIRST_ADDRESS			0x08040000
+
+#define FLASHLOG_MAGIC					0x474F4C46		// "FLOG"
+#define FLASHLOG_EMPTY					0xFFFFFFFF
+
+// Records in one sector, first slot is sector header
+#define FLASHLOG_SECTOR_RECORDS			((FLASHLOG_SECTOR_SIZE / sizeof(FlashLog_Record_t)) - 1)
+
+// Period of storing newest sample of every sensor
+#define FLASHLOG_PERIOD					60000
+
+// Erase of next sector starts when so many slots are left in active one
+#define FLASHLOG_ERASE_AHEAD			16
+
+/*
+ * Flash log status @status
+ */
+#define FLASHLOG_OK						0
+#define FLASHLOG_ERR_FLASH				1
+#define FLASHLOG_ERR_RANGE				2
+#define FLASHLOG_ERR_EMPTY				3		// slot with interrupted write
+#define FLASHLOG_ERR_BUSY				4		// next sector is still erased, record not stored
+
+/*
+ * Erase of next sector @erase
+ */
+#define FLASHLOG_ERASE_NONE				0
+#define FLASHLOG_ERASE_RUNNING			1		// started, FLASH interrupt ends it
+#define FLASHLOG_ERASE_DONE				2		// sector is empty, header not written yet
+#define FLASHLOG_ERASE_FAILED			3
+
+/*
+ * Sector header, written right after erase
+ */
+typedef struct
+{
+	uint32_t	Magic;			// FLASHLOG_MAGIC, anything else - sector not used
+	uint32_t	Sequence;		// increased with every rotation, highest one is active sector
+}FlashLog_Header_t;
+
+/*
+ * One stored sample, 8 bytes = 2 flash words.
+ * Second word is programmed last, erased Address means write did not finish.
+ */
+typedef struct
+{
+	uint32_t	Time;			// ms from boot
+	int16_t		Value;			// temperature in LSB (0.0625 deg C)
+	uint8_t		Address;		// sensor address, 0xFF - no record
+	uint8_t		Boot;			// boot number, orders records from different resets
+}FlashLog_Record_t;
+
+/*
+ * Log state found by scan on boot
+ */
+typedef struct
+{
+	uint8_t		Active;			// sector index that is written now
+	uint32_t	Sequence;		// sequence of active sector
+	uint32_t	Tail;			// first free slot in active sector
+	uint8_t		Boot;			// boot number of this run
+	uint8_t		Ready;			// log can be written
+	volatile uint8_t Erase;		// @erase, of sector after active one
+}FlashLog_t;
+
+uint8_t FlashLog_Init(void);
+uint8_t FlashLog_Append(uint8_t Address, TMP102Sample_t *Sample);
+uint32_t FlashLog_GetCount(void);
+uint8_t FlashLog_Read(uint32_t Index, FlashLog_Record_t *Record);
+uint32_t FlashLog_GetSequence(void);
+void FlashLog_EraseCpltCallback(void);
+void FlashLog_EraseErrorCallback(void);
+
+#endif /* INC_FLASHLOG_H_ */
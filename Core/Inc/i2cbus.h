@@ -0,0 +1,100 @@
+/*
+ * i2cbus.h
+ *
+ *  Created on: 19 October 2026
+ */
+
+#ifndef INC_I2CBUS_H_
+#define INC_I2CBUS_H_
+
+#include "main.h"
+
+/*
+ * Pins of I2C1, driven as GPIO during bus recovery
+ */
+#define I2CBUS_SCL_PORT					GPIOB
+#define I2CBUS_SCL_PIN					GPIO_PIN_6
+#define I2CBUS_SDA_PORT					GPIOB
+#define I2CBUS_SDA_PIN					GPIO_PIN_7
+
+/*
+ * Timeout of blocking transfer is time of all its bits at bus speed and margin
+ * for tick granularity (HAL tick is 1 ms, first one can be just started)
+ */
+#define I2CBUS_BITS_PER_BYTE			9		// 8 data bits and ACK
+#define I2CBUS_TIMEOUT_MARGIN			2		// ms
+// Chain of transfers started from interrupts, every transfer waits for the previous
+// callback and for stretched clock
+#define I2CBUS_TRANSFER_MARGIN			1		// ms per transfer
+
+// Memory transfer adds address with W, register and address with R
+#define I2CBUS_MEM_OVERHEAD				3		// bytes
+
+/*
+ * Bus speed @speed, F4 peripheral has no high speed mode (3.4 MHz)
+ */
+#define I2CBUS_SPEED_STANDARD			100000	// Hz
+#define I2CBUS_SPEED_FAST				400000	// Hz
+
+/*
+ * Self-test of new speed - register of every device is read at old speed, then
+ * I2CBUS_SELFTEST_READS times at new speed, all reads have to match
+ */
+#define I2CBUS_SELFTEST_DEVICES			8
+#define I2CBUS_SELFTEST_READS			8
+
+/*
+ * Result of speed selection @select
+ */
+#define I2CBUS_SELECT_OK				0		// all devices work at new speed
+#define I2CBUS_SELECT_FAILED			1		// self-test failed, old speed kept
+#define I2CBUS_SELECT_NOT_VERIFIED		2		// no device to test, standard speed used
+#define I2CBUS_SELECT_BUSY				3		// transfer in progress, speed not changed
+
+// Register reads timed by benchmark, DWT cycle counter gives time below 1 us
+#define I2CBUS_BENCHMARK_READS			16
+
+/*
+ * Result of benchmark @benchmark
+ */
+#define I2CBUS_BENCHMARK_OK				0
+#define I2CBUS_BENCHMARK_BUSY			1		// peripheral used by other transfer, nothing timed
+#define I2CBUS_BENCHMARK_FAILED			2		// read failed, device or bus error
+
+// Slave which holds SDA low finishes its byte in at most 9 clocks
+#define I2CBUS_RECOVERY_CLOCKS			9
+#define I2CBUS_RECOVERY_RATE			50000	// Hz, bit-banged SCL is slower than standard mode
+
+/*
+ * Bus error counters
+ */
+typedef struct
+{
+	uint32_t			Timeouts;			// transfer did not finish in time
+	uint32_t			Nacks;				// device did not acknowledge, bus is fine
+	uint32_t			ArbitrationLost;	// SDA did not follow master, noise or other master
+	uint32_t			BusErrors;			// START or STOP on wrong place
+	uint32_t			Busy;				// BUSY flag set while no transfer runs
+	uint32_t			Recoveries;			// 9 clocks and reinit
+	uint32_t			RecoveryFailed;		// lines still low after recovery
+	uint32_t			SpeedFallbacks;		// self-test of higher speed failed
+	volatile uint8_t	RecoveryPending;	// error in interrupt, recovery waits for main loop
+}I2CBus_t;
+
+uint32_t I2CBus_Timeout(I2C_HandleTypeDef *hi2c, uint16_t Bytes);
+HAL_StatusTypeDef I2CBus_MemRead(I2C_HandleTypeDef *hi2c, uint16_t DevAddress,
+		uint16_t MemAddress, uint8_t *pData, uint16_t Size);
+HAL_StatusTypeDef I2CBus_MemWrite(I2C_HandleTypeDef *hi2c, uint16_t DevAddress,
+		uint16_t MemAddress, uint8_t *pData, uint16_t Size);
+uint8_t I2CBus_Recover(I2C_HandleTypeDef *hi2c);
+HAL_StatusTypeDef I2CBus_SetSpeed(I2C_HandleTypeDef *hi2c, uint32_t Speed);
+uint8_t I2CBus_SelectSpeed(I2C_HandleTypeDef *hi2c, uint32_t Speed,
+		const uint8_t *Devices, const uint8_t *Registers, uint8_t Count);
+uint8_t I2CBus_Benchmark(I2C_HandleTypeDef *hi2c, uint8_t Device, uint8_t Reg,
+		uint32_t *ReadTime);
+void I2CBus_Process(I2C_HandleTypeDef *hi2c);
+uint8_t I2CBus_IsRecoveryPending(void);
+const I2CBus_t *I2CBus_GetStats(void);
+void I2CBus_ErrorCallback(I2C_HandleTypeDef *hi2c);
+
+#endif /* INC_I2CBUS_H_ */
@@ -0,0 +1,108 @@
+/*
+ * log.h
+ *
+ *  Created on: 19 October 2026
+ */
+
+#ifndef INC_LOG_H_
+#define INC_LOG_H_
+
+#include "main.h"
+
+/*
+ * Log levels @levels
+ */
+#define LOG_LEVEL_DEBUG				0
+#define LOG_LEVEL_INFO				1
+#define LOG_LEVEL_WARNING			2
+#define LOG_LEVEL_ERROR				3
+#define LOG_LEVEL_NONE				4
+
+// Defined by user, calls below this level are removed at compile time
+#define LOG_LEVEL					LOG_LEVEL_INFO
+
+// Number of records waiting for transmission
+#define LOG_BUFFER_SIZE				32
+// Maximum number of integer arguments in one record
+#define LOG_MAX_ARGS				3
+// Maximum lenght of formatted line
+#define LOG_LINE_SIZE				96
+// Bytes for text queued by Log_WriteText
+#define LOG_TEXT_BUFFER_SIZE		256
+// Timeout for blocking writers waiting for log transmission [ms]
+#define LOG_UART_TIMEOUT			100
+
+/*
+ * Messages @messages, format strings are literals so -Wformat checks every call.
+ * Arguments are copied as long, so only %ld, %lu, %lx and %lX conversions are used.
+ */
+#define LOG_MSG_BT_CONNECTED			"Device connected"
+#define LOG_MSG_BT_DISCONNECTED			"Device disconnected"
+#define LOG_MSG_BT_LINE_DROPPED			"BT line dropped, total %lu"
+#define LOG_MSG_I2C_DEVICE_FOUND		"I2C device found, address 0x%lX"
+#define LOG_MSG_I2C_SCAN_DONE			"I2C scan finished, %lu devices"
+#define LOG_MSG_TMP102_RATE_CHANGED		"TMP102 period %lu ms, slope %ld LSB/min"
+#define LOG_MSG_CRASH					"Reset after crash type %lu, PC 0x%08lX, LR 0x%08lX"
+#define LOG_MSG_CRASH_STATUS			"CFSR 0x%08lX, HFSR 0x%08lX, BFAR 0x%08lX"
+#define LOG_MSG_CRASH_TRACE				"Trace 0x%08lX 0x%08lX 0x%08lX"
+#define LOG_MSG_CRASH_TASK				"Watchdog, task %lu missed deadline"
+#define LOG_MSG_I2C_RECOVERY			"I2C bus recovery %lu, lines released %lu"
+#define LOG_MSG_I2C_SPEED				"I2C bus at %lu Hz, requested %lu Hz"
+#define LOG_MSG_BOOT_DONE				"Init done %lu ms after reset"
+#define LOG_MSG_FIRST_SAMPLE			"First sample %lu ms after reset"
+#define LOG_MSG_FLASHLOG_OFF			"Flash log init failed, status %lu, logging off"
+
+/*
+ * Single log record, formatted only when it is sent
+ */
+typedef struct
+{
+	uint32_t	Timestamp;				// HAL tick when record was written
+	const char	*Format;				// format string @messages, literal kept in flash, NULL for text
+	uint8_t		Level;					// @levels
+	long		Args[LOG_MAX_ARGS];		// arguments for format string, text start and lenght
+}Log_Record_t;
+
+/*
+ * Log macros, up to LOG_MAX_ARGS long arguments can follow the message
+ * LOG_INFO(LOG_MSG_I2C_DEVICE_FOUND, (unsigned long) Address);
+ */
+
+// number of arguments after message, counted at compile time,
+// more than LOG_MAX_ARGS gives undeclared LOG_TOO_MANY_ARGS
+#define LOG_NARGS(...)				LOG_NARGS_PICK(__VA_ARGS__, LOG_TOO_MANY_ARGS, \
+										LOG_TOO_MANY_ARGS, LOG_TOO_MANY_ARGS, 3, 2, 1, 0)
+#define LOG_NARGS_PICK(Format, A1, A2, A3, A4, A5, A6, Count, ...)	Count
+
+#if (LOG_LEVEL <= LOG_LEVEL_DEBUG)
+#define LOG_DEBUG(...)				Log_Write(LOG_LEVEL_DEBUG, LOG_NARGS(__VA_ARGS__), __VA_ARGS__)
+#else
+#define LOG_DEBUG(...)
+#endif
+
+#if (LOG_LEVEL <= LOG_LEVEL_INFO)
+#define LOG_INFO(...)				Log_Write(LOG_LEVEL_INFO, LOG_NARGS(__VA_ARGS__), __VA_ARGS__)
+#else
+#define LOG_INFO(...)
+#endif
+
+#if (LOG_LEVEL <= LOG_LEVEL_WARNING)
+#define LOG_WARNING(...)			Log_Write(LOG_LEVEL_WARNING, LOG_NARGS(__VA_ARGS__), __VA_ARGS__)
+#else
+#define LOG_WARNING(...)
+#endif
+
+#if (LOG_LEVEL <= LOG_LEVEL_ERROR)
+#define LOG_ERROR(...)				Log_Write(LOG_LEVEL_ERROR, LOG_NARGS(__VA_ARGS__), __VA_ARGS__)
+#else
+#define LOG_ERROR(...)
+#endif
+
+void Log_Write(uint8_t Level, uint8_t Count, const char *Format, ...) __attribute__((format(printf, 3, 4)));
+void Log_WriteText(const char *Text);
+void Log_Process(void);
+void Log_TxCpltCallback(UART_HandleTypeDef *huart);
+void Log_WaitIdle(void);
+uint32_t Log_GetDropped(void);
+
+#endif /* INC_LOG_H_ */
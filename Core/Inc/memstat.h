@@ -0,0 +1,41 @@
+/*
+ * memstat.h
+ *
+ *  Created on: 19 October 2026
+ */
+
+#ifndef INC_MEMSTAT_H_
+#define INC_MEMSTAT_H_
+
+#include "stdint.h"
+#include "stddef.h"
+
+// 1 - any heap request stops in Error_Handler, 0 - heap is only counted
+#define MEMSTAT_HEAP_TRAP				1
+
+// Free stack is filled with this word, overwritten words show stack use
+#define MEMSTAT_STACK_PAINT				0xA5A5A5A5
+// Bytes below stack pointer left unpainted while painting
+#define MEMSTAT_PAINT_MARGIN			32
+
+/*
+ * RAM usage in bytes, static part comes from linker symbols
+ */
+typedef struct
+{
+	uint32_t	Total;				// whole RAM
+	uint32_t	Data;				// .data
+	uint32_t	Bss;				// .bss
+	uint32_t	Heap;				// given out by _sbrk
+	uint32_t	HeapRequests;		// number of _sbrk calls with non zero size
+	uint32_t	StackReserved;		// _Min_Stack_Size
+	uint32_t	StackUsed;			// high water mark since boot
+	uint32_t	Free;				// not used by anything above
+}MemStat_Usage_t;
+
+void MemStat_PaintStack(void);
+uint32_t MemStat_GetStackHighWater(void);
+void MemStat_HeapRequest(ptrdiff_t Incr);
+void MemStat_GetUsage(MemStat_Usage_t *Usage);
+
+#endif /* INC_MEMSTAT_H_ */
@@ -0,0 +1,83 @@
+/*
+ * pages.h
+ *
+ *  Created on: 19 October 2026
+ */
+
+#ifndef INC_PAGES_H_
+#define INC_PAGES_H_
+
+#include "main.h"
+#include "display.h"
+#include "tmp102_array.h"
+
+/*
+ * Page of display @page, name is used by PAGES command
+ */
+#define PAGES_PAGE_TEMP					0	// T - current value of first sensor
+#define PAGES_PAGE_MIN					1	// MIN - lowest value since boot
+#define PAGES_PAGE_MAX					2	// MAX - highest value since boot
+#define PAGES_PAGE_AVG					3	// AVG - average since boot
+#define PAGES_PAGE_RATE					4	// RATE - sample rate in Hz
+#define PAGES_PAGE_LINK					5	// LINK - bluetooth connection
+#define PAGES_COUNT						6
+#define PAGES_NONE						0xFF
+
+/*
+ * Status @status
+ */
+#define PAGES_OK						0
+#define PAGES_ERR_ARG					1
+
+// Pages in rotation
+#define PAGES_MAX_PAGES					8
+
+/*
+ * Timing in ms, converted to TIM1 overflows. Counter runs at CLOCKGOV_TIM1_TICK
+ * on every clock level, length of overflow is taken from TIM1 period at start.
+ */
+#define PAGES_SHOW_TIME					60000	// rotation after DISPLAY command
+#define PAGES_LABEL_TIME				1000	// name of page before its value
+#define PAGES_REFRESH					1000	// value on page is updated
+#define PAGES_DEFAULT_DWELL				4		// s
+#define PAGES_MAX_DWELL					60		// s
+
+// Statistics are counted from history, at fastest rate history covers 2 s
+#define PAGES_STATS_PERIOD				1000	// ms
+
+typedef struct
+{
+	// rotation
+	uint8_t				Pages[PAGES_MAX_PAGES];		// @page
+	uint8_t				Dwell[PAGES_MAX_PAGES];		// s
+	uint8_t				Count;
+	uint8_t				Current;					// index to Pages
+	uint8_t				Active;
+	volatile uint32_t	Ticks;						// TIM1 ticks from start of rotation
+	uint32_t			TickTime;					// us of one TIM1 tick
+	uint32_t			PageStart;					// tick when current page was shown
+	uint32_t			LastRefresh;				// tick of last update of display
+	uint8_t				Label;						// name of page is shown
+	uint8_t				Update;						// page has to be drawn again
+
+	// statistics of first sensor since boot, in counts
+	int16_t				Min;
+	int16_t				Max;
+	int64_t				Sum;
+	uint32_t			Samples;
+	uint32_t			LastTimestamp;				// newest sample already counted
+	uint32_t			LastStats;					// tick of last statistics update
+}Pages_t;
+
+void Pages_Init(void);
+uint8_t Pages_Set(const uint8_t *List, const uint8_t *Dwell, uint8_t Count);
+uint8_t Pages_Get(uint8_t *List, uint8_t *Dwell);
+uint8_t Pages_Find(const char *Name, uint8_t Lenght);
+const char *Pages_Name(uint8_t Page);
+void Pages_Start(void);
+void Pages_Stop(void);
+uint8_t Pages_IsActive(void);
+void Pages_Tick(void);
+void Pages_Process(Display_t *Display, TMP102Array_t *TMP102Array, uint8_t LinkUp);
+
+#endif /* INC_PAGES_H_ */
@@ -1,33 +1,93 @@
-/*
- * parse.h
- *
- *  Created on: 24 April 2023
- *      Author: Ezrah Buki
- */
-
-#ifndef INC_PARSE_H_
-#define INC_PARSE_H_
-
-#include "tmp102.h"
-
-typedef enum
-{
-	PARSE_OK,
-	PARSE_ERROR_NOCMD,
-	PARSE_ERROR_2CMDS
-}PARSE_STATUS;
-
-typedef enum
-{
-	WAKE_UP,
-	MEASURE,
-	DISPLAY,
-	SLEEP
-}BT_COMMANDS;
-
-#define ENDLINE '\n'
-
-void Parse_WriteDataToBuffer(Ringbuffer_t *RecieveBuffer, uint8_t *ParseBuffer);
-uint8_t Parser_Parse(uint8_t *ParseBuffer, TMP102_t *TMP102);
-
-#endif /* INC_PARSE_H_ */
+/*
+ * parse.h
+ *
+ *  Created on: 24 April 2023
+ *      Author: Ezrah Buki
+ */
+
+#ifndef INC_PARSE_H_
+#define INC_PARSE_H_
+
+#include "tmp102_array.h"
+#include "pool.h"
+#include "JDY-09.h"
+
+typedef enum
+{
+	PARSE_OK,
+	PARSE_ERROR_NOCMD,
+	PARSE_ERROR_2CMDS,
+	PARSE_ERROR_TOO_MANY,
+	PARSE_BUSY
+}PARSE_STATUS;
+
+typedef enum
+{
+	WAKE_UP,
+	MEASURE,
+	DISPLAY,
+	SLEEP,
+	HELP,
+	REPORT,
+	HISTORY,
+	DUMP,
+	CLOCK,
+	MEM,
+	CRASH,
+	I2C,
+	PAGES
+}BT_COMMANDS;
+
+/*
+ * Command with arguments, as it waits in the queue
+ */
+typedef struct
+{
+	BT_COMMANDS Command;
+	uint32_t Arg[3];			// command arguments, REPORT - deadband 1/1000 unit, max silence ms, pacing ms
+								// DUMP - first record, count
+								// I2C - bus speed Hz, 0 - only statistics
+								// PAGES - page + 1 in every 4 bits from the lowest, 0 - only print,
+								// dwell s in every byte of [1] and [2]
+}Parser_Cmd_t;
+
+// Parsed commands wait in queue for execution
+#define PARSE_CMD_QUEUE_SIZE			8
+
+typedef struct
+{
+	Parser_Cmd_t Buffer[PARSE_CMD_QUEUE_SIZE];
+	uint8_t Head;
+	uint8_t Tail;
+	uint8_t Count;
+	uint8_t HighWaterMark;		// maximum number of commands waiting at once
+}Parser_CmdQueue_t;
+
+#define ENDLINE '\n'
+
+// Responses of all commands in a line are sent as one frame, frame is pool block
+#define PARSE_RESPONSE_BUFFER_SIZE		POOL_FRAME_SIZE
+#define PARSE_UART_TIMEOUT				1000
+
+// Flash log records sent in one frame of DUMP stream
+#define PARSE_DUMP_CHUNK				6
+
+// Batch bytes written as base64 at once by HISTORY, multiple of 3
+#define PARSE_HISTORY_CHUNK				48
+
+// Lowest bus speed accepted by I2C=, in kHz
+#define PARSE_I2C_MIN_SPEED				10
+// Biggest number read by parser with decimals, in thousandths
+#define PARSE_MILLI_MAX					1000000000
+
+void Parser_Init(JDY09_t *jdy09);
+void Parse_WriteDataToBuffer(Ringbuffer_t *RecieveBuffer, uint8_t *ParseBuffer, uint16_t BufferSize);
+uint8_t Parser_Parse(uint8_t *ParseBuffer);
+void Parser_Execute(TMP102Array_t *TMP102Array);
+uint8_t Parser_FlushResponse(void);
+void Parser_SendReports(void);
+void Parser_SendCrash(void);
+uint8_t Parser_GetQueueHighWaterMark(void);
+uint8_t Parser_IsBusy(void);
+
+#endif /* INC_PARSE_H_ */
@@ -0,0 +1,47 @@
+/*
+ * pool.h
+ *
+ *  Created on: 19 October 2026
+ */
+
+#ifndef INC_POOL_H_
+#define INC_POOL_H_
+
+#include "stdint.h"
+
+/*
+ * Size classes @class, block sizes have to be multiple of 4, at most 32 blocks in class
+ */
+#define POOL_CLASS_LINE					0		// received lines, JDY-09 responses
+#define POOL_CLASS_TEXT					1		// log lines
+#define POOL_CLASS_FRAME				2		// bluetooth response frames
+#define POOL_CLASSES					3
+
+#define POOL_LINE_SIZE					64
+#define POOL_LINE_COUNT					4
+#define POOL_TEXT_SIZE					128
+#define POOL_TEXT_COUNT					2
+#define POOL_FRAME_SIZE					256
+#define POOL_FRAME_COUNT				2
+
+/*
+ * One size class, free blocks are linked through their first word
+ */
+typedef struct
+{
+	uint16_t	BlockSize;
+	uint8_t		BlockCount;
+	uint8_t		*Storage;			// BlockCount blocks of BlockSize
+	void		*FreeList;			// first free block
+	uint32_t	InUse;				// bit per block, set while it is given out
+	uint8_t		Used;				// blocks given out now
+	uint8_t		HighWaterMark;		// maximum blocks given out at once
+	uint32_t	Failed;				// requests of this class with no free block
+}Pool_t;
+
+void Pool_Init(void);
+void *Pool_Alloc(uint16_t Size);
+void Pool_Free(void *Block);
+const Pool_t *Pool_GetClass(uint8_t Class);
+
+#endif /* INC_POOL_H_ */
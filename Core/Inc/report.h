@@ -0,0 +1,80 @@
+/*
+ * report.h
+ *
+ *  Created on: 19 October 2026
+ */
+
+#ifndef INC_REPORT_H_
+#define INC_REPORT_H_
+
+#include "tmp102_array.h"
+
+// Default policy, changed by REPORT=<deadband>,<max silence s>;
+#define REPORT_DEFAULT_DEADBAND			250		// thousandths of sensor unit, 0.25 deg C
+#define REPORT_DEFAULT_MAX_SILENCE		60000	// ms, 0 - send only on change
+#define REPORT_MAX_SILENCE_LIMIT		86400	// s, one day
+#define REPORT_MAX_DEADBAND				128000	// thousandths of sensor unit
+
+// Telemetry kept while master is disconnected, oldest is lost when full
+#define REPORT_BACKLOG_SIZE				64
+// Entries sent in one frame, backlog is replayed in frames
+#define REPORT_REPLAY_CHUNK				4
+// Threshold crossings waiting for link, they are sent without pacing
+#define REPORT_ALERT_QUEUE_SIZE			8
+// Default gap between replay frames in ms, 0 - full link rate
+#define REPORT_DEFAULT_PACING			50
+#define REPORT_MAX_PACING				10000
+
+/*
+ * Telemetry waiting for link, Type is TMP102_ALERT_NONE for reading or @alert
+ */
+typedef struct
+{
+	uint32_t		Sequence;		// increased for every entry, gateway finds gaps and duplicates
+	uint8_t			Type;
+	uint8_t			Address;		// sensor address
+	TMP102Sample_t	Sample;
+}Report_Entry_t;
+
+/*
+ * Reporting policy of the bluetooth link and state of every sensor
+ */
+typedef struct
+{
+	uint32_t	Deadband;									// thousandths of sensor unit, change needed to send
+	uint32_t	MaxSilence;									// ms, reading is sent at least this often
+	int16_t		LastValue[TMP102_ARRAY_MAX_SENSORS];		// last sent value
+	uint32_t	LastReportTime[TMP102_ARRAY_MAX_SENSORS];	// tick of last send
+	uint32_t	LastSampleTime[TMP102_ARRAY_MAX_SENSORS];	// newest sample already checked
+	uint8_t		ReportedMask;								// bit per sensor - sent at least once
+	uint32_t	Sent;										// readings sent
+	uint32_t	Suppressed;									// readings not sent
+
+	Report_Entry_t	Backlog[REPORT_BACKLOG_SIZE];			// telemetry not sent yet
+	uint8_t		BacklogTail;								// oldest entry
+	uint8_t		BacklogCount;
+	uint32_t	Sequence;									// sequence of next entry
+	uint32_t	Overwritten;								// entries lost because backlog was full
+	uint32_t	Pacing;										// ms between replay frames
+	uint32_t	LastFrameTime;								// tick of last replay frame
+
+	Report_Entry_t	Alerts[REPORT_ALERT_QUEUE_SIZE];		// threshold crossings not sent yet
+	uint8_t		AlertTail;									// oldest alert
+	uint8_t		AlertCount;
+}Report_t;
+
+void Report_SetPolicy(uint32_t Deadband, uint32_t MaxSilence);
+void Report_GetPolicy(uint32_t *Deadband, uint32_t *MaxSilence);
+void Report_Reset(void);
+uint8_t Report_Check(TMP102Array_t *array, uint8_t Index, TMP102Sample_t *Sample);
+void Report_Queue(uint8_t Type, uint8_t Address, TMP102Sample_t *Sample);
+uint8_t Report_Peek(uint8_t Index, Report_Entry_t *Entry);
+void Report_Pop(uint8_t Count);
+uint8_t Report_PeekAlert(uint8_t Index, Report_Entry_t *Entry);
+void Report_PopAlert(uint8_t Count);
+uint8_t Report_GetBacklog(void);
+void Report_SetPacing(uint32_t Pacing);
+uint8_t Report_FrameAllowed(void);
+void Report_FrameSent(void);
+
+#endif /* INC_REPORT_H_ */
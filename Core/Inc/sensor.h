@@ -0,0 +1,100 @@
+/*
+ * sensor.h
+ *
+ *  Created on: 19 October 2026
+ */
+
+#ifndef INC_SENSOR_H_
+#define INC_SENSOR_H_
+
+#include "main.h"
+#include "tmp102.h"
+
+// Longest raw sample of all drivers
+#define SENSOR_MAX_RAW_SIZE				6
+
+// Sensors which can be found by address at once
+#define SENSOR_MAX_ACTIVE				8
+
+/*
+ * Power mode @power
+ */
+#define SENSOR_POWER_CONTINUOUS			0	// sensor converts by itself
+#define SENSOR_POWER_ONESHOT			1	// shut down, one conversion per StartSample
+
+/*
+ * Measured quantity @quantity
+ */
+#define SENSOR_QUANTITY_TEMPERATURE		0
+#define SENSOR_QUANTITY_HUMIDITY		1
+#define SENSOR_QUANTITY_PRESSURE		2
+
+/*
+ * Sensor status @status
+ */
+#define SENSOR_OK						0
+#define SENSOR_ERR_BUS					1
+#define SENSOR_ERR_NOTSUPPORTED			2
+#define SENSOR_ERR_UNKNOWN				3	// no sensor, value can not be converted
+
+typedef struct Sensor_s Sensor_t;
+
+/*
+ * Driver of one sensor type, values are in counts of Resolution
+ */
+typedef struct
+{
+	const char		*Name;
+	const char		*Unit;
+	uint8_t			Quantity;			// @quantity
+	uint32_t		Resolution;			// one count in millionths of Unit
+	uint8_t			FirstAddress;		// 7 bit addresses the part can use
+	uint8_t			AddressCount;
+	uint8_t			RawSize;			// bytes of one raw sample
+	uint8_t			TestRegister;		// 2 byte register which does not change, bus self-test
+	uint32_t		ConversionTime;		// one-shot conversion in ms
+
+	uint8_t				(*Init)(Sensor_t *Sensor);
+	uint8_t				(*StartSample)(Sensor_t *Sensor);
+	HAL_StatusTypeDef	(*ReadRaw)(Sensor_t *Sensor, uint8_t *Raw);
+	HAL_StatusTypeDef	(*ReadRawDMA)(Sensor_t *Sensor, uint8_t *Raw);	// done in HAL_I2C_MemRxCpltCallback
+	int16_t				(*Convert)(Sensor_t *Sensor, const uint8_t *Raw);
+	uint8_t				(*SetPowerMode)(Sensor_t *Sensor, uint8_t Mode);
+	uint8_t				(*SetRate)(Sensor_t *Sensor, uint32_t Period);
+	uint8_t				(*SetAlert)(Sensor_t *Sensor, int16_t Low, int16_t High);	// NULL - no alert output
+}Sensor_Driver_t;
+
+/*
+ * Device structure of every driver
+ */
+typedef union
+{
+	TMP102_t		TMP102;
+}Sensor_Device_t;
+
+struct Sensor_s
+{
+	const Sensor_Driver_t	*Driver;
+	I2C_HandleTypeDef		*I2CHandle;
+	uint8_t					Address;		// 7 bit address
+	Sensor_Device_t			Device;
+};
+
+/*
+ * Drivers
+ */
+extern const Sensor_Driver_t TMP102_Driver;
+
+uint8_t Sensor_Init(Sensor_t *Sensor, const Sensor_Driver_t *Driver,
+		I2C_HandleTypeDef *I2CHandle, uint8_t Address);
+uint8_t Sensor_GetAddresses(uint8_t *Addresses, uint8_t MaxCount);
+const Sensor_Driver_t *Sensor_FindDriver(uint8_t Address);
+const Sensor_Driver_t *Sensor_GetDefaultDriver(void);
+const Sensor_t *Sensor_Find(uint8_t Address);
+uint8_t Sensor_ToFloat(const Sensor_t *Sensor, int16_t Value, float *Result);
+uint8_t Sensor_ToMilli(const Sensor_t *Sensor, int16_t Value, int32_t *Milli);
+int16_t Sensor_FromFloat(const Sensor_t *Sensor, float Value);
+int16_t Sensor_FromMilli(const Sensor_t *Sensor, int32_t Milli);
+const char *Sensor_Unit(const Sensor_t *Sensor);
+
+#endif /* INC_SENSOR_H_ */
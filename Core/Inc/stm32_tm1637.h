@@ -1,6 +1,7 @@
-#pragma once
-
-void tm1637Init(void);
-void tm1637DisplayFloat(float value);
-void tm1637DisplayDecimal(int v, int displaySeparator);
-void tm1637SetBrightness(char brightness);
+#pragma once
+
+#include "display.h"
+
+void tm1637Init(void);
+void tm1637WriteFrame(const uint8_t *frame, uint8_t digits);
+void tm1637SetBrightness(uint8_t brightness);
@@ -0,0 +1,71 @@
+/*
+ * supervisor.h
+ *
+ *  Created on: 19 October 2026
+ */
+
+#ifndef INC_SUPERVISOR_H_
+#define INC_SUPERVISOR_H_
+
+#include "main.h"
+
+// Maximum number of supervised tasks
+#define SUPERVISOR_MAX_TASKS			6
+#define SUPERVISOR_NO_TASK				0xFF
+
+/*
+ * IWDG runs from LSI (17 to 47 kHz on F401), it can not be stopped once started.
+ * Timeout has to be longer than erase of 128 KB flash sector (up to 2 s),
+ * code fetch and so tick interrupt are stalled meanwhile. Reload is computed for
+ * the fastest LSI, so timeout is never shorter, with slow LSI it is up to 11 s.
+ */
+#define SUPERVISOR_LSI_FREQUENCY_MAX	47000
+#define SUPERVISOR_IWDG_PRESCALER		IWDG_PRESCALER_64
+#define SUPERVISOR_IWDG_DIVIDER			64
+#define SUPERVISOR_IWDG_TIMEOUT			4000	// ms, minimum
+#define SUPERVISOR_IWDG_RELOAD			((SUPERVISOR_IWDG_TIMEOUT \
+		* (SUPERVISOR_LSI_FREQUENCY_MAX / 1000)) / SUPERVISOR_IWDG_DIVIDER)
+
+#if (SUPERVISOR_IWDG_RELOAD > 0x0FFF)
+#error "IWDG reload does not fit, use bigger prescaler"
+#endif
+
+// Deadlines are checked this often from tick interrupt
+#define SUPERVISOR_CHECK_PERIOD			10		// ms
+
+/*
+ * Supervised task, it has to check in at least once per deadline
+ */
+typedef struct
+{
+	const char	*Name;
+	uint32_t	Deadline;			// ms
+	uint32_t	LastCheckIn;		// tick of last check in
+}Supervisor_Task_t;
+
+typedef struct
+{
+	IWDG_HandleTypeDef	hiwdg;
+	Supervisor_Task_t	Tasks[SUPERVISOR_MAX_TASKS];
+	uint8_t				TaskCount;
+	volatile uint8_t	Started;		// IWDG is running
+	volatile uint8_t	Paused;			// deadlines not checked, core sleeps
+	volatile uint8_t	Held;			// deadlines not checked, flash erase runs
+	volatile uint8_t	Stale;			// task missed deadline, IWDG is not refreshed anymore
+	uint32_t			LastCheck;		// tick of last deadline check
+	uint32_t			BootTime;		// ms from reset to end of init (Supervisor_Start)
+	uint32_t			FirstSampleTime;	// ms from reset to first sample, 0 - no sample yet
+}Supervisor_t;
+
+uint8_t Supervisor_Register(const char *Name, uint32_t Deadline);
+void Supervisor_Start(void);
+void Supervisor_CheckIn(uint8_t Task);
+void Supervisor_Tick(void);
+void Supervisor_Sleep(void);
+void Supervisor_Hold(void);
+void Supervisor_Release(void);
+const char *Supervisor_TaskName(uint8_t Task);
+void Supervisor_MarkFirstSample(void);
+void Supervisor_GetBootTime(uint32_t *BootTime, uint32_t *FirstSampleTime);
+
+#endif /* INC_SUPERVISOR_H_ */
@@ -0,0 +1,133 @@
+/*
+ * tmp102_array.h
+ *
+ *  Created on: 19 October 2026
+ */
+
+#ifndef INC_TMP102_ARRAY_H_
+#define INC_TMP102_ARRAY_H_
+
+#include "sensor.h"
+
+// Sensors of all drivers on one bus
+#define TMP102_ARRAY_MAX_SENSORS		4
+
+// Number of samples kept for every sensor
+#define TMP102_ARRAY_HISTORY_SIZE		16
+
+/*
+ * Adaptive sampling - fast while temperature changes, slow when it is stable.
+ * Slope is measured over at least TMP102_ARRAY_SLOPE_WINDOW of wall clock time, in LSB
+ * (0.0625 deg C) per minute. Over a shorter time a single LSB step of noise would look
+ * like a fast change.
+ */
+#define TMP102_ARRAY_PERIOD_SLOW		4000	// 0.25 Hz
+#define TMP102_ARRAY_PERIOD_FAST		125		// 8 Hz
+#define TMP102_ARRAY_SLOPE_FAST			32		// 2 deg C/min - switch to fast rate
+#define TMP102_ARRAY_SLOPE_STABLE		8		// 0.5 deg C/min - counted as stable
+#define TMP102_ARRAY_STABLE_COUNT		16		// stable rounds before slow rate
+#define TMP102_ARRAY_SLOPE_WINDOW		60000	// shortest time of slope measurement [ms]
+#define TMP102_ARRAY_SLOPE_STEP			15000	// time between slope reference samples [ms]
+#define TMP102_ARRAY_SLOPE_POINTS		(TMP102_ARRAY_SLOPE_WINDOW / TMP102_ARRAY_SLOPE_STEP + 1)
+
+/*
+ * Sampler state @state
+ */
+#define TMP102_ARRAY_IDLE				0
+#define TMP102_ARRAY_CONVERTING			1	// one-shot conversion in progress
+#define TMP102_ARRAY_READING			2	// DMA chain in progress
+
+/*
+ * Single sample
+ */
+typedef struct
+{
+	uint32_t		Timestamp;		// tick of conversion
+	int16_t			Value;			// counts of sensor driver, TMP102 - LSB (0.0625 deg C)
+}TMP102Sample_t;
+
+/*
+ * Threshold crossing @alert
+ */
+#define TMP102_ALERT_NONE				0
+#define TMP102_ALERT_HIGH				1	// temperature exceeded THIGH
+#define TMP102_ALERT_LOW				2	// temperature fell below TLOW
+
+/*
+ * Threshold crossing reported by ALERT pin
+ */
+typedef struct
+{
+	uint8_t			Address;		// sensor address
+	uint8_t			Type;			// @alert
+	TMP102Sample_t	Sample;			// temperature read after alert
+}TMP102AlertEvent_t;
+
+/*
+ * Single sensor in the array
+ */
+typedef struct
+{
+	Sensor_t		Sensor;								// driver and device structure
+	uint8_t			RawBuffer[SENSOR_MAX_RAW_SIZE];		// DMA buffer for raw sample
+	TMP102Sample_t	History[TMP102_ARRAY_HISTORY_SIZE];
+	uint8_t			HistoryHead;						// place for next sample
+	uint8_t			HistoryCount;						// samples in history
+	TMP102Sample_t	SlopeBase[TMP102_ARRAY_SLOPE_POINTS];	// sample every TMP102_ARRAY_SLOPE_STEP
+	uint8_t			SlopeHead;							// place for next reference sample
+	uint8_t			SlopeCount;							// reference samples kept
+	uint32_t		ErrorCount;							// failed reads
+	uint8_t			Stale;								// last read failed, newest sample is old
+	uint8_t			AlertEnabled;						// sensor drives ALERT line
+	uint8_t			AlertActive;						// above THIGH, waiting for TLOW
+	int16_t			AlertLow;							// TLOW in counts
+	int16_t			AlertHigh;							// THIGH in counts
+}TMP102ArraySensor_t;
+
+/*
+ * All sensors on one i2c bus, read one after another in a chain of DMA transfers.
+ * Sensors are used only through their drivers (sensor.h).
+ */
+typedef struct
+{
+	I2C_HandleTypeDef*	I2CHandle;
+	TMP102ArraySensor_t	Sensors[TMP102_ARRAY_MAX_SENSORS];
+	uint8_t				SensorCount;			// sensors found on the bus
+	uint8_t				Current;				// sensor read in current chain
+	uint8_t				OneShot;				// sensors kept in shutdown, one conversion per read
+	uint32_t			ConversionStart;		// tick of one-shot trigger
+	uint32_t			ConversionTime;			// longest one-shot conversion of all sensors
+	uint32_t			SampleTime;				// timestamp for samples of current chain
+	uint32_t			ReadPeriod;				// ms between reads, 0 - reads started by user
+	uint32_t			LastReadTime;			// tick of last read start
+	uint8_t				Adaptive;				// period follows temperature slope
+	uint8_t				StableCount;			// rounds below stable slope
+	volatile uint8_t	RoundDone;				// all sensors read, slope not checked yet
+	volatile uint8_t	State;					// @state
+	uint16_t			AlertPin;				// EXTI pin of ALERT line, 0 - alert not used
+	volatile uint8_t	AlertPending;			// ALERT edge not handled yet
+}TMP102Array_t;
+
+uint8_t TMP102ArrayInit(TMP102Array_t *array, I2C_HandleTypeDef *initI2CHandle);
+uint8_t TMP102ArraySetOneShot(TMP102Array_t *array, uint8_t Enable);
+uint8_t TMP102ArrayStartRead(TMP102Array_t *array);
+void TMP102ArraySetPeriod(TMP102Array_t *array, uint32_t Period);
+void TMP102ArraySetAdaptive(TMP102Array_t *array, uint8_t Enable);
+int32_t TMP102ArrayGetSlope(TMP102Array_t *array, uint8_t Index);
+void TMP102ArrayProcess(TMP102Array_t *array);
+uint8_t TMP102ArrayIsBusy(TMP102Array_t *array);
+Sensor_t* TMP102ArrayGetSensor(TMP102Array_t *array, uint8_t Index);
+uint8_t TMP102ArrayIsStale(TMP102Array_t *array, uint8_t Index);
+uint8_t TMP102ArraySelectSpeed(TMP102Array_t *array, uint32_t Speed);
+uint8_t TMP102ArrayGetHistory(TMP102Array_t *array, uint8_t Index, TMP102Sample_t *Buffer, uint8_t MaxCount);
+#if (TMP102_USE_FLOATNUMBERS == 1)
+float TMP102ArrayGetFloat(TMP102Array_t *array, uint8_t Index);
+#endif
+uint8_t TMP102ArrayConfigureAlert(TMP102Array_t *array, uint16_t GPIO_Pin, int32_t LowMilli,
+		int32_t HighMilli);
+uint8_t TMP102ArrayCheckAlert(TMP102Array_t *array, TMP102AlertEvent_t *Events);
+void TMP102Array_EXTICallback(TMP102Array_t *array, uint16_t GPIO_Pin);
+void TMP102Array_MemRxCpltCallback(TMP102Array_t *array, I2C_HandleTypeDef *hi2c);
+void TMP102Array_ErrorCallback(TMP102Array_t *array, I2C_HandleTypeDef *hi2c);
+
+#endif /* INC_TMP102_ARRAY_H_ */
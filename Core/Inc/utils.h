@@ -1,15 +1,40 @@
-/*
- * utils.h
- *
- *  Created on: 24 April 2023
- *      Author: Ezrah Buki
- */
-
-#ifndef INC_UTILS_H_
-#define INC_UTILS_H_
-
-void UartLogBT (char *Msg);
-void UartLogPC (char *Msg);
-void I2CScan (I2C_HandleTypeDef* i2chandle);
-
-#endif /* INC_UTILS_H_ */
+/*
+ * utils.h
+ *
+ *  Created on: 24 April 2023
+ *      Author: Ezrah Buki
+ */
+
+#ifndef INC_UTILS_H_
+#define INC_UTILS_H_
+
+#include "JDY-09.h"
+
+// Last 7 bit address probed in full scan
+#define I2CSCAN_LAST_ADDRESS		127
+
+/*
+ * Background i2c scanner, one address is probed per transfer and next one
+ * is started from i2c callback
+ */
+typedef struct
+{
+	I2C_HandleTypeDef*	I2CHandle;		// scanned bus
+	const uint8_t*		AddressList;	// addresses to probe, NULL - full scan
+	uint8_t				ListLenght;		// number of addresses in list
+	uint8_t				Index;			// position of current probe
+	uint8_t				DeviceMap[16];	// bit for every 7 bit address
+	uint8_t				DevicesFound;
+	volatile uint8_t	Busy;			// scan in progress
+}I2CScan_t;
+
+void UartLogBT (JDY09_t *jdy09, char *Msg);
+void UartLogPC (char *Msg);
+void I2CScan (I2C_HandleTypeDef* i2chandle);
+void I2CScanStart (I2C_HandleTypeDef* i2chandle, const uint8_t* AddressList, uint8_t ListLenght);
+uint8_t I2CScanIsBusy (void);
+uint8_t I2CScanIsDevicePresent (uint8_t Address);
+void I2CScan_TxCpltCallback (I2C_HandleTypeDef* i2chandle);
+void I2CScan_ErrorCallback (I2C_HandleTypeDef* i2chandle);
+
+#endif /* INC_UTILS_H_ */
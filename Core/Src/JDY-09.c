@@ -1,560 +1,1153 @@
-/*
- * JDY-09.c
- *
- *  Created on: April 24, 2023
- *      Author: Ezrah Buki
- */
-
-/* In JDY-09.h define JDY09_UART_RX_IT as 1 (using interrupt mode for receive) or 0 (use DMA mode for receive)
- * DMA mode is recommended, if there is a situation that DMA RX is not possible, use IT mode.
- *
- * For UART transfer mode polling is used (used for sending commands).
- *
- * For user to configure in CubeMX :
- *
- * Default settings for UART :
- * Baud: 9600 (configure other value after using SetBaudRate())
- * Word lenght : 8
- * Parity : None
- * Stop Bits : 1
- *
- * if RX interrupt mode : enable USARTx Global Interrupt
- * if RX DMA mode : enable USARTx Global Interrupt, enable DMAx streamx global interrupt
- *
- * Default settings for DMA:
- * USARTx_RX
- * Mode: Normal
- * Peripheral to memory
- * Increment address of memory
- * Data width : byte
- *
- * Default setting for State PIN (not necessary to use this pin - modify lib if you don't need it):
- * GPIO_EXTIx
- * No pull-up no pull-down
- * External IT mode with Rising/Falling edge detection
- * if using State Pin : put JDY09_EXTICallback in HAL_GPIO_EXTI_Callback
- *
- *
- * if RX interrupt mode : put JDY09_RxCpltCallbackIT in HAL_UART_RxCpltCallback in main.c
- * if RX DMA mode : put JDY09_RxCpltCallbackIT in HAL_UARTEx_RxEventCallback in main.c
- *
- *
- * To write AT+Commands device has to be disconnected from master. Connection is defined by GPIO pin STATE.
- * LED on JDY09 blinking - no bluetooth connection, LED on - bluetooth connected
- *
- */
-
-#include "usart.h"
-#include "JDY-09.h"
-#include "stdio.h"
-#include "string.h"
-
-/*
- * Terminal defined by user, commands sent in offline mode will be displayed
- * with responses from JDY-09
- *
- * @param[*Msg] - string to send to display terminal
- *
- * @return - void
- */
-
-static void JDY09_DisplayTerminal(char *Msg)
-{
-	uint8_t Lenght = strlen(Msg);
-	HAL_UART_Transmit(&huart2, (uint8_t*) Msg, Lenght, JDY09_UART_TIMEOUET);
-}
-
-/*
- * Simple command send between MCU and JDY-09
- *
- * @param[*jdy09] - pointer to struct for JDY09 bluetooth module
- * @param[Command] - predefined command to send
- * @return - void
- */
-static void JDY09_SendAndDisplayCmd(JDY09_t *jdy09, uint8_t *Command)
-{
-	uint8_t MsgRecieved[JDY09_RECIEVEBUFFERSIZE];
-
-	//display send info on user display terminal
-	JDY09_DisplayTerminal("Sending: ");
-	JDY09_DisplayTerminal((char*) Command);
-
-	//send data to JDY-09
-	HAL_UART_Transmit(jdy09->huart, Command, strlen((char*) Command),
-	JDY09_UART_TIMEOUET);
-
-	uint32_t responsetime = HAL_GetTick();
-	//wait for response line
-
-
-	while (jdy09->LinesRecieved == 0)
-	{
-		if (HAL_GetTick() - responsetime < JDY09_UART_TIMEOUET)
-		{
-			// wait until timeout
-		}
-		else
-		{
-			JDY09_DisplayTerminal("No response, UART communication error\n\r");
-			return;
-		}
-	}
-
-	//get message out of ring buffer
-	JDY09_CheckPendingMessages(jdy09, MsgRecieved);
-
-	//display response
-	JDY09_DisplayTerminal("Response: ");
-	JDY09_DisplayTerminal((char*) MsgRecieved);
-
-	//clear message pending flag
-	JDY09_ClearMsgPendingFlag(jdy09);
-}
-
-/*
- * Get baud rate
- *
- * @param[Baudrate] - predefined baud rate 4-9
- *
- * @return - baud rate value 9600 - 128000;
- */
-static uint32_t JDY09_GetBaud(uint8_t Baudrate)
-{
-	switch (Baudrate)
-	{
-	case JDY09_BAUDRATE_9600:
-		return 9600;
-
-	case JDY09_BAUDRATE_19200:
-		return 19200;
-
-	case JDY09_BAUDRATE_38400:
-		return 38400;
-
-	case JDY09_BAUDRATE_57600:
-		return 57600;
-
-	case JDY09_BAUDRATE_115200:
-		return 115200;
-
-	case JDY09_BAUDRATE_128000:
-		return 128000;
-
-	}
-
-	return 9600;
-}
-/*
- * Initialize JDY-09 structure
- *
- * @param[*jdy09] - pointer to struct for JDY09 bluetooth module
- * @param[huart] - handler to uart that JDY-09 is connected to
- * @param[StateGPIOPort] - handle to GPIO port of STATE pin
- * @param[StateGPIOPin] - pin number of STATE pin
- *
- * @return - void
- */
-void JDY09_Init(JDY09_t *jdy09, UART_HandleTypeDef *huart,
-		GPIO_TypeDef *StateGPIOPort, uint16_t StateGPIOPin)
-{
-
-	// init msg
-	JDY09_DisplayTerminal("JDY-09 Initializing... \n\r");
-
-	// reset the ring buffer
-	RB_Flush(&(jdy09->RingBuffer));
-
-	// Assign uart
-	jdy09->huart = huart;
-
-	// Assign GPIO for State pin
-	jdy09->StateGPIOPort = StateGPIOPort;
-	jdy09->StatePinNumber = StateGPIOPin;
-
-	// if irq mode is used for receive
-#if (JDY09_UART_RX_IT == 1)
-	HAL_UART_Receive_IT(jdy09->huart, &(jdy09->RecieveBufferIT), 1);
-#endif
-
-	// if dma mode is used for receive
-#if (JDY09_UART_RX_DMA == 1)
-	HAL_UARTEx_ReceiveToIdle_DMA(jdy09->huart, jdy09->RecieveBufferDMA,
-	JDY09_RECIEVEBUFFERSIZE);
-	// to avoid callback from half message this has be disabled
-	__HAL_DMA_DISABLE_IT(jdy09->huart->hdmarx, DMA_IT_HT);
-#endif
-
-	// small delay before transmission
-	HAL_Delay(100);
-
-	//during init - disconnect and display basic information
-	JDY09_Disconnect(jdy09);
-
-	//for some reason this msg will not work in DMA recieve mode
-	//solution yet to find
-	JDY09_SendCommand(jdy09, JDY09_CMD_GETVERSION);
-	JDY09_SendCommand(jdy09, JDY09_CMD_GETADRESS);
-	JDY09_SendCommand(jdy09, JDY09_CMD_GETBAUDRATE);
-	JDY09_SendCommand(jdy09, JDY09_CMD_GETNAME);
-	JDY09_SendCommand(jdy09, JDY09_CMD_GETPASSWORD);
-}
-
-/*
- * Send selected command to JDy-09 in offline mode
- *
- * @param[*jdy09] - pointer to struct for JDY09 bluetooth module
- * @param[Command] - predefined commands that are in .h file
- *
- * @return - void
- */
-void JDY09_SendCommand(JDY09_t *jdy09, JDY09_CMD Command)
-{
-	// check if there is no connection
-	if (HAL_GPIO_ReadPin(jdy09->StateGPIOPort, jdy09->StatePinNumber)
-			== GPIO_PIN_RESET)
-	{
-		switch (Command)
-		{
-		case JDY09_CMD_GETVERSION:
-			JDY09_SendAndDisplayCmd(jdy09, (uint8_t*) "AT+VERSION\r\n");
-			break;
-
-		case JDY09_CMD_RESET:
-			JDY09_SendAndDisplayCmd(jdy09, (uint8_t*) "AT+RESET\r\n");
-			break;
-
-		case JDY09_CMD_GETADRESS:
-			JDY09_SendAndDisplayCmd(jdy09, (uint8_t*) "AT+LADDR\r\n");
-			break;
-
-		case JDY09_CMD_GETBAUDRATE:
-			JDY09_SendAndDisplayCmd(jdy09, (uint8_t*) "AT+BAUD\r\n");
-			break;
-
-		case JDY09_CMD_GETPASSWORD:
-			JDY09_SendAndDisplayCmd(jdy09, (uint8_t*) "AT+PIN\r\n");
-			break;
-
-		case JDY09_CMD_GETNAME:
-			JDY09_SendAndDisplayCmd(jdy09, (uint8_t*) "AT+NAME\r\n");
-			break;
-
-		case JDY09_CMD_SETDEFAULTSETTINGS:
-			JDY09_SendAndDisplayCmd(jdy09, (uint8_t*) "AT+DEFAULT\r\n");
-			break;
-		}
-		return;
-	}
-
-	// AT cmd error
-	JDY09_DisplayTerminal("AT commands possible only in offline mode \n\r");
-
-}
-
-/*
- * Send random data from MCU to bluetooth connected device
- *
- * @param[*jdy09] - pointer to struct for JDY09 bluetooth module
- * @param[Data] - data to send to device
- *
- * @return - void
- */
-void JDY09_SendData(JDY09_t *jdy09, uint8_t *Data)
-{
-	// check if there is a connection
-	if (HAL_GPIO_ReadPin(jdy09->StateGPIOPort, jdy09->StatePinNumber)
-			== GPIO_PIN_SET)
-	{
-		// send array of bytes to external device
-		HAL_UART_Transmit(jdy09->huart, Data, strlen((char*) Data),
-		JDY09_UART_TIMEOUET);
-
-		JDY09_DisplayTerminal(
-				"Data transfer from JDY-09 to external device completed \n\r");
-
-		return;
-	}
-
-	// AT cmd error
-	JDY09_DisplayTerminal("Send data possible only in online mode \n\r");
-
-}
-
-/*
- * Disconnect from BT device using MCU
- *
- * @param[*jdy09] - pointer to struct for JDY09 bluetooth module
- * @return - void
- */
-void JDY09_Disconnect(JDY09_t *jdy09)
-{
-	//check connection
-	if (HAL_GPIO_ReadPin(jdy09->StateGPIOPort, jdy09->StatePinNumber)
-			== GPIO_PIN_SET)
-	{
-		// disconnect
-		JDY09_SendAndDisplayCmd(jdy09, (uint8_t*) "AT+DISC\r\n");
-		return;
-	}
-
-	// AT cmd error
-	JDY09_DisplayTerminal("Module already disconnected \n\r");
-}
-
-/*
- * Set new baud rate from MCU level
- * function is problematic with hal initialization of uart
- * user has to remember to change it in CubeMX
- *
- * @param[*jdy09] - pointer to struct for JDY09 bluetooth module
- * @param[Baudrate] - predefined baud rate
- * @return - void
- */
-void JDY09_SetBaudRate(JDY09_t *jdy09, uint8_t Baudrate)
-{
-	//check if there is no connection
-	if (HAL_GPIO_ReadPin(jdy09->StateGPIOPort, jdy09->StatePinNumber)
-			== GPIO_PIN_RESET)
-	{
-
-		//send new baudrate
-		uint8_t Msg[16];
-		sprintf((char*) Msg, "AT+BAUD%d\r\n", Baudrate);
-		JDY09_SendAndDisplayCmd(jdy09, Msg);
-		JDY09_DisplayTerminal("New baud set - restart device \n\r");
-
-		return;
-
-	}
-
-	// AT cmd error
-	JDY09_DisplayTerminal("AT commands possible only in offline mode \n\r");
-}
-
-/*
- * Set new name from MCU level
- *
- * @param[*jdy09] - pointer to struct for JDY09 bluetooth module
- * @param[*Name] - pointer to array with new password
- * @return - void
- */
-void JDY09_SetName(JDY09_t *jdy09, uint8_t *Name)
-{
-	// check if name is not too long
-	if (strlen((char*) Name) > JDY09_MAX_NAME_LENGHT)
-	{
-		JDY09_DisplayTerminal("Defined name too long, max 16 chars");
-		return;
-	}
-
-	// check if there is no active connection
-	if (HAL_GPIO_ReadPin(jdy09->StateGPIOPort, jdy09->StatePinNumber)
-			== GPIO_PIN_RESET)
-	{
-		uint8_t Msg[32];
-		sprintf((char*) Msg, "AT+NAME%s\r\n", Name);
-		JDY09_SendAndDisplayCmd(jdy09, Msg);
-		JDY09_DisplayTerminal("New name set - restart device \n\r");
-
-		return;
-	}
-
-	// AT cmd error
-	JDY09_DisplayTerminal("AT commands possible only in offline mode \n\r");
-}
-
-/*
- * Set password from MCU level
- *
- * @param[*jdy09] - pointer to struct for JDY09 bluetooth module
- * @param[Password] - new password
- * @return - void
- */
-void JDY09_SetPassword(JDY09_t *jdy09, uint8_t *Password)
-{
-	// check if pin is not too long
-	if (strlen((char*) Password) > JDY09_MAX_PIN_LENGHT)
-	{
-		JDY09_DisplayTerminal("Defined pin too long, max 4 digits");
-		return;
-	}
-
-	// check if there is no active connection
-	if (HAL_GPIO_ReadPin(jdy09->StateGPIOPort, jdy09->StatePinNumber)
-			== GPIO_PIN_RESET)
-	{
-		uint8_t Msg[32];
-		sprintf((char*) Msg, "AT+PIN%s\r\n", Password);
-		JDY09_SendAndDisplayCmd(jdy09, Msg);
-		JDY09_DisplayTerminal("New pin set - restart device \n\r");
-
-		return;
-	}
-
-	// AT cmd error
-	JDY09_DisplayTerminal("AT commands possible only in offline mode \n\r");
-}
-
-/*
- * Clear message pending flag
- *
- * @param[*jdy09] - pointer to struct for JDY09 bluetooth module
- * @return - void
- */
-void JDY09_ClearMsgPendingFlag(JDY09_t *jdy09)
-{
-	jdy09->MessagePending = JDY09_NOMESSAGE;
-}
-
-/*
- * Check if there is a message Pending, if yes -> write it to a MsgBuffer
- *
- * @param[*jdy09] - pointer to struct for JDY09 bluetooth module
- * @param[*MsgBuffer] - pointer to buffer where message has to be written
- * @return - status : massage pending 1/0
- */
-uint8_t JDY09_CheckPendingMessages(JDY09_t *jdy09, uint8_t *MsgBuffer)
-{
-
-	// Check if there is message finished
-	if (jdy09->LinesRecieved > 0)
-	{
-
-		uint8_t i = 0;
-		uint8_t temp = 0;
-		do
-		{
-			// Move a sign to ring buffer
-			RB_Read(&(jdy09->RingBuffer), &temp);
-			if (temp == JDY09_LASTCHARACTER)
-			{
-				MsgBuffer[i] = JDY09_LASTCHARACTER;
-				MsgBuffer[i + 1] = 0;
-			}
-			else
-			{
-				MsgBuffer[i] = temp;
-			}
-			i++;
-			//rewrite signs until last character defined by user
-		} while (temp != JDY09_LASTCHARACTER);
-		//decrement LinesRecieved
-		jdy09->LinesRecieved--;
-		//set up flag that message is ready to parse
-		jdy09->MessagePending = JDY09_MESSAGEPENDING;
-	}
-
-	// return if flag status
-	return jdy09->MessagePending;
-}
-
-/*
- * Callback to put in HAL_UART_RxCpltCallback for IT mode
- *
- * @param[*jdy09] - pointer to struct for JDY09 bluetooth module
- * @param[*huart] - uart handle
- * @return - void
- */
-#if (JDY09_UART_RX_IT == 1)
-void JDY09_RxCpltCallbackIT(JDY09_t *jdy09, UART_HandleTypeDef *huart)
-{
-
-	//check if IRQ is coming from correct uart
-	if (jdy09->huart->Instance == huart->Instance)
-	{
-		//write a sign to ring buffer
-		RB_Write((&(jdy09->RingBuffer)), jdy09->RecieveBufferIT);
-
-		// when line is complete -> add 1 to received lines
-		if (jdy09->RecieveBufferIT == JDY09_LASTCHARACTER)
-		{
-			(jdy09->LinesRecieved)++;
-		}
-
-		// start another IRQ for single sign
-		HAL_UART_Receive_IT(jdy09->huart, &(jdy09->RecieveBufferIT), 1);
-	}
-}
-#endif
-/*
- * Callback to put in HAL_UARTEx_RxEventCallback for DMA mode
- *
- * @param[*jdy09] - pointer to struct for JDY09 bluetooth module
- * @param[*huart] - uart handle
- * @param[size] - size of the recieved message
- * @return - void
- */
-#if (JDY09_UART_RX_DMA == 1)
-void JDY09_RxCpltCallbackDMA(JDY09_t *jdy09, UART_HandleTypeDef *huart,
-		uint16_t size)
-{
-
-	//check if IRQ is coming from correct uart
-	if (jdy09->huart->Instance == huart->Instance)
-	{
-
-		uint8_t i;
-		uint8_t newlines = 0;
-		//write message to ring buffer
-		for (i = 0; i < size; i++)
-		{
-			RB_Write((&(jdy09->RingBuffer)), jdy09->RecieveBufferDMA[i]);
-
-			// when line is complete -> add 1 to received lines
-			// only when last char is \n
-			if (jdy09->RecieveBufferDMA[i] == JDY09_LASTCHARACTER)
-			{
-				newlines++;
-			}
-		}
-
-		if (newlines == 0)
-		{
-			// if formt of data is not correct print msg
-			JDY09_SendData(jdy09,
-					(uint8_t*) "Error, message has to be finished with +LF \n\r");
-
-			//flush ringbuffer to not send later trash data
-			RB_Flush(&(jdy09->RingBuffer));
-		}
-
-		// add new lines
-		jdy09->LinesRecieved = +newlines;
-
-		// start another IRQ for single sign
-		HAL_UARTEx_ReceiveToIdle_DMA(jdy09->huart, jdy09->RecieveBufferDMA,
-		JDY09_RECIEVEBUFFERSIZE);
-		// to avoid callback from half message this has be disabled
-		__HAL_DMA_DISABLE_IT(jdy09->huart->hdmarx, DMA_IT_HT);
-	}
-}
-#endif
-
-/*
- * Callback to put in HAL_GPIO_EXTI_Callback
- *
- * @param[*jdy09] - pointer to struct for JDY09 bluetooth module
- * @param[GPIO_Pin] - pin number from EXTI
- * @return - void
- */
-void JDY09_EXTICallback(JDY09_t *jdy09, uint16_t GPIO_Pin)
-{
-
-	//check if IRQ is coming from STATE pin
-	if (jdy09->StatePinNumber == GPIO_Pin)
-	{
-		// if trigger is caused by rising edge then new connection is made
-		if (HAL_GPIO_ReadPin(BT_STATE_GPIO_Port, BT_STATE_Pin) == GPIO_PIN_SET)
-		{
-			JDY09_DisplayTerminal("Device connected \n\r");
-		}
-		else
-		// if trigger is from falling edge then msg disconnect
-		{
-			JDY09_DisplayTerminal("Device disconnected \n\r");
-		}
-
-		// clear ring buffer if device is connected/disconnected
-		RB_Flush(&(jdy09->RingBuffer));
-	}
-}
+/*
+ * JDY-09.c
+ *
+ *  Created on: April 24, 2023
+ *      Author: Ezrah Buki
+ */
+
+/* In JDY-09.h define JDY09_UART_RX_IT as 1 (using interrupt mode for receive) or 0 (use DMA mode for receive)
+ * DMA mode is recommended, if there is a situation that DMA RX is not possible, use IT mode.
+ *
+ * For UART transmit DMA is used, every frame (commands, data, responses of parser) goes
+ * through one transmit queue, so transfers never collide on the uart.
+ * Put JDY09_TxProcess in main loop and JDY09_TxCpltCallback in HAL_UART_TxCpltCallback.
+ *
+ * For user to configure in CubeMX :
+ *
+ * Default settings for UART :
+ * Baud: 9600 (JDY09_Init detects baud rate of module, JDY09_SetBaudRate changes it at runtime)
+ * Word lenght : 8
+ * Parity : None
+ * Stop Bits : 1
+ *
+ * if RX interrupt mode : enable USARTx Global Interrupt
+ * if RX DMA mode : enable USARTx Global Interrupt, enable DMAx streamx global interrupt
+ *
+ * Default settings for DMA:
+ * USARTx_RX
+ * Mode: Normal
+ * Peripheral to memory
+ * Increment address of memory
+ * Data width : byte
+ *
+ * USARTx_TX
+ * Mode: Normal
+ * Memory to peripheral
+ * Increment address of memory
+ * Data width : byte
+ *
+ * Default setting for State PIN (not necessary to use this pin - modify lib if you don't need it):
+ * GPIO_EXTIx
+ * No pull-up no pull-down
+ * External IT mode with Rising/Falling edge detection
+ * if using State Pin : put JDY09_EXTICallback in HAL_GPIO_EXTI_Callback
+ *
+ *
+ * if RX interrupt mode : put JDY09_RxCpltCallbackIT in HAL_UART_RxCpltCallback in main.c
+ * if RX DMA mode : put JDY09_RxCpltCallbackIT in HAL_UARTEx_RxEventCallback in main.c
+ *
+ *
+ * To write AT+Commands device has to be disconnected from master. Connection is defined by GPIO pin STATE.
+ * LED on JDY09 blinking - no bluetooth connection, LED on - bluetooth connected
+ *
+ */
+
+#include "usart.h"
+#include "JDY-09.h"
+#include "log.h"
+#include "pool.h"
+#include "stdio.h"
+#include "string.h"
+
+/*
+ * Terminal defined by user, commands sent in offline mode will be displayed
+ * with responses from JDY-09. Terminal uart is shared with log, so text is
+ * queued in log and it does not block, also in IRQ.
+ *
+ * @param[*Msg] - string to send to display terminal
+ *
+ * @return - void
+ */
+
+static void JDY09_DisplayTerminal(char *Msg)
+{
+	Log_WriteText(Msg);
+}
+
+/*
+ * Start receiving from JDY-09 in IT or DMA mode
+ *
+ * @param[*jdy09] - pointer to struct for JDY09 bluetooth module
+ * @return - void
+ */
+static void JDY09_StartReceive(JDY09_t *jdy09)
+{
+	// if irq mode is used for receive
+#if (JDY09_UART_RX_IT == 1)
+	HAL_UART_Receive_IT(jdy09->huart, &(jdy09->RecieveBufferIT), 1);
+#endif
+
+	// if dma mode is used for receive
+#if (JDY09_UART_RX_DMA == 1)
+	HAL_UARTEx_ReceiveToIdle_DMA(jdy09->huart, jdy09->RecieveBufferDMA,
+	JDY09_RECIEVEBUFFERSIZE);
+	// to avoid callback from half message this has be disabled
+	__HAL_DMA_DISABLE_IT(jdy09->huart->hdmarx, DMA_IT_HT);
+#endif
+}
+
+/*
+ * Drop everything received and reset line tracking
+ *
+ * @param[*jdy09] - pointer to struct for JDY09 bluetooth module
+ * @return - void
+ */
+static void JDY09_ResetReceive(JDY09_t *jdy09)
+{
+	RB_Flush(&(jdy09->RingBuffer));
+	jdy09->LinesRecieved = 0;
+	jdy09->LineStart = 0;
+	jdy09->LineLenght = 0;
+	jdy09->LineState = JDY09_LINESTATE_OK;
+	JDY09_ClearMsgPendingFlag(jdy09);
+}
+
+/*
+ * Drop part of the current line that is already in ring buffer.
+ * Only the line being received is removed, complete lines stay untouched.
+ *
+ * @param[*jdy09] - pointer to struct for JDY09 bluetooth module
+ * @return - void
+ */
+static void JDY09_DropLine(JDY09_t *jdy09)
+{
+	// move head back to beginning of the line
+	jdy09->RingBuffer.Head = jdy09->LineStart;
+	jdy09->LineLenght = 0;
+	jdy09->LineState = JDY09_LINESTATE_DROPPED;
+	jdy09->RxStats.DroppedLines++;
+
+	LOG_WARNING(LOG_MSG_BT_LINE_DROPPED, (unsigned long) jdy09->RxStats.DroppedLines);
+}
+
+/*
+ * Put received byte to ring buffer. Lines longer than JDY09_MAX_LINE_LENGHT are
+ * truncated or dropped, lines that don't fit in ring buffer are dropped.
+ * LinesRecieved counts only complete lines stored in ring buffer.
+ *
+ * @param[*jdy09] - pointer to struct for JDY09 bluetooth module
+ * @param[Byte] - received byte
+ * @return - void
+ */
+static void JDY09_StoreByte(JDY09_t *jdy09, uint8_t Byte)
+{
+	// end of line
+	if (Byte == JDY09_LASTCHARACTER)
+	{
+		if (jdy09->LineState != JDY09_LINESTATE_DROPPED)
+		{
+			if (RB_Write(&(jdy09->RingBuffer), Byte) == RB_OK)
+			{
+				if (jdy09->LineState == JDY09_LINESTATE_TRUNCATED)
+				{
+					jdy09->RxStats.TruncatedLines++;
+				}
+				// line is complete -> add 1 to received lines
+				jdy09->LinesRecieved++;
+			}
+			else
+			{
+				// no place for end of line
+				jdy09->RxStats.OverflowBytes++;
+				JDY09_DropLine(jdy09);
+			}
+		}
+
+		// start new line
+		jdy09->LineStart = jdy09->RingBuffer.Head;
+		jdy09->LineLenght = 0;
+		jdy09->LineState = JDY09_LINESTATE_OK;
+		return;
+	}
+
+	switch (jdy09->LineState)
+	{
+	case JDY09_LINESTATE_DROPPED:
+		// rest of dropped line
+		jdy09->RxStats.OverflowBytes++;
+		return;
+
+	case JDY09_LINESTATE_TRUNCATED:
+		// rest of truncated line is skipped
+		return;
+	}
+
+	// line too long
+	if (jdy09->LineLenght >= JDY09_MAX_LINE_LENGHT)
+	{
+#if (JDY09_LINE_OVERSIZE_POLICY == JDY09_LINE_TRUNCATE)
+		jdy09->LineState = JDY09_LINESTATE_TRUNCATED;
+#else
+		JDY09_DropLine(jdy09);
+#endif
+		return;
+	}
+
+	// ring buffer full
+	if (RB_Write(&(jdy09->RingBuffer), Byte) != RB_OK)
+	{
+		jdy09->RxStats.OverflowBytes++;
+		JDY09_DropLine(jdy09);
+		return;
+	}
+
+	jdy09->LineLenght++;
+}
+
+/*
+ * Wait until JDY-09 sends a full line and copy it to MsgBuffer
+ *
+ * @param[*jdy09] - pointer to struct for JDY09 bluetooth module
+ * @param[*MsgBuffer] - buffer for the response line
+ * @param[Timeout] - time to wait for response [ms]
+ * @return - status @status
+ */
+static uint8_t JDY09_WaitForResponse(JDY09_t *jdy09, uint8_t *MsgBuffer,
+		uint32_t Timeout)
+{
+	uint32_t responsetime = HAL_GetTick();
+
+	//wait for response line
+	while (jdy09->LinesRecieved == 0)
+	{
+		if (HAL_GetTick() - responsetime >= Timeout)
+		{
+			return JDY09_ERR_NORESPONSE;
+		}
+	}
+
+	//get message out of ring buffer
+	JDY09_CheckPendingMessages(jdy09, MsgBuffer);
+
+	//clear message pending flag
+	JDY09_ClearMsgPendingFlag(jdy09);
+
+	return JDY09_OK;
+}
+
+/*
+ * Queue frame for transmission, can be called from IRQ with Timeout 0
+ * Frame is pool block, it is given back after it is sent or when it is dropped.
+ *
+ * @param[*jdy09] - pointer to struct for JDY09 bluetooth module
+ * @param[*Frame] - pool block with data
+ * @param[Lenght] - bytes to send
+ * @param[Timeout] - time to wait for place in full queue [ms], 0 - drop at once
+ * @return - status @status
+ */
+uint8_t JDY09_Transmit(JDY09_t *jdy09, uint8_t *Frame, uint16_t Lenght,
+		uint32_t Timeout)
+{
+	uint32_t StartTime = HAL_GetTick();
+	uint32_t primask;
+
+	// queue full - make place by sending waiting frames
+	while (jdy09->TxCount == JDY09_TX_QUEUE_SIZE)
+	{
+		if (Timeout == 0 || HAL_GetTick() - StartTime >= Timeout)
+		{
+			jdy09->TxStats.Dropped++;
+			Pool_Free(Frame);
+			return JDY09_ERR_BUSY;
+		}
+		JDY09_TxProcess(jdy09);
+	}
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+
+	jdy09->TxQueue[jdy09->TxHead] = Frame;
+	jdy09->TxLenght[jdy09->TxHead] = Lenght;
+	jdy09->TxHead = (jdy09->TxHead + 1) % JDY09_TX_QUEUE_SIZE;
+	jdy09->TxCount++;
+
+	__set_PRIMASK(primask);
+
+	return JDY09_OK;
+}
+
+/*
+ * Start transmission of next frame when uart is free, call it from main loop
+ * Frame refused by HAL stays in queue and is tried again on next call,
+ * after JDY09_TX_MAX_RETRIES refusals it is dropped.
+ * Error for line without end of line found in RX IRQ is queued here.
+ *
+ * @param[*jdy09] - pointer to struct for JDY09 bluetooth module
+ * @return - void
+ */
+void JDY09_TxProcess(JDY09_t *jdy09)
+{
+	uint8_t *Frame;
+
+	if (jdy09->LineErrorPending)
+	{
+		jdy09->LineErrorPending = 0;
+		JDY09_SendData(jdy09, (uint8_t*) "Error, message has to be finished with +LF \n\r");
+	}
+
+	if (jdy09->huart->gState != HAL_UART_STATE_READY)
+	{
+		return;
+	}
+
+	// end of last frame was not reported, block is not used by DMA anymore
+	if (jdy09->TxFrame != NULL)
+	{
+		Pool_Free(jdy09->TxFrame);
+		jdy09->TxFrame = NULL;
+	}
+
+	if (jdy09->TxCount == 0)
+	{
+		return;
+	}
+
+	// frame is owned by DMA before transfer can end
+	Frame = jdy09->TxQueue[jdy09->TxTail];
+	jdy09->TxFrame = Frame;
+	if (HAL_UART_Transmit_DMA(jdy09->huart, Frame,
+			jdy09->TxLenght[jdy09->TxTail]) != HAL_OK)
+	{
+		jdy09->TxFrame = NULL;
+		jdy09->TxStats.Retries++;
+		if (++jdy09->TxRetries < JDY09_TX_MAX_RETRIES)
+		{
+			return;
+		}
+		jdy09->TxStats.Dropped++;
+		jdy09->TxStats.RetryDrops++;
+		Pool_Free(Frame);
+	}
+	else
+	{
+		jdy09->TxStats.Frames++;
+	}
+	jdy09->TxRetries = 0;
+
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+
+	jdy09->TxTail = (jdy09->TxTail + 1) % JDY09_TX_QUEUE_SIZE;
+	jdy09->TxCount--;
+
+	__set_PRIMASK(primask);
+}
+
+/*
+ * Send all queued frames and wait until last of them is on the wire,
+ * used before waiting for response and when pool blocks are needed
+ *
+ * @param[*jdy09] - pointer to struct for JDY09 bluetooth module
+ * @param[Timeout] - maximum time [ms]
+ * @return - status @status
+ */
+uint8_t JDY09_WaitTxIdle(JDY09_t *jdy09, uint32_t Timeout)
+{
+	uint32_t StartTime = HAL_GetTick();
+
+	while (JDY09_IsTxBusy(jdy09))
+	{
+		if (HAL_GetTick() - StartTime >= Timeout)
+		{
+			return JDY09_ERR_BUSY;
+		}
+		JDY09_TxProcess(jdy09);
+	}
+
+	// give back block of last frame
+	JDY09_TxProcess(jdy09);
+
+	return JDY09_OK;
+}
+
+/*
+ * Check if frames wait for transmission or are sent now
+ *
+ * @param[*jdy09] - pointer to struct for JDY09 bluetooth module
+ * @return - 1 transmit in progress, 0 idle
+ */
+uint8_t JDY09_IsTxBusy(JDY09_t *jdy09)
+{
+	return (jdy09->TxCount != 0)
+			|| (jdy09->huart->gState != HAL_UART_STATE_READY);
+}
+
+/*
+ * Give back block of sent frame, put in HAL_UART_TxCpltCallback
+ *
+ * @param[*jdy09] - pointer to struct for JDY09 bluetooth module
+ * @param[*huart] - uart handle
+ * @return - void
+ */
+void JDY09_TxCpltCallback(JDY09_t *jdy09, UART_HandleTypeDef *huart)
+{
+	if (jdy09->huart->Instance == huart->Instance && jdy09->TxFrame != NULL)
+	{
+		Pool_Free(jdy09->TxFrame);
+		jdy09->TxFrame = NULL;
+	}
+}
+
+/*
+ * Copy string to pool block and queue it
+ *
+ * @param[*jdy09] - pointer to struct for JDY09 bluetooth module
+ * @param[*Data] - string to send
+ * @param[Timeout] - time to wait for place in queue [ms], 0 in IRQ
+ * @return - status @status
+ */
+static uint8_t JDY09_TransmitString(JDY09_t *jdy09, const uint8_t *Data,
+		uint32_t Timeout)
+{
+	uint16_t Lenght = strlen((char*) Data);
+	uint8_t *Frame = Pool_Alloc(Lenght);
+
+	if (Frame == NULL)
+	{
+		jdy09->TxStats.Dropped++;
+		return JDY09_ERR_NOMEMORY;
+	}
+	memcpy(Frame, Data, Lenght);
+
+	return JDY09_Transmit(jdy09, Frame, Lenght, Timeout);
+}
+
+/*
+ * Send string and wait until it is on the wire, used by AT commands
+ *
+ * @param[*jdy09] - pointer to struct for JDY09 bluetooth module
+ * @param[*Command] - command to send
+ * @return - status @status
+ */
+static uint8_t JDY09_TransmitCommand(JDY09_t *jdy09, const uint8_t *Command)
+{
+	uint8_t Status;
+
+	Status = JDY09_TransmitString(jdy09, Command, JDY09_UART_TIMEOUET);
+	if (Status != JDY09_OK)
+	{
+		return Status;
+	}
+
+	return JDY09_WaitTxIdle(jdy09, JDY09_UART_TIMEOUET);
+}
+
+/*
+ * Simple command send between MCU and JDY-09
+ *
+ * @param[*jdy09] - pointer to struct for JDY09 bluetooth module
+ * @param[Command] - predefined command to send
+ * @param[*Expected] - expected beginning of response, NULL if any response is fine
+ * @return - status @status
+ */
+static uint8_t JDY09_SendAndDisplayCmd(JDY09_t *jdy09, uint8_t *Command,
+		const char *Expected)
+{
+	uint8_t Status = JDY09_OK;
+	uint8_t *MsgRecieved = Pool_Alloc(JDY09_RECIEVEBUFFERSIZE);
+
+	if (MsgRecieved == NULL)
+	{
+		return JDY09_ERR_NOMEMORY;
+	}
+
+	//display send info on user display terminal
+	JDY09_DisplayTerminal("Sending: ");
+	JDY09_DisplayTerminal((char*) Command);
+
+	//send data to JDY-09
+	if (JDY09_TransmitCommand(jdy09, Command) != JDY09_OK)
+	{
+		JDY09_DisplayTerminal("Not sent, UART busy\n\r");
+		Status = JDY09_ERR_BUSY;
+	}
+	//wait for response line
+	else if (JDY09_WaitForResponse(jdy09, MsgRecieved, JDY09_UART_TIMEOUET)
+			!= JDY09_OK)
+	{
+		JDY09_DisplayTerminal("No response, UART communication error\n\r");
+		Status = JDY09_ERR_NORESPONSE;
+	}
+	else
+	{
+		//display response
+		JDY09_DisplayTerminal("Response: ");
+		JDY09_DisplayTerminal((char*) MsgRecieved);
+
+		//check if response is the one we wait for
+		if (Expected != NULL
+				&& strncmp((char*) MsgRecieved, Expected, strlen(Expected)) != 0)
+		{
+			Status = JDY09_ERR_WRONGRESPONSE;
+		}
+	}
+
+	Pool_Free(MsgRecieved);
+	return Status;
+}
+
+/*
+ * Send probe command without displaying it, used to check if uart baud rate
+ * matches the one set in JDY-09
+ *
+ * @param[*jdy09] - pointer to struct for JDY09 bluetooth module
+ * @return - status @status
+ */
+static uint8_t JDY09_Probe(JDY09_t *jdy09)
+{
+	uint8_t Status = JDY09_OK;
+	uint8_t *MsgRecieved = Pool_Alloc(JDY09_RECIEVEBUFFERSIZE);
+
+	if (MsgRecieved == NULL)
+	{
+		return JDY09_ERR_NOMEMORY;
+	}
+
+	if (JDY09_TransmitCommand(jdy09, (uint8_t*) "AT+VERSION\r\n") != JDY09_OK)
+	{
+		Status = JDY09_ERR_BUSY;
+	}
+	else if (JDY09_WaitForResponse(jdy09, MsgRecieved, JDY09_PROBE_TIMEOUT)
+			!= JDY09_OK)
+	{
+		Status = JDY09_ERR_NORESPONSE;
+	}
+	// on wrong baud rate we can get a line of trash, check the answer
+	else if (strncmp((char*) MsgRecieved, "+VERSION", 8) != 0)
+	{
+		Status = JDY09_ERR_WRONGRESPONSE;
+	}
+
+	Pool_Free(MsgRecieved);
+	return Status;
+}
+
+/*
+ * Get baud rate
+ *
+ * @param[Baudrate] - predefined baud rate 4-9
+ *
+ * @return - baud rate value 9600 - 128000;
+ */
+static uint32_t JDY09_GetBaud(uint8_t Baudrate)
+{
+	switch (Baudrate)
+	{
+	case JDY09_BAUDRATE_9600:
+		return 9600;
+
+	case JDY09_BAUDRATE_19200:
+		return 19200;
+
+	case JDY09_BAUDRATE_38400:
+		return 38400;
+
+	case JDY09_BAUDRATE_57600:
+		return 57600;
+
+	case JDY09_BAUDRATE_115200:
+		return 115200;
+
+	case JDY09_BAUDRATE_128000:
+		return 128000;
+
+	}
+
+	return 9600;
+}
+
+/*
+ * Get predefined baud rate from its value
+ *
+ * @param[Baud] - baud rate value 9600 - 128000
+ *
+ * @return - predefined baud rate 4-9, 0 if value is not supported
+ */
+static uint8_t JDY09_GetBaudCode(uint32_t Baud)
+{
+	uint8_t Baudrate;
+
+	for (Baudrate = JDY09_BAUDRATE_9600; Baudrate <= JDY09_BAUDRATE_128000;
+			Baudrate++)
+	{
+		if (JDY09_GetBaud(Baudrate) == Baud)
+		{
+			return Baudrate;
+		}
+	}
+
+	return 0;
+}
+
+/*
+ * Change uart baud rate without reinitializing the peripheral.
+ * Reception is stopped, BRR is recalculated from current bus clock and reception is started again.
+ *
+ * @param[*jdy09] - pointer to struct for JDY09 bluetooth module
+ * @param[Baud] - baud rate value
+ *
+ * @return - void
+ */
+static void JDY09_SetUartBaud(JDY09_t *jdy09, uint32_t Baud)
+{
+	UART_HandleTypeDef *huart = jdy09->huart;
+	uint32_t pclk;
+
+	// stop reception, ongoing DMA transfer would receive trash during switch
+	HAL_UART_AbortReceive(huart);
+
+	// USART1 and USART6 are on APB2, others on APB1
+	if (huart->Instance == USART1 || huart->Instance == USART6)
+	{
+		pclk = HAL_RCC_GetPCLK2Freq();
+	}
+	else
+	{
+		pclk = HAL_RCC_GetPCLK1Freq();
+	}
+
+	// write new baud rate register
+	__HAL_UART_DISABLE(huart);
+	if (huart->Init.OverSampling == UART_OVERSAMPLING_8)
+	{
+		huart->Instance->BRR = UART_BRR_SAMPLING8(pclk, Baud);
+	}
+	else
+	{
+		huart->Instance->BRR = UART_BRR_SAMPLING16(pclk, Baud);
+	}
+	__HAL_UART_ENABLE(huart);
+
+	// keep init structure consistent for next HAL_UART_Init
+	huart->Init.BaudRate = Baud;
+
+	// drop everything received with old baud rate
+	JDY09_ResetReceive(jdy09);
+
+	JDY09_StartReceive(jdy09);
+}
+/*
+ * Initialize JDY-09 structure
+ *
+ * @param[*jdy09] - pointer to struct for JDY09 bluetooth module
+ * @param[huart] - handler to uart that JDY-09 is connected to
+ * @param[StateGPIOPort] - handle to GPIO port of STATE pin
+ * @param[StateGPIOPin] - pin number of STATE pin
+ *
+ * @return - void
+ */
+void JDY09_Init(JDY09_t *jdy09, UART_HandleTypeDef *huart,
+		GPIO_TypeDef *StateGPIOPort, uint16_t StateGPIOPin)
+{
+
+	// init msg
+	JDY09_DisplayTerminal("JDY-09 Initializing... \n\r");
+
+	// reset the ring buffer, transmit queue and statistics
+	JDY09_ResetReceive(jdy09);
+	memset(&(jdy09->RxStats), 0, sizeof(jdy09->RxStats));
+	jdy09->TxHead = 0;
+	jdy09->TxTail = 0;
+	jdy09->TxCount = 0;
+	jdy09->TxRetries = 0;
+	jdy09->TxFrame = NULL;
+	jdy09->LineErrorPending = 0;
+	memset(&(jdy09->TxStats), 0, sizeof(jdy09->TxStats));
+
+	// Assign uart
+	jdy09->huart = huart;
+
+	// Assign GPIO for State pin
+	jdy09->StateGPIOPort = StateGPIOPort;
+	jdy09->StatePinNumber = StateGPIOPin;
+
+	// baud rate configured in CubeMX
+	jdy09->BaudRate = JDY09_GetBaudCode(huart->Init.BaudRate);
+
+	// start reception in IT or DMA mode
+	JDY09_StartReceive(jdy09);
+
+	// small delay before transmission
+	HAL_Delay(100);
+
+	//during init - disconnect and display basic information
+	JDY09_Disconnect(jdy09);
+
+	// find baud rate that module is using
+	JDY09_DetectBaudRate(jdy09);
+
+	//for some reason this msg will not work in DMA recieve mode
+	//solution yet to find
+	JDY09_SendCommand(jdy09, JDY09_CMD_GETVERSION);
+	JDY09_SendCommand(jdy09, JDY09_CMD_GETADRESS);
+	JDY09_SendCommand(jdy09, JDY09_CMD_GETBAUDRATE);
+	JDY09_SendCommand(jdy09, JDY09_CMD_GETNAME);
+	JDY09_SendCommand(jdy09, JDY09_CMD_GETPASSWORD);
+}
+
+/*
+ * Send selected command to JDy-09 in offline mode
+ *
+ * @param[*jdy09] - pointer to struct for JDY09 bluetooth module
+ * @param[Command] - predefined commands that are in .h file
+ *
+ * @return - void
+ */
+void JDY09_SendCommand(JDY09_t *jdy09, JDY09_CMD Command)
+{
+	// check if there is no connection
+	if (HAL_GPIO_ReadPin(jdy09->StateGPIOPort, jdy09->StatePinNumber)
+			== GPIO_PIN_RESET)
+	{
+		switch (Command)
+		{
+		case JDY09_CMD_GETVERSION:
+			JDY09_SendAndDisplayCmd(jdy09, (uint8_t*) "AT+VERSION\r\n", NULL);
+			break;
+
+		case JDY09_CMD_RESET:
+			JDY09_SendAndDisplayCmd(jdy09, (uint8_t*) "AT+RESET\r\n", NULL);
+			break;
+
+		case JDY09_CMD_GETADRESS:
+			JDY09_SendAndDisplayCmd(jdy09, (uint8_t*) "AT+LADDR\r\n", NULL);
+			break;
+
+		case JDY09_CMD_GETBAUDRATE:
+			JDY09_SendAndDisplayCmd(jdy09, (uint8_t*) "AT+BAUD\r\n", NULL);
+			break;
+
+		case JDY09_CMD_GETPASSWORD:
+			JDY09_SendAndDisplayCmd(jdy09, (uint8_t*) "AT+PIN\r\n", NULL);
+			break;
+
+		case JDY09_CMD_GETNAME:
+			JDY09_SendAndDisplayCmd(jdy09, (uint8_t*) "AT+NAME\r\n", NULL);
+			break;
+
+		case JDY09_CMD_SETDEFAULTSETTINGS:
+			JDY09_SendAndDisplayCmd(jdy09, (uint8_t*) "AT+DEFAULT\r\n", NULL);
+			break;
+		}
+		return;
+	}
+
+	// AT cmd error
+	JDY09_DisplayTerminal("AT commands possible only in offline mode \n\r");
+
+}
+
+/*
+ * Send random data from MCU to bluetooth connected device
+ *
+ * @param[*jdy09] - pointer to struct for JDY09 bluetooth module
+ * @param[Data] - data to send to device
+ *
+ * @return - void
+ */
+void JDY09_SendData(JDY09_t *jdy09, uint8_t *Data)
+{
+	// check if there is a connection
+	if (HAL_GPIO_ReadPin(jdy09->StateGPIOPort, jdy09->StatePinNumber)
+			== GPIO_PIN_SET)
+	{
+		// queued behind frames already waiting, also from IRQ
+		if (JDY09_TransmitString(jdy09, Data, 0) != JDY09_OK)
+		{
+			JDY09_DisplayTerminal("Data to external device dropped, UART busy \n\r");
+		}
+
+		return;
+	}
+
+	// AT cmd error
+	JDY09_DisplayTerminal("Send data possible only in online mode \n\r");
+
+}
+
+/*
+ * Check bluetooth connection on STATE pin
+ *
+ * @param[*jdy09] - pointer to struct for JDY09 bluetooth module
+ * @return - 1 master connected, 0 disconnected
+ */
+uint8_t JDY09_IsConnected(JDY09_t *jdy09)
+{
+	return (HAL_GPIO_ReadPin(jdy09->StateGPIOPort, jdy09->StatePinNumber)
+			== GPIO_PIN_SET);
+}
+
+/*
+ * Disconnect from BT device using MCU
+ *
+ * @param[*jdy09] - pointer to struct for JDY09 bluetooth module
+ * @return - void
+ */
+void JDY09_Disconnect(JDY09_t *jdy09)
+{
+	//check connection
+	if (HAL_GPIO_ReadPin(jdy09->StateGPIOPort, jdy09->StatePinNumber)
+			== GPIO_PIN_SET)
+	{
+		// disconnect
+		JDY09_SendAndDisplayCmd(jdy09, (uint8_t*) "AT+DISC\r\n", NULL);
+		return;
+	}
+
+	// AT cmd error
+	JDY09_DisplayTerminal("Module already disconnected \n\r");
+}
+
+/*
+ * Set new baud rate from MCU level
+ * JDY-09 is switched by AT command, then uart baud rate register is changed
+ * and communication is verified. If module doesn't answer on new baud rate
+ * previous one is restored.
+ *
+ * @param[*jdy09] - pointer to struct for JDY09 bluetooth module
+ * @param[Baudrate] - predefined baud rate
+ * @return - status @status
+ */
+uint8_t JDY09_SetBaudRate(JDY09_t *jdy09, uint8_t Baudrate)
+{
+	// check if baud rate is supported
+	if (Baudrate < JDY09_BAUDRATE_9600 || Baudrate > JDY09_BAUDRATE_128000)
+	{
+		JDY09_DisplayTerminal("Baud rate not supported \n\r");
+		return JDY09_ERR_WRONGBAUD;
+	}
+
+	//check if there is no connection
+	if (HAL_GPIO_ReadPin(jdy09->StateGPIOPort, jdy09->StatePinNumber)
+			!= GPIO_PIN_RESET)
+	{
+		// AT cmd error
+		JDY09_DisplayTerminal("AT commands possible only in offline mode \n\r");
+		return JDY09_ERR_ONLINE;
+	}
+
+	// nothing to do
+	if (Baudrate == jdy09->BaudRate)
+	{
+		return JDY09_OK;
+	}
+
+	uint32_t OldBaud = jdy09->huart->Init.BaudRate;
+	uint8_t Msg[32];
+	uint8_t Status;
+
+	//send new baudrate and wait for ack
+	sprintf((char*) Msg, "AT+BAUD%d\r\n", Baudrate);
+	if (JDY09_SendAndDisplayCmd(jdy09, Msg, "+OK") != JDY09_OK)
+	{
+		JDY09_DisplayTerminal("Baud change not confirmed \n\r");
+		return JDY09_ERR_NORESPONSE;
+	}
+
+	// new baud rate is used after restart of module
+	JDY09_SendAndDisplayCmd(jdy09, (uint8_t*) "AT+RESET\r\n", NULL);
+	HAL_Delay(JDY09_RESET_DELAY);
+
+	// switch uart and check if module answers
+	JDY09_SetUartBaud(jdy09, JDY09_GetBaud(Baudrate));
+	if (JDY09_Probe(jdy09) == JDY09_OK)
+	{
+		jdy09->BaudRate = Baudrate;
+		JDY09_DisplayTerminal("New baud rate set \n\r");
+		return JDY09_OK;
+	}
+
+	// no answer - go back to previous baud rate
+	JDY09_SetUartBaud(jdy09, OldBaud);
+	if (JDY09_Probe(jdy09) == JDY09_OK)
+	{
+		JDY09_DisplayTerminal("No response on new baud rate, fallback \n\r");
+		return JDY09_ERR_FALLBACK;
+	}
+
+	// module is lost, search on all baud rates, it can be found also on the new one
+	Status = JDY09_DetectBaudRate(jdy09);
+	sprintf((char*) Msg, "Baud rate in use: %lu \n\r",
+			(unsigned long) jdy09->huart->Init.BaudRate);
+	JDY09_DisplayTerminal((char*) Msg);
+	return Status;
+}
+
+/*
+ * Detect baud rate used by JDY-09, every predefined baud rate is probed
+ * until module answers. Works only in offline mode.
+ *
+ * @param[*jdy09] - pointer to struct for JDY09 bluetooth module
+ * @return - status @status
+ */
+uint8_t JDY09_DetectBaudRate(JDY09_t *jdy09)
+{
+	uint32_t OldBaud = jdy09->huart->Init.BaudRate;
+	uint8_t Baudrate;
+	char Msg[40];
+
+	//check if there is no connection
+	if (HAL_GPIO_ReadPin(jdy09->StateGPIOPort, jdy09->StatePinNumber)
+			!= GPIO_PIN_RESET)
+	{
+		return JDY09_ERR_ONLINE;
+	}
+
+	// start with current baud rate - most probable one
+	if (JDY09_Probe(jdy09) == JDY09_OK)
+	{
+		return JDY09_OK;
+	}
+
+	for (Baudrate = JDY09_BAUDRATE_9600; Baudrate <= JDY09_BAUDRATE_128000;
+			Baudrate++)
+	{
+		JDY09_SetUartBaud(jdy09, JDY09_GetBaud(Baudrate));
+
+		if (JDY09_Probe(jdy09) == JDY09_OK)
+		{
+			jdy09->BaudRate = Baudrate;
+			sprintf(Msg, "Detected baud rate: %lu \n\r",
+					(unsigned long) JDY09_GetBaud(Baudrate));
+			JDY09_DisplayTerminal(Msg);
+			return JDY09_OK;
+		}
+	}
+
+	// nothing found - go back to configured baud rate
+	JDY09_SetUartBaud(jdy09, OldBaud);
+	JDY09_DisplayTerminal("Baud rate detection failed \n\r");
+	return JDY09_ERR_NORESPONSE;
+}
+
+/*
+ * Set new name from MCU level
+ *
+ * @param[*jdy09] - pointer to struct for JDY09 bluetooth module
+ * @param[*Name] - pointer to array with new password
+ * @return - void
+ */
+void JDY09_SetName(JDY09_t *jdy09, uint8_t *Name)
+{
+	// check if name is not too long
+	if (strlen((char*) Name) > JDY09_MAX_NAME_LENGHT)
+	{
+		JDY09_DisplayTerminal("Defined name too long, max 16 chars");
+		return;
+	}
+
+	// check if there is no active connection
+	if (HAL_GPIO_ReadPin(jdy09->StateGPIOPort, jdy09->StatePinNumber)
+			== GPIO_PIN_RESET)
+	{
+		uint8_t Msg[32];
+		sprintf((char*) Msg, "AT+NAME%s\r\n", Name);
+		JDY09_SendAndDisplayCmd(jdy09, Msg, NULL);
+		JDY09_DisplayTerminal("New name set - restart device \n\r");
+
+		return;
+	}
+
+	// AT cmd error
+	JDY09_DisplayTerminal("AT commands possible only in offline mode \n\r");
+}
+
+/*
+ * Set password from MCU level
+ *
+ * @param[*jdy09] - pointer to struct for JDY09 bluetooth module
+ * @param[Password] - new password
+ * @return - void
+ */
+void JDY09_SetPassword(JDY09_t *jdy09, uint8_t *Password)
+{
+	// check if pin is not too long
+	if (strlen((char*) Password) > JDY09_MAX_PIN_LENGHT)
+	{
+		JDY09_DisplayTerminal("Defined pin too long, max 4 digits");
+		return;
+	}
+
+	// check if there is no active connection
+	if (HAL_GPIO_ReadPin(jdy09->StateGPIOPort, jdy09->StatePinNumber)
+			== GPIO_PIN_RESET)
+	{
+		uint8_t Msg[32];
+		sprintf((char*) Msg, "AT+PIN%s\r\n", Password);
+		JDY09_SendAndDisplayCmd(jdy09, Msg, NULL);
+		JDY09_DisplayTerminal("New pin set - restart device \n\r");
+
+		return;
+	}
+
+	// AT cmd error
+	JDY09_DisplayTerminal("AT commands possible only in offline mode \n\r");
+}
+
+/*
+ * Clear message pending flag
+ *
+ * @param[*jdy09] - pointer to struct for JDY09 bluetooth module
+ * @return - void
+ */
+void JDY09_ClearMsgPendingFlag(JDY09_t *jdy09)
+{
+	jdy09->MessagePending = JDY09_NOMESSAGE;
+}
+
+/*
+ * Check if there is a message Pending, if yes -> write it to a MsgBuffer
+ *
+ * @param[*jdy09] - pointer to struct for JDY09 bluetooth module
+ * @param[*MsgBuffer] - pointer to buffer where message has to be written, at least JDY09_MAX_LINE_LENGHT + 2 bytes
+ * @return - status : massage pending 1/0
+ */
+uint8_t JDY09_CheckPendingMessages(JDY09_t *jdy09, uint8_t *MsgBuffer)
+{
+
+	// Check if there is message finished
+	if (jdy09->LinesRecieved > 0)
+	{
+
+		uint16_t i = 0;
+		uint8_t temp = 0;
+		do
+		{
+			// Move a sign from ring buffer, stop if it is empty
+			if (RB_Read(&(jdy09->RingBuffer), &temp) != RB_OK)
+			{
+				break;
+			}
+			// lines in ring buffer are limited, but never write outside MsgBuffer
+			if (i < JDY09_MAX_LINE_LENGHT && temp != JDY09_LASTCHARACTER)
+			{
+				MsgBuffer[i] = temp;
+				i++;
+			}
+			//rewrite signs until last character defined by user
+		} while (temp != JDY09_LASTCHARACTER);
+
+		MsgBuffer[i] = JDY09_LASTCHARACTER;
+		MsgBuffer[i + 1] = 0;
+
+		//decrement LinesRecieved, it is incremented in IRQ
+		uint32_t primask = __get_PRIMASK();
+		__disable_irq();
+		jdy09->LinesRecieved--;
+		__set_PRIMASK(primask);
+
+		//set up flag that message is ready to parse
+		jdy09->MessagePending = JDY09_MESSAGEPENDING;
+	}
+
+	// return if flag status
+	return jdy09->MessagePending;
+}
+
+/*
+ * Callback to put in HAL_UART_RxCpltCallback for IT mode
+ *
+ * @param[*jdy09] - pointer to struct for JDY09 bluetooth module
+ * @param[*huart] - uart handle
+ * @return - void
+ */
+#if (JDY09_UART_RX_IT == 1)
+void JDY09_RxCpltCallbackIT(JDY09_t *jdy09, UART_HandleTypeDef *huart)
+{
+
+	//check if IRQ is coming from correct uart
+	if (jdy09->huart->Instance == huart->Instance)
+	{
+		//write a sign to ring buffer
+		JDY09_StoreByte(jdy09, jdy09->RecieveBufferIT);
+
+		// start another IRQ for single sign
+		JDY09_StartReceive(jdy09);
+	}
+}
+#endif
+/*
+ * Callback to put in HAL_UARTEx_RxEventCallback for DMA mode
+ *
+ * @param[*jdy09] - pointer to struct for JDY09 bluetooth module
+ * @param[*huart] - uart handle
+ * @param[size] - size of the recieved message
+ * @return - void
+ */
+#if (JDY09_UART_RX_DMA == 1)
+void JDY09_RxCpltCallbackDMA(JDY09_t *jdy09, UART_HandleTypeDef *huart,
+		uint16_t size)
+{
+
+	//check if IRQ is coming from correct uart
+	if (jdy09->huart->Instance == huart->Instance)
+	{
+
+		uint16_t i;
+		//write message to ring buffer
+		for (i = 0; i < size; i++)
+		{
+			JDY09_StoreByte(jdy09, jdy09->RecieveBufferDMA[i]);
+		}
+
+		// idle line detected but line is not finished
+		// (full DMA buffer means the line continues in next transfer)
+		if (size < JDY09_RECIEVEBUFFERSIZE)
+		{
+			if (jdy09->LineLenght > 0)
+			{
+				// if formt of data is not correct msg is sent from main loop,
+				// sending can wait for uart
+				jdy09->LineErrorPending = 1;
+
+				// drop unfinished line to not send later trash data
+				JDY09_DropLine(jdy09);
+			}
+			// next transfer starts a new line
+			jdy09->LineState = JDY09_LINESTATE_OK;
+		}
+
+		// start another DMA reception
+		JDY09_StartReceive(jdy09);
+	}
+}
+#endif
+
+/*
+ * Callback to put in HAL_GPIO_EXTI_Callback
+ *
+ * @param[*jdy09] - pointer to struct for JDY09 bluetooth module
+ * @param[GPIO_Pin] - pin number from EXTI
+ * @return - void
+ */
+void JDY09_EXTICallback(JDY09_t *jdy09, uint16_t GPIO_Pin)
+{
+
+	//check if IRQ is coming from STATE pin
+	if (jdy09->StatePinNumber == GPIO_Pin)
+	{
+		// if trigger is caused by rising edge then new connection is made
+		if (HAL_GPIO_ReadPin(BT_STATE_GPIO_Port, BT_STATE_Pin) == GPIO_PIN_SET)
+		{
+			LOG_INFO(LOG_MSG_BT_CONNECTED);
+		}
+		else
+		// if trigger is from falling edge then msg disconnect
+		{
+			LOG_INFO(LOG_MSG_BT_DISCONNECTED);
+		}
+
+		// clear ring buffer if device is connected/disconnected
+		JDY09_ResetReceive(jdy09);
+	}
+}
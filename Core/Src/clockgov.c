@@ -0,0 +1,353 @@
+/*
+ * clockgov.c
+ *
+ *  Created on: 19 October 2026
+ */
+
+/* Clock governor, core runs from PLL only while there is work.
+ *
+ * When nothing was queued for CLOCKGOV_IDLE_TIME, SYSCLK is switched to HSI and PLL
+ * is stopped. Queued commands, DUMP stream or backlog replay switch it back to PLL.
+ * HAL_RCC_ClockConfig sets flash latency and SysTick, everything derived from bus
+ * clocks is set again here: UART BRR, I2C timing and TIM1 prescaler.
+ *
+ * Level is changed only when UARTs are not sending and I2C is free, byte received
+ * during the switch can still be lost. When I2C can not be set for new PCLK1 it falls
+ * back to 100 kHz, when even that fails the old level is set back.
+ */
+
+#include "main.h"
+#include "usart.h"
+#include "i2c.h"
+#include "tim.h"
+#include "log.h"
+#include "i2cbus.h"
+#include "clockgov.h"
+
+static ClockGov_t ClockGov;
+
+/*
+ * Set BRR of UART from its APB clock, reception by DMA keeps running
+ *
+ * @param[*huart] - UART handle
+ * @return - void
+ */
+static void ClockGov_UpdateUart(UART_HandleTypeDef *huart)
+{
+	uint32_t Pclk;
+
+	// USART1 and USART6 are on APB2
+	if (huart->Instance == USART1)
+	{
+		Pclk = HAL_RCC_GetPCLK2Freq();
+	}
+	else
+	{
+		Pclk = HAL_RCC_GetPCLK1Freq();
+	}
+
+	if (huart->Init.OverSampling == UART_OVERSAMPLING_8)
+	{
+		huart->Instance->BRR = UART_BRR_SAMPLING8(Pclk, huart->Init.BaudRate);
+	}
+	else
+	{
+		huart->Instance->BRR = UART_BRR_SAMPLING16(Pclk, huart->Init.BaudRate);
+	}
+}
+
+/*
+ * Set TIM1 prescaler so counter frequency stays CLOCKGOV_TIM1_TICK
+ * New prescaler is loaded on next update event, one period can be off.
+ *
+ * @return - void
+ */
+static void ClockGov_UpdateTimer(void)
+{
+	uint32_t TimClock = HAL_RCC_GetPCLK2Freq();
+
+	// timer clock is twice APB clock when APB is divided
+	if ((RCC->CFGR & RCC_CFGR_PPRE2) >= RCC_CFGR_PPRE2_DIV2)
+	{
+		TimClock *= 2;
+	}
+
+	htim1.Init.Prescaler = (TimClock / CLOCKGOV_TIM1_TICK) - 1;
+	__HAL_TIM_SET_PRESCALER(&htim1, htim1.Init.Prescaler);
+}
+
+/*
+ * Set I2C for new PCLK1, fast mode falls back to standard mode when it can not run
+ *
+ * @return - CLOCKGOV_OK or CLOCKGOV_ERR_I2C
+ */
+static uint8_t ClockGov_UpdateI2C(void)
+{
+	uint32_t Speed = hi2c1.Init.ClockSpeed;
+
+	// FREQ, CCR and TRISE are computed from PCLK1 by init, DMA links stay
+	if (HAL_I2C_Init(&hi2c1) == HAL_OK)
+	{
+		return CLOCKGOV_OK;
+	}
+
+	if (Speed > I2CBUS_SPEED_STANDARD
+			&& I2CBus_SetSpeed(&hi2c1, I2CBUS_SPEED_STANDARD) == HAL_OK)
+	{
+		LOG_WARNING(LOG_MSG_I2C_SPEED, (unsigned long) I2CBUS_SPEED_STANDARD,
+				(unsigned long) Speed);
+		return CLOCKGOV_OK;
+	}
+
+	return CLOCKGOV_ERR_I2C;
+}
+
+/*
+ * Set all peripherals which depend on bus clocks
+ *
+ * @return - CLOCKGOV_OK or CLOCKGOV_ERR_I2C
+ */
+static uint8_t ClockGov_UpdatePeripherals(void)
+{
+	ClockGov_UpdateUart(&huart1);
+	ClockGov_UpdateUart(&huart2);
+	ClockGov_UpdateTimer();
+
+	return ClockGov_UpdateI2C();
+}
+
+/*
+ * AHB divider of idle level, PCLK1 has to stay high enough for I2C speed in use
+ *
+ * @return - RCC_SYSCLK_DIVx
+ */
+static uint32_t ClockGov_IdleDivider(void)
+{
+	uint32_t MinPclk = (hi2c1.Init.ClockSpeed > I2CBUS_SPEED_STANDARD) ?
+			CLOCKGOV_I2C_MIN_PCLK1_FM : CLOCKGOV_I2C_MIN_PCLK1_SM;
+	uint32_t Divider = CLOCKGOV_IDLE_AHB_DIVIDER;
+
+	while (Divider > 1 && (CLOCKGOV_HSI_FREQ / Divider) < MinPclk)
+	{
+		Divider /= 2;
+	}
+
+	switch (Divider)
+	{
+	case 8:
+		return RCC_SYSCLK_DIV8;
+	case 4:
+		return RCC_SYSCLK_DIV4;
+	case 2:
+		return RCC_SYSCLK_DIV2;
+	default:
+		return RCC_SYSCLK_DIV1;
+	}
+}
+
+/*
+ * Switch SYSCLK to PLL, 84 MHz
+ *
+ * @return - CLOCKGOV_OK or CLOCKGOV_ERR_RCC
+ */
+static uint8_t ClockGov_ConfigRun(void)
+{
+	RCC_OscInitTypeDef RCC_OscInitStruct = {0};
+	RCC_ClkInitTypeDef RCC_ClkInitStruct = {0};
+
+	RCC_OscInitStruct.OscillatorType = RCC_OSCILLATORTYPE_NONE;
+	RCC_OscInitStruct.PLL.PLLState = RCC_PLL_ON;
+	RCC_OscInitStruct.PLL.PLLSource = RCC_PLLSOURCE_HSI;
+	RCC_OscInitStruct.PLL.PLLM = CLOCKGOV_PLLM;
+	RCC_OscInitStruct.PLL.PLLN = CLOCKGOV_PLLN;
+	RCC_OscInitStruct.PLL.PLLP = CLOCKGOV_PLLP;
+	RCC_OscInitStruct.PLL.PLLQ = CLOCKGOV_PLLQ;
+	if (HAL_RCC_OscConfig(&RCC_OscInitStruct) != HAL_OK)
+	{
+		return CLOCKGOV_ERR_RCC;
+	}
+
+	RCC_ClkInitStruct.ClockType = RCC_CLOCKTYPE_HCLK | RCC_CLOCKTYPE_SYSCLK
+			| RCC_CLOCKTYPE_PCLK1 | RCC_CLOCKTYPE_PCLK2;
+	RCC_ClkInitStruct.SYSCLKSource = RCC_SYSCLKSOURCE_PLLCLK;
+	RCC_ClkInitStruct.AHBCLKDivider = RCC_SYSCLK_DIV1;
+	RCC_ClkInitStruct.APB1CLKDivider = RCC_HCLK_DIV2;
+	RCC_ClkInitStruct.APB2CLKDivider = RCC_HCLK_DIV1;
+	if (HAL_RCC_ClockConfig(&RCC_ClkInitStruct, FLASH_LATENCY_2) != HAL_OK)
+	{
+		return CLOCKGOV_ERR_RCC;
+	}
+
+	return CLOCKGOV_OK;
+}
+
+/*
+ * Switch SYSCLK to HSI and stop PLL
+ *
+ * @return - CLOCKGOV_OK or CLOCKGOV_ERR_RCC
+ */
+static uint8_t ClockGov_ConfigIdle(void)
+{
+	RCC_OscInitTypeDef RCC_OscInitStruct = {0};
+	RCC_ClkInitTypeDef RCC_ClkInitStruct = {0};
+
+	// 16 MHz and less - no flash wait states, APB buses undivided
+	RCC_ClkInitStruct.ClockType = RCC_CLOCKTYPE_HCLK | RCC_CLOCKTYPE_SYSCLK
+			| RCC_CLOCKTYPE_PCLK1 | RCC_CLOCKTYPE_PCLK2;
+	RCC_ClkInitStruct.SYSCLKSource = RCC_SYSCLKSOURCE_HSI;
+	RCC_ClkInitStruct.AHBCLKDivider = ClockGov_IdleDivider();
+	RCC_ClkInitStruct.APB1CLKDivider = RCC_HCLK_DIV1;
+	RCC_ClkInitStruct.APB2CLKDivider = RCC_HCLK_DIV1;
+	if (HAL_RCC_ClockConfig(&RCC_ClkInitStruct, FLASH_LATENCY_0) != HAL_OK)
+	{
+		return CLOCKGOV_ERR_RCC;
+	}
+
+	RCC_OscInitStruct.OscillatorType = RCC_OSCILLATORTYPE_NONE;
+	RCC_OscInitStruct.PLL.PLLState = RCC_PLL_OFF;
+	if (HAL_RCC_OscConfig(&RCC_OscInitStruct) != HAL_OK)
+	{
+		return CLOCKGOV_ERR_RCC;
+	}
+
+	return CLOCKGOV_OK;
+}
+
+/*
+ * Start residency tracking, clock is already set by SystemClock_Config
+ *
+ * @return - void
+ */
+void ClockGov_Init(void)
+{
+	ClockGov.Level = CLOCKGOV_LEVEL_RUN;
+	ClockGov.LevelStart = HAL_GetTick();
+	ClockGov.LastBusyTime = ClockGov.LevelStart;
+	ClockGov.Switches = 0;
+	for (uint8_t i = 0; i < CLOCKGOV_LEVELS; i++)
+	{
+		ClockGov.Residency[i] = 0;
+	}
+}
+
+/*
+ * Change clock level and set peripherals for new bus clocks
+ *
+ * @param[Level] - @level
+ * @return - @status
+ */
+uint8_t ClockGov_SetLevel(uint8_t Level)
+{
+	uint8_t Status;
+
+	if (Level >= CLOCKGOV_LEVELS || Level == ClockGov.Level)
+	{
+		return CLOCKGOV_OK;
+	}
+
+	// bit time of frame on the wire or I2C transfer would change in the middle
+	if (huart1.gState != HAL_UART_STATE_READY
+			|| huart2.gState != HAL_UART_STATE_READY
+			|| hi2c1.State != HAL_I2C_STATE_READY)
+	{
+		return CLOCKGOV_ERR_BUSY;
+	}
+
+	uint32_t Now = HAL_GetTick();
+	ClockGov.Residency[ClockGov.Level] += Now - ClockGov.LevelStart;
+
+	if (Level == CLOCKGOV_LEVEL_RUN)
+	{
+		Status = ClockGov_ConfigRun();
+	}
+	else
+	{
+		Status = ClockGov_ConfigIdle();
+	}
+
+	// RCC keeps old clock on error, peripherals are set for what really runs
+	if (ClockGov_UpdatePeripherals() != CLOCKGOV_OK && Status == CLOCKGOV_OK)
+	{
+		// I2C can not run on new clock, old level is set back
+		if (Level == CLOCKGOV_LEVEL_RUN)
+		{
+			ClockGov_ConfigIdle();
+		}
+		else
+		{
+			ClockGov_ConfigRun();
+		}
+		ClockGov_UpdatePeripherals();
+		Status = CLOCKGOV_ERR_I2C;
+	}
+
+	ClockGov.LevelStart = HAL_GetTick();
+	if (Status == CLOCKGOV_OK)
+	{
+		ClockGov.Level = Level;
+		ClockGov.Switches++;
+	}
+
+	return Status;
+}
+
+/*
+ * Put in main loop. Work switches to run level at once, idle level is set
+ * after CLOCKGOV_IDLE_TIME without work.
+ *
+ * @param[Busy] - 1 - commands, dump or replay waiting
+ * @return - void
+ */
+void ClockGov_Process(uint8_t Busy)
+{
+	if (Busy)
+	{
+		ClockGov.LastBusyTime = HAL_GetTick();
+		ClockGov_SetLevel(CLOCKGOV_LEVEL_RUN);
+	}
+	else if ((HAL_GetTick() - ClockGov.LastBusyTime) >= CLOCKGOV_IDLE_TIME)
+	{
+		ClockGov_SetLevel(CLOCKGOV_LEVEL_IDLE);
+	}
+}
+
+/*
+ * Current clock level
+ *
+ * @return - @level
+ */
+uint8_t ClockGov_GetLevel(void)
+{
+	return ClockGov.Level;
+}
+
+/*
+ * Time spent on clock level since boot
+ *
+ * @param[Level] - @level
+ * @return - ms
+ */
+uint32_t ClockGov_GetResidency(uint8_t Level)
+{
+	if (Level >= CLOCKGOV_LEVELS)
+	{
+		return 0;
+	}
+
+	if (Level == ClockGov.Level)
+	{
+		return ClockGov.Residency[Level] + (HAL_GetTick() - ClockGov.LevelStart);
+	}
+
+	return ClockGov.Residency[Level];
+}
+
+/*
+ * Number of clock level changes since boot
+ *
+ * @return - switches
+ */
+uint32_t ClockGov_GetSwitches(void)
+{
+	return ClockGov.Switches;
+}
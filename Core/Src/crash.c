@@ -0,0 +1,381 @@
+/*
+ * crash.c
+ *
+ *  Created on: 19 October 2026
+ */
+
+/* Fault capture and automatic recovery.
+ *
+ * Fault handlers take stacked frame (MSP or PSP, by EXC_RETURN), fault status
+ * registers and possible return addresses found on stack, store them in .noinit RAM
+ * and reset the MCU. They run on own stack, stack of faulting code may be full. Error_Handler does the same with address of its caller.
+ * Supervisor stores task which missed its deadline, reset is done by IWDG.
+ *
+ * On next boot Crash_Init moves the record out of .noinit, writes it to log (USART2)
+ * and main loop sends it over bluetooth when master is connected.
+ * Number of crashes is kept until power is lost.
+ */
+
+#include "main.h"
+#include "string.h"
+#include "log.h"
+#include "crash.h"
+
+// Symbols defined in the linker script
+extern uint8_t _estack;
+extern uint8_t _snoinit;
+extern uint8_t _enoinit;
+
+#define CRASH_STR(x)					#x
+#define CRASH_XSTR(x)					CRASH_STR(x)
+
+// used only by fault handlers, referenced from assembly
+uint64_t Crash_Stack[CRASH_STACK_SIZE / 8];
+
+static Crash_Record_t CrashRecord CRASH_NOINIT;
+static uint32_t CrashCount CRASH_NOINIT;
+static uint32_t CrashCountMagic CRASH_NOINIT;
+
+// record from before last reset
+static Crash_Record_t LastCrash;
+static uint8_t LastCrashValid;
+static uint8_t ReportPending;
+
+/*
+ * Sum of all record words except Check
+ *
+ * @param[*Record] - crash record
+ * @return - check value
+ */
+static uint32_t Crash_Check(Crash_Record_t *Record)
+{
+	uint32_t *Word = (uint32_t*) Record;
+	uint32_t Sum = 0;
+
+	while (Word < &Record->Check)
+	{
+		Sum += *Word++;
+	}
+
+	return Sum;
+}
+
+/*
+ * Search stack for code addresses, Thumb return addresses are odd
+ *
+ * @param[*Stack] - first word above exception frame
+ * @return - void
+ */
+static void Crash_Trace(uint32_t *Stack)
+{
+	uint32_t *StackEnd = (uint32_t*) &_estack;
+	uint32_t Word;
+	uint32_t i;
+
+	CrashRecord.TraceCount = 0;
+
+	for (i = 0; i < CRASH_TRACE_DEPTH && Stack < StackEnd; i++)
+	{
+		Word = *Stack++;
+		if ((Word & 1) && Word >= CRASH_CODE_START && Word < CRASH_CODE_END)
+		{
+			CrashRecord.Trace[CrashRecord.TraceCount++] = Word & ~1UL;
+			if (CrashRecord.TraceCount == CRASH_TRACE_SIZE)
+			{
+				break;
+			}
+		}
+	}
+}
+
+/*
+ * Finish record, it is valid from now
+ *
+ * @return - void
+ */
+static void Crash_Finish(void)
+{
+	CrashRecord.Uptime = HAL_GetTick();
+	CrashRecord.CFSR = SCB->CFSR;
+	CrashRecord.HFSR = SCB->HFSR;
+	CrashRecord.MMFAR = SCB->MMFAR;
+	CrashRecord.BFAR = SCB->BFAR;
+	CrashRecord.Magic = CRASH_MAGIC;
+	CrashRecord.Check = Crash_Check(&CrashRecord);
+
+	CrashCount++;
+}
+
+/*
+ * Called by fault handlers with stacked frame, runs on Crash_Stack
+ *
+ * @param[*Frame] - R0, R1, R2, R3, R12, LR, PC, PSR stacked on exception entry
+ * @param[ExcReturn] - LR at exception entry
+ * @param[Type] - @type
+ * @return - void
+ */
+void Crash_Handler(uint32_t *Frame, uint32_t ExcReturn, uint32_t Type)
+{
+	uint32_t *Stack;
+
+	memset(&CrashRecord, 0, sizeof(CrashRecord));
+	CrashRecord.Type = Type;
+	CrashRecord.ExcReturn = ExcReturn;
+	CrashRecord.Task = CRASH_NO_TASK;
+
+	// stack overflowed out of RAM, frame was not stacked
+	if ((uint32_t) Frame < CRASH_RAM_START || Frame + 8 > (uint32_t*) &_estack)
+	{
+		Crash_Finish();
+		NVIC_SystemReset();
+	}
+
+	CrashRecord.R0 = Frame[0];
+	CrashRecord.R1 = Frame[1];
+	CrashRecord.R2 = Frame[2];
+	CrashRecord.R3 = Frame[3];
+	CrashRecord.R12 = Frame[4];
+	CrashRecord.LR = Frame[5];
+	CrashRecord.PC = Frame[6];
+	CrashRecord.PSR = Frame[7];
+
+	// frame with FPU registers has 26 words, bit 4 of EXC_RETURN is cleared
+	Stack = Frame + (((ExcReturn & 0x10) == 0) ? 26 : 8);
+	// one word was added on entry to align stack to 8 bytes
+	if (CrashRecord.PSR & (1UL << 9))
+	{
+		Stack++;
+	}
+	Crash_Trace(Stack);
+
+	Crash_Finish();
+	NVIC_SystemReset();
+}
+
+/*
+ * Called by Error_Handler, there is no exception frame
+ *
+ * @param[Caller] - address Error_Handler returns to
+ * @return - void
+ */
+void Crash_Error(uint32_t Caller)
+{
+	__disable_irq();
+
+	memset(&CrashRecord, 0, sizeof(CrashRecord));
+	CrashRecord.Type = CRASH_TYPE_ERROR;
+	CrashRecord.PC = Caller;
+	CrashRecord.Task = CRASH_NO_TASK;
+	Crash_Trace((uint32_t*) __get_MSP());
+
+	Crash_Finish();
+	NVIC_SystemReset();
+}
+
+/*
+ * Called by supervisor from tick interrupt, IWDG resets MCU later.
+ * Stack of interrupted code is in trace, it shows where main loop was stuck.
+ *
+ * @param[Task] - task which missed its deadline
+ * @return - void
+ */
+void Crash_Watchdog(uint32_t Task)
+{
+	memset(&CrashRecord, 0, sizeof(CrashRecord));
+	CrashRecord.Type = CRASH_TYPE_WATCHDOG;
+	CrashRecord.Task = Task;
+	Crash_Trace((uint32_t*) __get_MSP());
+
+	Crash_Finish();
+}
+
+/*
+ * Take record of crash before reset, call once at boot after log is ready.
+ * Bus, memory and usage faults get their own handlers instead of hard fault.
+ *
+ * @return - void
+ */
+void Crash_Init(void)
+{
+	SCB->SHCSR |= SCB_SHCSR_USGFAULTENA_Msk | SCB_SHCSR_BUSFAULTENA_Msk
+			| SCB_SHCSR_MEMFAULTENA_Msk;
+
+	// after power on .noinit is random
+	if (CrashCountMagic != CRASH_MAGIC)
+	{
+		memset(&_snoinit, 0, &_enoinit - &_snoinit);
+		CrashCountMagic = CRASH_MAGIC;
+	}
+
+	uint8_t WatchdogReset = (__HAL_RCC_GET_FLAG(RCC_FLAG_IWDGRST) != 0);
+	__HAL_RCC_CLEAR_RESET_FLAGS();
+
+	if (CrashRecord.Magic == CRASH_MAGIC
+			&& CrashRecord.Check == Crash_Check(&CrashRecord))
+	{
+		LastCrash = CrashRecord;
+	}
+	else if (WatchdogReset)
+	{
+		// watchdog expired without record, interrupts were blocked
+		memset(&LastCrash, 0, sizeof(LastCrash));
+		LastCrash.Type = CRASH_TYPE_WATCHDOG;
+		LastCrash.Task = CRASH_NO_TASK;
+		CrashCount++;
+	}
+	else
+	{
+		return;
+	}
+
+	LastCrashValid = 1;
+	ReportPending = 1;
+
+	// report every crash only once
+	CrashRecord.Magic = 0;
+
+	LOG_ERROR(LOG_MSG_CRASH, (unsigned long) LastCrash.Type,
+			(unsigned long) LastCrash.PC, (unsigned long) LastCrash.LR);
+	if (LastCrash.Type == CRASH_TYPE_WATCHDOG)
+	{
+		LOG_ERROR(LOG_MSG_CRASH_TASK, (unsigned long) LastCrash.Task);
+	}
+	LOG_ERROR(LOG_MSG_CRASH_STATUS, (unsigned long) LastCrash.CFSR,
+			(unsigned long) LastCrash.HFSR, (unsigned long) LastCrash.BFAR);
+	if (LastCrash.TraceCount > 0)
+	{
+		LOG_ERROR(LOG_MSG_CRASH_TRACE, (unsigned long) LastCrash.Trace[0],
+				(unsigned long) LastCrash.Trace[1], (unsigned long) LastCrash.Trace[2]);
+	}
+}
+
+/*
+ * Record of crash before last reset
+ *
+ * @param[*Record] - record to fill
+ * @return - 1 if there was a crash
+ */
+uint8_t Crash_GetLast(Crash_Record_t *Record)
+{
+	if (LastCrashValid)
+	{
+		*Record = LastCrash;
+	}
+
+	return LastCrashValid;
+}
+
+/*
+ * Number of crashes since power on
+ *
+ * @return - crashes
+ */
+uint32_t Crash_GetCount(void)
+{
+	return CrashCount;
+}
+
+/*
+ * Crash record was not sent over bluetooth yet
+ *
+ * @return - 1 if it waits
+ */
+uint8_t Crash_IsReportPending(void)
+{
+	return ReportPending;
+}
+
+/*
+ * Crash record was sent over bluetooth
+ *
+ * @return - void
+ */
+void Crash_ClearReportPending(void)
+{
+	ReportPending = 0;
+}
+
+/*
+ * Name of crash type
+ *
+ * @param[Type] - @type
+ * @return - name
+ */
+const char *Crash_TypeName(uint32_t Type)
+{
+	switch (Type)
+	{
+	case CRASH_TYPE_HARDFAULT:
+		return "HARDFAULT";
+
+	case CRASH_TYPE_MEMMANAGE:
+		return "MEMMANAGE";
+
+	case CRASH_TYPE_BUSFAULT:
+		return "BUSFAULT";
+
+	case CRASH_TYPE_USAGEFAULT:
+		return "USAGEFAULT";
+
+	case CRASH_TYPE_ERROR:
+		return "ERROR";
+
+	case CRASH_TYPE_WATCHDOG:
+		return "WATCHDOG";
+	}
+
+	return "NONE";
+}
+
+/*
+ * Common part of fault handlers, type is in R2. Frame pointer is taken before
+ * anything is pushed, then MSP is moved to Crash_Stack.
+ */
+__attribute__((naked, used)) static void Crash_Fault(void)
+{
+	__asm volatile(
+			"tst lr, #4\n"
+			"ite eq\n"
+			"mrseq r0, msp\n"
+			"mrsne r0, psp\n"
+			"mov r1, lr\n"
+			"ldr r3, =Crash_Stack + " CRASH_XSTR(CRASH_STACK_SIZE) "\n"
+			"mov sp, r3\n"
+			"b Crash_Handler\n"
+			".ltorg\n");
+}
+
+/*
+ * Called from generated fault handlers, which have no prologue
+ */
+__attribute__((naked)) void Crash_HardFault(void)
+{
+	__asm volatile(
+			"mov r2, %0\n"
+			"b Crash_Fault\n"
+			:: "i" (CRASH_TYPE_HARDFAULT));
+}
+
+__attribute__((naked)) void Crash_MemManage(void)
+{
+	__asm volatile(
+			"mov r2, %0\n"
+			"b Crash_Fault\n"
+			:: "i" (CRASH_TYPE_MEMMANAGE));
+}
+
+__attribute__((naked)) void Crash_BusFault(void)
+{
+	__asm volatile(
+			"mov r2, %0\n"
+			"b Crash_Fault\n"
+			:: "i" (CRASH_TYPE_BUSFAULT));
+}
+
+__attribute__((naked)) void Crash_UsageFault(void)
+{
+	__asm volatile(
+			"mov r2, %0\n"
+			"b Crash_Fault\n"
+			:: "i" (CRASH_TYPE_USAGEFAULT));
+}
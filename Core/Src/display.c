@@ -0,0 +1,429 @@
+/*
+ * display.c
+ *
+ *  Created on: 19 October 2026
+ */
+
+/* Segment display independent of its driver.
+ *
+ * Values are rendered to frame of segments by pure functions (no hardware, they can be
+ * run on host), frame is written by backend of the display. Last rendered value is
+ * cached, so the same value is not rendered again, and frame equal to the one on
+ * display is not written again - bit-banged TM1637 takes tens of ms for one frame.
+ *
+ * New segment driver needs only its Display_Backend_t.
+ */
+
+#include "string.h"
+#include "display.h"
+
+static const uint8_t Display_SegmentMap[] = {
+	0x3f, 0x06, 0x5b, 0x4f, 0x66, 0x6d, 0x7d, 0x07,	// 0-7			[0-7]
+	0x7f, 0x6f, 0x77, 0x7c, 0x39, 0x5e, 0x79, 0x71,	// 8-9, A-F		[8-15]
+	0x40, 0x50, 0x00								// -,r,NULL		[16-18]
+};
+
+// Letters A-Z, the ones which can not be shown are closest shape
+static const uint8_t Display_LetterMap[] = {
+	0x77, 0x7c, 0x39, 0x5e, 0x79, 0x71, 0x3d, 0x76,	// A-H
+	0x30, 0x1e, 0x76, 0x38, 0x37, 0x54, 0x3f, 0x73,	// I-P
+	0x67, 0x50, 0x6d, 0x78, 0x3e, 0x3e, 0x2a, 0x76,	// Q-X
+	0x6e, 0x5b										// Y-Z
+};
+
+#define DISPLAY_SEG_E					0x79
+#define DISPLAY_SEG_R					0x50
+
+/*
+ * Digits of backend which fit to frame
+ */
+static uint8_t Display_Digits(Display_t *Display)
+{
+	if (Display->Backend->Digits > DISPLAY_MAX_DIGITS)
+	{
+		return DISPLAY_MAX_DIGITS;
+	}
+
+	return Display->Backend->Digits;
+}
+
+/*
+ * Write frame only when it differs from the one on display
+ */
+static void Display_Write(Display_t *Display, const uint8_t *Frame)
+{
+	uint8_t Digits = Display_Digits(Display);
+
+	if (Display->FrameValid && memcmp(Display->Frame, Frame, Digits) == 0)
+	{
+		return;
+	}
+
+	memcpy(Display->Frame, Frame, Digits);
+	Display->FrameValid = 1;
+	Display->Writes++;
+	Display->Backend->WriteFrame(Display->Frame, Digits);
+}
+
+/*
+ * Render Err aligned to the right
+ *
+ * @param[Digits] - digits of display
+ * @param[*Frame] - frame of Digits segments, left digit first
+ * @return - void
+ */
+void Display_RenderError(uint8_t Digits, uint8_t *Frame)
+{
+	memset(Frame, DISPLAY_SEG_BLANK, Digits);
+	if (Digits < 3)
+	{
+		memset(Frame, DISPLAY_SEG_MINUS, Digits);
+		return;
+	}
+
+	Frame[Digits - 3] = DISPLAY_SEG_E;
+	Frame[Digits - 2] = DISPLAY_SEG_R;
+	Frame[Digits - 1] = DISPLAY_SEG_R;
+}
+
+/*
+ * Render fixed point value with as many decimals as fit (at most DISPLAY_FLOAT_DECIMALS)
+ * For negative values minus takes one digit, leading zeros are blank,
+ * decimals which do not fit are rounded half away from zero
+ *
+ * @param[Value] - value in 1/DISPLAY_FLOAT_SCALE
+ * @param[Digits] - digits of display
+ * @param[*Frame] - frame of Digits segments, left digit first
+ * @return - @render
+ */
+uint8_t Display_RenderFixed(int32_t Value, uint8_t Digits, uint8_t *Frame)
+{
+	uint8_t Negative = (Value < 0);
+	uint32_t Magnitude = Negative ? -(uint32_t) Value : (uint32_t) Value;
+	uint32_t Abs = Magnitude;
+	uint32_t Divider = 1;
+	uint32_t Integer;
+	uint8_t IntegerDigits;
+	uint8_t Decimals = DISPLAY_FLOAT_DECIMALS;
+	int8_t Position;
+	uint8_t i;
+
+	// drop decimals until the rounded value fits, rounding can add integer digit
+	while (1)
+	{
+		Abs = Magnitude / Divider + ((Magnitude % Divider) >= (Divider + 1) / 2 ? 1 : 0);
+		// value rounded to zero has no sign
+		if (Abs == 0)
+		{
+			Negative = 0;
+		}
+
+		Integer = Abs;
+		for (i = 0; i < Decimals; i++)
+		{
+			Integer /= 10;
+		}
+		IntegerDigits = 1;
+		while (Integer > 9)
+		{
+			Integer /= 10;
+			IntegerDigits++;
+		}
+
+		if (Negative + IntegerDigits + Decimals <= Digits)
+		{
+			break;
+		}
+		if (Decimals == 0)
+		{
+			Display_RenderError(Digits, Frame);
+			return DISPLAY_ERR_RANGE;
+		}
+		Decimals--;
+		Divider *= 10;
+	}
+
+	memset(Frame, DISPLAY_SEG_BLANK, Digits);
+
+	// from the right, at least all decimals and units
+	Position = Digits - 1;
+	for (i = 0; i <= Decimals || Abs > 0; i++)
+	{
+		Frame[Position] = Display_SegmentMap[Abs % 10];
+		if (Decimals > 0 && i == Decimals)
+		{
+			Frame[Position] |= DISPLAY_SEG_SEPARATOR;
+		}
+		Abs /= 10;
+		Position--;
+	}
+
+	// minus right before the number
+	if (Negative)
+	{
+		Frame[Position] = DISPLAY_SEG_MINUS;
+	}
+
+	return DISPLAY_OK;
+}
+
+/*
+ * Segments of one character, lower case differs only where it has its own shape
+ */
+static uint8_t Display_CharSegments(char Char)
+{
+	switch (Char)
+	{
+	case 'c': return 0x58;
+	case 'h': return 0x74;
+	case 'i': return 0x10;
+	case 'o': return 0x5c;
+	case 'u': return 0x1c;
+	case '-': return DISPLAY_SEG_MINUS;
+	case '_': return 0x08;
+	default: break;
+	}
+
+	if (Char >= '0' && Char <= '9')
+	{
+		return Display_SegmentMap[Char - '0'];
+	}
+	if (Char >= 'a' && Char <= 'z')
+	{
+		Char -= 'a' - 'A';
+	}
+	if (Char >= 'A' && Char <= 'Z')
+	{
+		return Display_LetterMap[Char - 'A'];
+	}
+
+	return DISPLAY_SEG_BLANK;
+}
+
+/*
+ * Render text aligned to the left, '.' lights separator of previous character,
+ * characters which do not fit are cut
+ *
+ * @param[*Text] - text to render
+ * @param[Digits] - digits of display
+ * @param[*Frame] - frame of Digits segments, left digit first
+ * @return - void
+ */
+void Display_RenderText(const char *Text, uint8_t Digits, uint8_t *Frame)
+{
+	uint8_t Position = 0;
+
+	memset(Frame, DISPLAY_SEG_BLANK, Digits);
+
+	for (; *Text != 0; Text++)
+	{
+		if (*Text == '.' && Position > 0)
+		{
+			Frame[Position - 1] |= DISPLAY_SEG_SEPARATOR;
+			continue;
+		}
+		if (Position == Digits)
+		{
+			break;
+		}
+		Frame[Position++] = Display_CharSegments(*Text);
+	}
+}
+
+/*
+ * Render decimal number on all digits with leading zeros (clock, counter)
+ *
+ * @param[Value] - value, only positive
+ * @param[Separator] - digit from right with separator or DISPLAY_NO_SEPARATOR
+ * @param[Digits] - digits of display
+ * @param[*Frame] - frame of Digits segments, left digit first
+ * @return - @render
+ */
+uint8_t Display_RenderDecimal(int32_t Value, uint8_t Separator, uint8_t Digits, uint8_t *Frame)
+{
+	uint8_t i;
+
+	if (Value < 0)
+	{
+		Display_RenderError(Digits, Frame);
+		return DISPLAY_ERR_RANGE;
+	}
+
+	for (i = 0; i < Digits; i++)
+	{
+		Frame[Digits - 1 - i] = Display_SegmentMap[Value % 10];
+		if (i == Separator)
+		{
+			Frame[Digits - 1 - i] |= DISPLAY_SEG_SEPARATOR;
+		}
+		Value /= 10;
+	}
+
+	if (Value > 0)
+	{
+		Display_RenderError(Digits, Frame);
+		return DISPLAY_ERR_RANGE;
+	}
+
+	return DISPLAY_OK;
+}
+
+/*
+ * Bind display to backend and initialize it
+ *
+ * @param[*Display] - display structure
+ * @param[*Backend] - segment driver
+ * @return - void
+ */
+void Display_Init(Display_t *Display, const Display_Backend_t *Backend)
+{
+	memset(Display, 0, sizeof(Display_t));
+	Display->Backend = Backend;
+
+	Backend->Init();
+}
+
+/*
+ * Show float value, out of DISPLAY_FLOAT_MIN - DISPLAY_FLOAT_MAX range it shows Err
+ *
+ * @param[*Display] - display structure
+ * @param[Value] - value to show
+ * @return - @render
+ */
+uint8_t Display_ShowFloat(Display_t *Display, float Value)
+{
+	uint8_t Frame[DISPLAY_MAX_DIGITS];
+	uint8_t Status;
+	int32_t Fixed;
+
+	// NaN fails both comparisons
+	if (!(Value >= DISPLAY_FLOAT_MIN && Value <= DISPLAY_FLOAT_MAX))
+	{
+		Fixed = INT32_MIN;
+	}
+	else
+	{
+		// half away from zero, cast alone cuts toward zero
+		Fixed = (int32_t) (Value * DISPLAY_FLOAT_SCALE + ((Value < 0) ? -0.5f : 0.5f));
+	}
+
+	// rendered from hundredths, so the same hundredths give the same frame
+	if (Display->CacheKind == DISPLAY_CACHE_FLOAT && Display->CacheValue == Fixed)
+	{
+		return Display->CacheStatus;
+	}
+
+	Display->Renders++;
+	if (Fixed == INT32_MIN)
+	{
+		Display_RenderError(Display_Digits(Display), Frame);
+		Status = DISPLAY_ERR_RANGE;
+	}
+	else
+	{
+		Status = Display_RenderFixed(Fixed, Display_Digits(Display), Frame);
+	}
+
+	Display->CacheKind = DISPLAY_CACHE_FLOAT;
+	Display->CacheValue = Fixed;
+	Display->CacheStatus = Status;
+	Display_Write(Display, Frame);
+
+	return Status;
+}
+
+/*
+ * Show decimal number with leading zeros
+ *
+ * @param[*Display] - display structure
+ * @param[Value] - value, only positive
+ * @param[Separator] - digit from right with separator or DISPLAY_NO_SEPARATOR
+ * @return - @render
+ */
+uint8_t Display_ShowDecimal(Display_t *Display, int32_t Value, uint8_t Separator)
+{
+	uint8_t Frame[DISPLAY_MAX_DIGITS];
+	uint8_t Status;
+
+	if (Display->CacheKind == DISPLAY_CACHE_DECIMAL && Display->CacheValue == Value
+			&& Display->CacheOption == Separator)
+	{
+		return Display->CacheStatus;
+	}
+
+	Display->Renders++;
+	Status = Display_RenderDecimal(Value, Separator, Display_Digits(Display), Frame);
+
+	Display->CacheKind = DISPLAY_CACHE_DECIMAL;
+	Display->CacheValue = Value;
+	Display->CacheOption = Separator;
+	Display->CacheStatus = Status;
+	Display_Write(Display, Frame);
+
+	return Status;
+}
+
+/*
+ * Show frame rendered by caller
+ *
+ * @param[*Display] - display structure
+ * @param[*Frame] - frame of backend digits, left digit first
+ * @return - void
+ */
+void Display_ShowFrame(Display_t *Display, const uint8_t *Frame)
+{
+	Display->CacheKind = DISPLAY_CACHE_NONE;
+	Display_Write(Display, Frame);
+}
+
+/*
+ * Show text, only characters which look well on 7 segments
+ *
+ * @param[*Display] - display structure
+ * @param[*Text] - text aligned to the left
+ * @return - void
+ */
+void Display_ShowText(Display_t *Display, const char *Text)
+{
+	uint8_t Frame[DISPLAY_MAX_DIGITS];
+
+	Display_RenderText(Text, Display_Digits(Display), Frame);
+	Display_ShowFrame(Display, Frame);
+}
+
+/*
+ * Turn all segments off, display stays on
+ *
+ * @param[*Display] - display structure
+ * @return - void
+ */
+void Display_Clear(Display_t *Display)
+{
+	uint8_t Frame[DISPLAY_MAX_DIGITS] = { DISPLAY_SEG_BLANK };
+
+	Display_ShowFrame(Display, Frame);
+}
+
+/*
+ * Set brightness of display
+ *
+ * @param[*Display] - display structure
+ * @param[Brightness] - 0 - off, 1-8
+ * @return - void
+ */
+void Display_SetBrightness(Display_t *Display, uint8_t Brightness)
+{
+	Display->Backend->SetBrightness(Brightness);
+}
+
+/*
+ * Forget frame on display, e.g. after power of display was off, next value is written
+ *
+ * @param[*Display] - display structure
+ * @return - void
+ */
+void Display_Invalidate(Display_t *Display)
+{
+	Display->CacheKind = DISPLAY_CACHE_NONE;
+	Display->FrameValid = 0;
+}
@@ -0,0 +1,345 @@
+/*
+ * encode.c
+ *
+ *  Created on: 19 October 2026
+ */
+
+/* Compact encoding of temperature history.
+ * Consecutive samples differ by a few LSB, so every sample is stored as difference
+ * to previous one. Differences are zigzag mapped (0,-1,1,-2.. -> 0,1,2,3..) and written
+ * as varints, 7 bits per byte, MSB set when more bytes follow.
+ *
+ * Batch format :
+ * [count][first timestamp][first value] then for every next sample [dt][dvalue]
+ * count, timestamps and dt are varints, values and dvalue zigzag varints.
+ * Samples have to be ordered from oldest, timestamps in ms.
+ *
+ * Batch goes over text link as base64 (RFC 4648 alphabet, '=' padding), 4 characters
+ * for 3 bytes instead of 6 characters of hex.
+ *
+ * File does not use HAL, so the same decoder can be built for the receiving side
+ * (Tests/history_decode.c).
+ */
+
+#include "encode.h"
+
+/*
+ * Write unsigned varint
+ *
+ * @param[Value] - value to write
+ * @param[*Buffer] - place for at least ENCODE_MAX_VARINT_SIZE bytes
+ * @return - number of bytes written
+ */
+uint16_t Encode_Varint(uint32_t Value, uint8_t *Buffer)
+{
+	uint16_t i = 0;
+
+	while (Value >= 0x80)
+	{
+		Buffer[i++] = (uint8_t) (Value | 0x80);
+		Value >>= 7;
+	}
+	Buffer[i++] = (uint8_t) Value;
+
+	return i;
+}
+
+/*
+ * Write signed value as zigzag varint, small negative numbers stay short
+ *
+ * @param[Value] - value to write
+ * @param[*Buffer] - place for at least ENCODE_MAX_VARINT_SIZE bytes
+ * @return - number of bytes written
+ */
+uint16_t Encode_ZigZagVarint(int32_t Value, uint8_t *Buffer)
+{
+	return Encode_Varint(((uint32_t) Value << 1) ^ (uint32_t) (Value >> 31),
+			Buffer);
+}
+
+/*
+ * Read unsigned varint
+ *
+ * @param[*Buffer] - encoded data
+ * @param[Lenght] - bytes left in buffer
+ * @param[*Value] - decoded value
+ * @return - number of bytes read, 0 if varint is broken
+ */
+uint16_t Decode_Varint(const uint8_t *Buffer, uint16_t Lenght, uint32_t *Value)
+{
+	uint16_t i;
+	uint32_t Result = 0;
+
+	for (i = 0; i < Lenght && i < ENCODE_MAX_VARINT_SIZE; i++)
+	{
+		Result |= (uint32_t) (Buffer[i] & 0x7F) << (7 * i);
+
+		if ((Buffer[i] & 0x80) == 0)
+		{
+			*Value = Result;
+			return i + 1;
+		}
+	}
+
+	return 0;
+}
+
+/*
+ * Read zigzag varint
+ *
+ * @param[*Buffer] - encoded data
+ * @param[Lenght] - bytes left in buffer
+ * @param[*Value] - decoded value
+ * @return - number of bytes read, 0 if varint is broken
+ */
+uint16_t Decode_ZigZagVarint(const uint8_t *Buffer, uint16_t Lenght, int32_t *Value)
+{
+	uint32_t Raw;
+	uint16_t Size;
+
+	Size = Decode_Varint(Buffer, Lenght, &Raw);
+	if (Size != 0)
+	{
+		*Value = (int32_t) (Raw >> 1) ^ -(int32_t) (Raw & 1);
+	}
+
+	return Size;
+}
+
+/*
+ * Encode samples as deltas
+ *
+ * @param[*Values] - temperatures in LSB, oldest first
+ * @param[*Timestamps] - conversion ticks in ms, oldest first
+ * @param[Count] - number of samples
+ * @param[*Buffer] - output buffer
+ * @param[BufferSize] - size of output buffer, ENCODE_BATCH_SIZE(Count) is always enough
+ * @return - number of bytes written, 0 if buffer is too small
+ */
+uint16_t Encode_DeltaBatch(const int16_t *Values, const uint32_t *Timestamps,
+		uint8_t Count, uint8_t *Buffer, uint16_t BufferSize)
+{
+	uint8_t Varint[ENCODE_MAX_VARINT_SIZE];
+	uint16_t Lenght = 0;
+	uint16_t Size;
+	uint8_t i;
+	uint8_t Field;
+	int32_t Delta;
+
+	Size = Encode_Varint(Count, Varint);
+	if (Size > BufferSize)
+	{
+		return 0;
+	}
+	for (Field = 0; Field < Size; Field++)
+	{
+		Buffer[Lenght++] = Varint[Field];
+	}
+
+	for (i = 0; i < Count; i++)
+	{
+		// timestamp, first one absolute
+		Size = Encode_Varint(
+				(i == 0) ? Timestamps[0] : (Timestamps[i] - Timestamps[i - 1]),
+				Varint);
+		if (Lenght + Size > BufferSize)
+		{
+			return 0;
+		}
+		for (Field = 0; Field < Size; Field++)
+		{
+			Buffer[Lenght++] = Varint[Field];
+		}
+
+		// value, first one absolute
+		Delta = (i == 0) ? Values[0] : ((int32_t) Values[i] - Values[i - 1]);
+		Size = Encode_ZigZagVarint(Delta, Varint);
+		if (Lenght + Size > BufferSize)
+		{
+			return 0;
+		}
+		for (Field = 0; Field < Size; Field++)
+		{
+			Buffer[Lenght++] = Varint[Field];
+		}
+	}
+
+	return Lenght;
+}
+
+/*
+ * Decode batch made by Encode_DeltaBatch
+ *
+ * @param[*Buffer] - encoded data
+ * @param[Lenght] - size of encoded data
+ * @param[*Values] - decoded temperatures in LSB
+ * @param[*Timestamps] - decoded ticks in ms
+ * @param[MaxCount] - size of output arrays
+ * @return - number of samples decoded, 0 if data is broken or does not fit
+ */
+uint8_t Decode_DeltaBatch(const uint8_t *Buffer, uint16_t Lenght,
+		int16_t *Values, uint32_t *Timestamps, uint8_t MaxCount)
+{
+	uint32_t Count;
+	uint32_t Time;
+	int32_t Delta;
+	uint16_t Position;
+	uint16_t Size;
+	uint8_t i;
+
+	Position = Decode_Varint(Buffer, Lenght, &Count);
+	if (Position == 0 || Count > MaxCount)
+	{
+		return 0;
+	}
+
+	for (i = 0; i < Count; i++)
+	{
+		Size = Decode_Varint(&Buffer[Position], Lenght - Position, &Time);
+		if (Size == 0)
+		{
+			return 0;
+		}
+		Position += Size;
+		Timestamps[i] = (i == 0) ? Time : (Timestamps[i - 1] + Time);
+
+		Size = Decode_ZigZagVarint(&Buffer[Position], Lenght - Position, &Delta);
+		if (Size == 0)
+		{
+			return 0;
+		}
+		Position += Size;
+		Values[i] = (i == 0) ? (int16_t) Delta : (int16_t) (Values[i - 1] + Delta);
+	}
+
+	return (uint8_t) Count;
+}
+
+static const char Base64_Alphabet[] =
+		"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+/*
+ * Write bytes as base64 text, with padding
+ *
+ * @param[*Data] - bytes to write
+ * @param[Lenght] - number of bytes
+ * @param[*Text] - place for ENCODE_BASE64_SIZE(Lenght) characters, 0 is not added
+ * @return - number of characters written
+ */
+uint16_t Encode_Base64(const uint8_t *Data, uint16_t Lenght, char *Text)
+{
+	uint16_t i;
+	uint16_t Size = 0;
+	uint32_t Group;
+
+	for (i = 0; i < Lenght; i += 3)
+	{
+		Group = (uint32_t) Data[i] << 16;
+		if (i + 1 < Lenght)
+		{
+			Group |= (uint32_t) Data[i + 1] << 8;
+		}
+		if (i + 2 < Lenght)
+		{
+			Group |= Data[i + 2];
+		}
+
+		Text[Size++] = Base64_Alphabet[(Group >> 18) & 0x3F];
+		Text[Size++] = Base64_Alphabet[(Group >> 12) & 0x3F];
+		Text[Size++] = (i + 1 < Lenght) ? Base64_Alphabet[(Group >> 6) & 0x3F] : '=';
+		Text[Size++] = (i + 2 < Lenght) ? Base64_Alphabet[Group & 0x3F] : '=';
+	}
+
+	return Size;
+}
+
+/*
+ * @return - value of base64 character, -1 if it is not one
+ */
+static int8_t Base64_Value(char Char)
+{
+	if (Char >= 'A' && Char <= 'Z')
+	{
+		return Char - 'A';
+	}
+	if (Char >= 'a' && Char <= 'z')
+	{
+		return Char - 'a' + 26;
+	}
+	if (Char >= '0' && Char <= '9')
+	{
+		return Char - '0' + 52;
+	}
+	if (Char == '+')
+	{
+		return 62;
+	}
+	if (Char == '/')
+	{
+		return 63;
+	}
+
+	return -1;
+}
+
+/*
+ * Read base64 text made by Encode_Base64
+ *
+ * @param[*Text] - base64 characters
+ * @param[Lenght] - number of characters, multiple of 4
+ * @param[*Data] - decoded bytes
+ * @param[MaxSize] - size of Data
+ * @return - number of bytes, 0 if text is broken or does not fit
+ */
+uint16_t Decode_Base64(const char *Text, uint16_t Lenght, uint8_t *Data, uint16_t MaxSize)
+{
+	uint16_t i;
+	uint16_t Size = 0;
+	uint32_t Group;
+	uint8_t Pad;
+	uint8_t j;
+	int8_t Value;
+
+	if (Lenght % 4 != 0)
+	{
+		return 0;
+	}
+
+	for (i = 0; i < Lenght; i += 4)
+	{
+		Group = 0;
+		Pad = 0;
+		for (j = 0; j < 4; j++)
+		{
+			// padding only in the last two places of the last group
+			if (Text[i + j] == '=' && i + 4 == Lenght && j >= 2)
+			{
+				Pad++;
+				Group <<= 6;
+				continue;
+			}
+			Value = Base64_Value(Text[i + j]);
+			if (Value < 0 || Pad != 0)
+			{
+				return 0;
+			}
+			Group = (Group << 6) | (uint32_t) Value;
+		}
+
+		if (Size + 3 - Pad > MaxSize)
+		{
+			return 0;
+		}
+		Data[Size++] = (uint8_t) (Group >> 16);
+		if (Pad < 2)
+		{
+			Data[Size++] = (uint8_t) (Group >> 8);
+		}
+		if (Pad < 1)
+		{
+			Data[Size++] = (uint8_t) Group;
+		}
+	}
+
+	return Size;
+}
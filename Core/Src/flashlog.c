@@ -0,0 +1,491 @@
+/*
+ * flashlog.c
+ *
+ *  Created on: 19 October 2026
+ */
+
+/* Append-only log of samples in reserved flash sectors.
+ *
+ * Sectors are used round-robin. When active sector is full, the oldest one is erased,
+ * gets header with next sequence number and becomes active, so all sectors are erased
+ * equally often. Inside a sector records are only appended, free slots are always at
+ * the end, so tail is found on boot by binary search instead of reading whole sector.
+ *
+ * Flash can only clear bits, erase sets whole sector to 0xFF. Erase of 128 KB sector
+ * takes 1-2 s, it is started by FlashLog_Append FLASHLOG_ERASE_AHEAD slots before the
+ * active sector is full and runs in background, FLASH interrupt reports its end.
+ * Header of erased sector is written by Append which needs it. F401 has single bank,
+ * code fetch from flash still stalls while erase runs, supervisor is held meanwhile.
+ *
+ * Put FlashLog_EraseCpltCallback in HAL_FLASH_EndOfOperationCallback and
+ * FlashLog_EraseErrorCallback in HAL_FLASH_OperationErrorCallback, FLASH_IRQHandler
+ * has to call HAL_FLASH_IRQHandler.
+ */
+
+#include "main.h"
+#include "string.h"
+#include "flashlog.h"
+#include "supervisor.h"
+
+static FlashLog_t FlashLog;
+
+/*
+ * Start address of sector
+ *
+ * @param[Sector] - sector index in the log
+ * @return - address
+ */
+static uint32_t FlashLog_SectorAddress(uint8_t Sector)
+{
+	return FLASHLOG_FIRST_ADDRESS + (Sector * FLASHLOG_SECTOR_SIZE);
+}
+
+/*
+ * Address of record slot
+ *
+ * @param[Sector] - sector index in the log
+ * @param[Slot] - record number in sector
+ * @return - address
+ */
+static FlashLog_Record_t* FlashLog_Slot(uint8_t Sector, uint32_t Slot)
+{
+	// slot 0 is taken by header
+	return (FlashLog_Record_t*) (FlashLog_SectorAddress(Sector)
+			+ ((Slot + 1) * sizeof(FlashLog_Record_t)));
+}
+
+/*
+ * Check if slot was never programmed
+ *
+ * @param[Sector] - sector index in the log
+ * @param[Slot] - record number in sector
+ * @return - 1 erased, 0 used
+ */
+static uint8_t FlashLog_SlotErased(uint8_t Sector, uint32_t Slot)
+{
+	uint32_t *Word = (uint32_t*) FlashLog_Slot(Sector, Slot);
+
+	return (Word[0] == FLASHLOG_EMPTY && Word[1] == FLASHLOG_EMPTY);
+}
+
+/*
+ * Check if sector has valid header, sector being erased has lost its records
+ *
+ * @param[Sector] - sector index in the log
+ * @return - 1 sector is part of the log
+ */
+static uint8_t FlashLog_SectorValid(uint8_t Sector)
+{
+	FlashLog_Header_t *Header =
+			(FlashLog_Header_t*) FlashLog_SectorAddress(Sector);
+
+	if (FlashLog.Erase != FLASHLOG_ERASE_NONE
+			&& Sector == (FlashLog.Active + 1) % FLASHLOG_SECTOR_COUNT)
+	{
+		return 0;
+	}
+
+	return (Header->Magic == FLASHLOG_MAGIC);
+}
+
+/*
+ * Program words to flash
+ *
+ * @param[Address] - flash address
+ * @param[*Data] - words to write
+ * @param[Count] - number of words
+ * @return - status @status
+ */
+static uint8_t FlashLog_Program(uint32_t Address, uint32_t *Data, uint8_t Count)
+{
+	uint8_t i;
+	uint8_t Status = FLASHLOG_OK;
+
+	HAL_FLASH_Unlock();
+	for (i = 0; i < Count; i++)
+	{
+		if (HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, Address + (i * 4),
+				Data[i]) != HAL_OK)
+		{
+			Status = FLASHLOG_ERR_FLASH;
+			break;
+		}
+	}
+	HAL_FLASH_Lock();
+
+	return Status;
+}
+
+/*
+ * Write header of erased sector
+ *
+ * @param[Sector] - sector index in the log
+ * @param[Sequence] - sequence number for header
+ * @return - status @status
+ */
+static uint8_t FlashLog_WriteHeader(uint8_t Sector, uint32_t Sequence)
+{
+	FlashLog_Header_t Header;
+
+	Header.Magic = FLASHLOG_MAGIC;
+	Header.Sequence = Sequence;
+
+	return FlashLog_Program(FlashLog_SectorAddress(Sector), (uint32_t*) &Header,
+			sizeof(FlashLog_Header_t) / 4);
+}
+
+/*
+ * Erase sector and write its header, blocks for 1-2 s, only for format on boot
+ *
+ * @param[Sector] - sector index in the log
+ * @param[Sequence] - sequence number for header
+ * @return - status @status
+ */
+static uint8_t FlashLog_StartSector(uint8_t Sector, uint32_t Sequence)
+{
+	FLASH_EraseInitTypeDef Erase;
+	uint32_t SectorError;
+	HAL_StatusTypeDef Status;
+
+	Erase.TypeErase = FLASH_TYPEERASE_SECTORS;
+	Erase.Sector = FLASHLOG_FIRST_SECTOR + Sector;
+	Erase.NbSectors = 1;
+	Erase.VoltageRange = FLASH_VOLTAGE_RANGE_3;
+
+	HAL_FLASH_Unlock();
+	Status = HAL_FLASHEx_Erase(&Erase, &SectorError);
+	HAL_FLASH_Lock();
+
+	if (Status != HAL_OK)
+	{
+		return FLASHLOG_ERR_FLASH;
+	}
+
+	return FlashLog_WriteHeader(Sector, Sequence);
+}
+
+/*
+ * Start background erase of sector after active one, it holds the oldest records
+ *
+ * @return - status @status
+ */
+static uint8_t FlashLog_StartErase(void)
+{
+	FLASH_EraseInitTypeDef Erase;
+
+	Erase.TypeErase = FLASH_TYPEERASE_SECTORS;
+	Erase.Sector = FLASHLOG_FIRST_SECTOR + (FlashLog.Active + 1) % FLASHLOG_SECTOR_COUNT;
+	Erase.NbSectors = 1;
+	Erase.VoltageRange = FLASH_VOLTAGE_RANGE_3;
+
+	// records of the sector are gone from now on
+	FlashLog.Erase = FLASHLOG_ERASE_RUNNING;
+
+	// flash stays unlocked until interrupt reports end of erase
+	Supervisor_Hold();
+	HAL_FLASH_Unlock();
+	if (HAL_FLASHEx_Erase_IT(&Erase) != HAL_OK)
+	{
+		HAL_FLASH_Lock();
+		Supervisor_Release();
+		FlashLog.Erase = FLASHLOG_ERASE_FAILED;
+		return FLASHLOG_ERR_FLASH;
+	}
+
+	return FLASHLOG_OK;
+}
+
+/*
+ * Make erased sector active when the active one is full
+ *
+ * @return - status @status, FLASHLOG_ERR_BUSY when erase was started now
+ */
+static uint8_t FlashLog_Rotate(void)
+{
+	uint8_t Next = (FlashLog.Active + 1) % FLASHLOG_SECTOR_COUNT;
+	uint8_t Status;
+
+	switch (FlashLog.Erase)
+	{
+	case FLASHLOG_ERASE_NONE:
+		// erase was not started ahead, e.g. log full on boot
+		Status = FlashLog_StartErase();
+		return (Status == FLASHLOG_OK) ? FLASHLOG_ERR_BUSY : Status;
+
+	case FLASHLOG_ERASE_FAILED:
+		// next append tries again
+		FlashLog.Erase = FLASHLOG_ERASE_NONE;
+		return FLASHLOG_ERR_FLASH;
+
+	default:
+		break;
+	}
+
+	Status = FlashLog_WriteHeader(Next, FlashLog.Sequence + 1);
+	FlashLog.Erase = FLASHLOG_ERASE_NONE;
+	if (Status != FLASHLOG_OK)
+	{
+		return Status;
+	}
+
+	FlashLog.Active = Next;
+	FlashLog.Sequence++;
+	FlashLog.Tail = 0;
+
+	return FLASHLOG_OK;
+}
+
+/*
+ * Find last complete record written before reset
+ *
+ * @param[*Record] - found record
+ * @return - 1 found, 0 log is empty
+ */
+static uint8_t FlashLog_FindLast(FlashLog_Record_t *Record)
+{
+	uint32_t Count = FlashLog_GetCount();
+
+	while (Count > 0)
+	{
+		Count--;
+		if (FlashLog_Read(Count, Record) == FLASHLOG_OK)
+		{
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+/*
+ * Scan sectors, find active one and its tail. Empty flash is formatted,
+ * it blocks for 1-2 s, so it is called before watchdog starts.
+ *
+ * @return - status @status, log is not written when it is not FLASHLOG_OK
+ */
+uint8_t FlashLog_Init(void)
+{
+	uint8_t i;
+	uint8_t Found = 0;
+	uint32_t Low, High, Middle;
+	FlashLog_Header_t *Header;
+	FlashLog_Record_t Last;
+
+	memset(&FlashLog, 0, sizeof(FlashLog_t));
+
+	// active sector has the highest sequence
+	for (i = 0; i < FLASHLOG_SECTOR_COUNT; i++)
+	{
+		if (FlashLog_SectorValid(i))
+		{
+			Header = (FlashLog_Header_t*) FlashLog_SectorAddress(i);
+			if (!Found || Header->Sequence > FlashLog.Sequence)
+			{
+				FlashLog.Active = i;
+				FlashLog.Sequence = Header->Sequence;
+				Found = 1;
+			}
+		}
+	}
+
+	if (!Found)
+	{
+		if (FlashLog_StartSector(0, 0) != FLASHLOG_OK)
+		{
+			return FLASHLOG_ERR_FLASH;
+		}
+		FlashLog.Active = 0;
+		FlashLog.Sequence = 0;
+	}
+
+	// binary search of first erased slot
+	Low = 0;
+	High = FLASHLOG_SECTOR_RECORDS;
+	while (Low < High)
+	{
+		Middle = (Low + High) / 2;
+		if (FlashLog_SlotErased(FlashLog.Active, Middle))
+		{
+			High = Middle;
+		}
+		else
+		{
+			Low = Middle + 1;
+		}
+	}
+	FlashLog.Tail = Low;
+
+	// new boot number, so records of this run can be told apart
+	if (FlashLog_FindLast(&Last))
+	{
+		FlashLog.Boot = Last.Boot + 1;
+	}
+
+	FlashLog.Ready = 1;
+
+	HAL_NVIC_SetPriority(FLASH_IRQn, 0, 0);
+	HAL_NVIC_EnableIRQ(FLASH_IRQn);
+
+	return FLASHLOG_OK;
+}
+
+/*
+ * Append sample to log, rotates to next sector when active one is full.
+ * Erase of next sector is started ahead and never blocks, records appended
+ * while it runs are refused with FLASHLOG_ERR_BUSY.
+ *
+ * @param[Address] - sensor address
+ * @param[*Sample] - sample to store
+ * @return - status @status
+ */
+uint8_t FlashLog_Append(uint8_t Address, TMP102Sample_t *Sample)
+{
+	FlashLog_Record_t Record;
+	uint8_t Status;
+
+	if (!FlashLog.Ready)
+	{
+		return FLASHLOG_ERR_FLASH;
+	}
+
+	// flash is taken by background erase, record is not stored
+	if (FlashLog.Erase == FLASHLOG_ERASE_RUNNING)
+	{
+		return FLASHLOG_ERR_BUSY;
+	}
+
+	if (FlashLog.Tail >= FLASHLOG_SECTOR_RECORDS)
+	{
+		Status = FlashLog_Rotate();
+		if (Status != FLASHLOG_OK)
+		{
+			return Status;
+		}
+	}
+
+	Record.Time = Sample->Timestamp;
+	Record.Value = Sample->Value;
+	Record.Address = Address;
+	Record.Boot = FlashLog.Boot;
+
+	// slot is used even if programming fails, so tail never points to dirty slot
+	Status = FlashLog_Program((uint32_t) FlashLog_Slot(FlashLog.Active,
+			FlashLog.Tail), (uint32_t*) &Record, sizeof(FlashLog_Record_t) / 4);
+	FlashLog.Tail++;
+
+	// next sector is erased while the last slots are filled
+	if (FlashLog.Tail >= FLASHLOG_SECTOR_RECORDS - FLASHLOG_ERASE_AHEAD
+			&& FlashLog.Erase == FLASHLOG_ERASE_NONE)
+	{
+		FlashLog_StartErase();
+	}
+
+	return Status;
+}
+
+/*
+ * Number of record slots from oldest to newest
+ *
+ * @return - number of records
+ */
+uint32_t FlashLog_GetCount(void)
+{
+	uint8_t i;
+	uint8_t Sector;
+	uint32_t Count = FlashLog.Tail;
+
+	// sectors before active one were rotated only when full
+	for (i = 1; i < FLASHLOG_SECTOR_COUNT; i++)
+	{
+		Sector = (FlashLog.Active + i) % FLASHLOG_SECTOR_COUNT;
+		if (FlashLog_SectorValid(Sector))
+		{
+			Count += FLASHLOG_SECTOR_RECORDS;
+		}
+	}
+
+	return Count;
+}
+
+/*
+ * Read record, index 0 is the oldest one
+ *
+ * @param[Index] - record number
+ * @param[*Record] - read record
+ * @return - status @status, FLASHLOG_ERR_EMPTY for interrupted write
+ */
+uint8_t FlashLog_Read(uint32_t Index, FlashLog_Record_t *Record)
+{
+	uint8_t i;
+	uint8_t Sector;
+	uint32_t Records;
+
+	// walk from oldest sector to active one
+	for (i = 1; i <= FLASHLOG_SECTOR_COUNT; i++)
+	{
+		Sector = (FlashLog.Active + i) % FLASHLOG_SECTOR_COUNT;
+
+		if (Sector == FlashLog.Active)
+		{
+			Records = FlashLog.Tail;
+		}
+		else if (FlashLog_SectorValid(Sector))
+		{
+			Records = FLASHLOG_SECTOR_RECORDS;
+		}
+		else
+		{
+			Records = 0;
+		}
+
+		if (Index < Records)
+		{
+			memcpy(Record, FlashLog_Slot(Sector, Index),
+					sizeof(FlashLog_Record_t));
+			return (Record->Address == 0xFF) ? FLASHLOG_ERR_EMPTY : FLASHLOG_OK;
+		}
+		Index -= Records;
+	}
+
+	return FLASHLOG_ERR_RANGE;
+}
+
+/*
+ * Sequence number of active sector, number of rotations since first format
+ *
+ * @return - sequence
+ */
+uint32_t FlashLog_GetSequence(void)
+{
+	return FlashLog.Sequence;
+}
+
+/*
+ * Background erase finished, put in HAL_FLASH_EndOfOperationCallback
+ *
+ * @return - void
+ */
+void FlashLog_EraseCpltCallback(void)
+{
+	if (FlashLog.Erase == FLASHLOG_ERASE_RUNNING)
+	{
+		HAL_FLASH_Lock();
+		Supervisor_Release();
+		FlashLog.Erase = FLASHLOG_ERASE_DONE;
+	}
+}
+
+/*
+ * Background erase failed, put in HAL_FLASH_OperationErrorCallback
+ *
+ * @return - void
+ */
+void FlashLog_EraseErrorCallback(void)
+{
+	if (FlashLog.Erase == FLASHLOG_ERASE_RUNNING)
+	{
+		HAL_FLASH_Lock();
+		Supervisor_Release();
+		FlashLog.Erase = FLASHLOG_ERASE_FAILED;
+	}
+}
@@ -0,0 +1,444 @@
+/*
+ * i2cbus.c
+ *
+ *  Created on: 19 October 2026
+ */
+
+/* I2C bus guard for blocking transfers and recovery of stuck bus.
+ *
+ * Blocking transfers get timeout from bus speed and length, so a stuck line costs
+ * few ms instead of a second. After timeout, lost arbitration, bus error or BUSY flag
+ * left without transfer the bus is recovered : peripheral is released, SCL is clocked
+ * 9 times as GPIO until slave lets SDA go, STOP is sent and peripheral is initialized
+ * again (HAL_I2C_Init does software reset, which clears stuck BUSY flag).
+ *
+ * Bus speed can be changed at runtime. Higher speed is kept only when all devices
+ * give the same register values as at old speed, otherwise old speed is restored.
+ *
+ * Errors of DMA transfers come from interrupt, there only pending flag is set and
+ * recovery is done by I2CBus_Process or by next blocking transfer.
+ *
+ * put I2CBus_ErrorCallback in HAL_I2C_ErrorCallback in main.c, before other callbacks
+ * put I2CBus_Process in main loop
+ */
+
+#include "main.h"
+#include "string.h"
+#include "log.h"
+#include "i2cbus.h"
+
+static I2CBus_t I2CBus;
+
+/*
+ * Half of SCL period at I2CBUS_RECOVERY_RATE, one pass takes about 4 cycles
+ *
+ * @return - void
+ */
+static void I2CBus_Delay(void)
+{
+	for (volatile uint32_t i = SystemCoreClock / (I2CBUS_RECOVERY_RATE * 2 * 4);
+			i > 0; i--)
+	{
+	}
+}
+
+/*
+ * Count failed transfer by its cause
+ *
+ * @param[*hi2c] - i2c handle
+ * @param[Status] - HAL status of blocking transfer, HAL_ERROR for DMA
+ * @return - 1 bus has to be recovered, 0 bus is fine
+ */
+static uint8_t I2CBus_CountError(I2C_HandleTypeDef *hi2c, HAL_StatusTypeDef Status)
+{
+	uint32_t Error = HAL_I2C_GetError(hi2c);
+	uint8_t Recover = 0;
+
+	if (Status == HAL_TIMEOUT || (Error & HAL_I2C_ERROR_TIMEOUT))
+	{
+		I2CBus.Timeouts++;
+		Recover = 1;
+	}
+	if ((Error & HAL_I2C_ERROR_ARLO) || __HAL_I2C_GET_FLAG(hi2c, I2C_FLAG_ARLO))
+	{
+		I2CBus.ArbitrationLost++;
+		Recover = 1;
+	}
+	if ((Error & HAL_I2C_ERROR_BERR) || __HAL_I2C_GET_FLAG(hi2c, I2C_FLAG_BERR))
+	{
+		I2CBus.BusErrors++;
+		Recover = 1;
+	}
+	if (Error & HAL_I2C_ERROR_AF)
+	{
+		I2CBus.Nacks++;
+	}
+
+	return Recover;
+}
+
+/*
+ * Check bus before blocking transfer, recover it if needed
+ *
+ * @param[*hi2c] - i2c handle
+ * @return - 1 transfer can start, 0 peripheral is used or bus is stuck
+ */
+static uint8_t I2CBus_Ready(I2C_HandleTypeDef *hi2c)
+{
+	// DMA chain or scan runs, it is not a bus fault
+	if (hi2c->State != HAL_I2C_STATE_READY)
+	{
+		return 0;
+	}
+
+	// HAL would wait 25 ms for BUSY flag before failing
+	if (__HAL_I2C_GET_FLAG(hi2c, I2C_FLAG_BUSY))
+	{
+		I2CBus.Busy++;
+		I2CBus.RecoveryPending = 1;
+	}
+
+	if (I2CBus.RecoveryPending)
+	{
+		return I2CBus_Recover(hi2c);
+	}
+
+	return 1;
+}
+
+/*
+ * Timeout of blocking transfer
+ *
+ * @param[*hi2c] - i2c handle
+ * @param[Bytes] - all bytes on bus including addresses
+ * @return - timeout in ms
+ */
+uint32_t I2CBus_Timeout(I2C_HandleTypeDef *hi2c, uint16_t Bytes)
+{
+	uint32_t Rate = hi2c->Init.ClockSpeed;
+
+	return ((Bytes * I2CBUS_BITS_PER_BYTE * 1000) + Rate - 1) / Rate
+			+ I2CBUS_TIMEOUT_MARGIN;
+}
+
+/*
+ * Read register of device with timeout from bus speed, bus is recovered on error
+ *
+ * @param[*hi2c] - i2c handle
+ * @param[DevAddress] - device address shifted left
+ * @param[MemAddress] - 8 bit register address
+ * @param[*pData] - buffer for data
+ * @param[Size] - bytes to read
+ * @return - HAL status
+ */
+HAL_StatusTypeDef I2CBus_MemRead(I2C_HandleTypeDef *hi2c, uint16_t DevAddress,
+		uint16_t MemAddress, uint8_t *pData, uint16_t Size)
+{
+	HAL_StatusTypeDef Status;
+
+	if (!I2CBus_Ready(hi2c))
+	{
+		return HAL_BUSY;
+	}
+
+	Status = HAL_I2C_Mem_Read(hi2c, DevAddress, MemAddress, I2C_MEMADD_SIZE_8BIT,
+			pData, Size, I2CBus_Timeout(hi2c, Size + I2CBUS_MEM_OVERHEAD));
+	if (Status != HAL_OK && I2CBus_CountError(hi2c, Status))
+	{
+		I2CBus_Recover(hi2c);
+	}
+
+	return Status;
+}
+
+/*
+ * Write register of device with timeout from bus speed, bus is recovered on error
+ *
+ * @param[*hi2c] - i2c handle
+ * @param[DevAddress] - device address shifted left
+ * @param[MemAddress] - 8 bit register address
+ * @param[*pData] - data to write
+ * @param[Size] - bytes to write
+ * @return - HAL status
+ */
+HAL_StatusTypeDef I2CBus_MemWrite(I2C_HandleTypeDef *hi2c, uint16_t DevAddress,
+		uint16_t MemAddress, uint8_t *pData, uint16_t Size)
+{
+	HAL_StatusTypeDef Status;
+
+	if (!I2CBus_Ready(hi2c))
+	{
+		return HAL_BUSY;
+	}
+
+	Status = HAL_I2C_Mem_Write(hi2c, DevAddress, MemAddress, I2C_MEMADD_SIZE_8BIT,
+			pData, Size, I2CBus_Timeout(hi2c, Size + I2CBUS_MEM_OVERHEAD));
+	if (Status != HAL_OK && I2CBus_CountError(hi2c, Status))
+	{
+		I2CBus_Recover(hi2c);
+	}
+
+	return Status;
+}
+
+/*
+ * Release stuck bus and initialize peripheral again, transfer in progress is lost
+ *
+ * @param[*hi2c] - i2c handle
+ * @return - 1 both lines are high, 0 line is still held low
+ */
+uint8_t I2CBus_Recover(I2C_HandleTypeDef *hi2c)
+{
+	GPIO_InitTypeDef GPIO_InitStruct = {0};
+	uint8_t Released;
+	uint8_t i;
+
+	I2CBus.RecoveryPending = 0;
+	I2CBus.Recoveries++;
+
+	// pins, DMA and interrupts are released by MspDeInit
+	HAL_I2C_DeInit(hi2c);
+
+	HAL_GPIO_WritePin(I2CBUS_SCL_PORT, I2CBUS_SCL_PIN, GPIO_PIN_SET);
+	HAL_GPIO_WritePin(I2CBUS_SDA_PORT, I2CBUS_SDA_PIN, GPIO_PIN_SET);
+	GPIO_InitStruct.Mode = GPIO_MODE_OUTPUT_OD;
+	GPIO_InitStruct.Pull = GPIO_NOPULL;
+	GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_HIGH;
+	GPIO_InitStruct.Pin = I2CBUS_SCL_PIN;
+	HAL_GPIO_Init(I2CBUS_SCL_PORT, &GPIO_InitStruct);
+	GPIO_InitStruct.Pin = I2CBUS_SDA_PIN;
+	HAL_GPIO_Init(I2CBUS_SDA_PORT, &GPIO_InitStruct);
+	I2CBus_Delay();
+
+	// clock out byte the slave is still sending
+	for (i = 0; i < I2CBUS_RECOVERY_CLOCKS
+			&& HAL_GPIO_ReadPin(I2CBUS_SDA_PORT, I2CBUS_SDA_PIN) == GPIO_PIN_RESET;
+			i++)
+	{
+		HAL_GPIO_WritePin(I2CBUS_SCL_PORT, I2CBUS_SCL_PIN, GPIO_PIN_RESET);
+		I2CBus_Delay();
+		HAL_GPIO_WritePin(I2CBUS_SCL_PORT, I2CBUS_SCL_PIN, GPIO_PIN_SET);
+		I2CBus_Delay();
+	}
+
+	// STOP - SDA rises while SCL is high
+	HAL_GPIO_WritePin(I2CBUS_SCL_PORT, I2CBUS_SCL_PIN, GPIO_PIN_RESET);
+	I2CBus_Delay();
+	HAL_GPIO_WritePin(I2CBUS_SDA_PORT, I2CBUS_SDA_PIN, GPIO_PIN_RESET);
+	I2CBus_Delay();
+	HAL_GPIO_WritePin(I2CBUS_SCL_PORT, I2CBUS_SCL_PIN, GPIO_PIN_SET);
+	I2CBus_Delay();
+	HAL_GPIO_WritePin(I2CBUS_SDA_PORT, I2CBUS_SDA_PIN, GPIO_PIN_SET);
+	I2CBus_Delay();
+
+	Released = (HAL_GPIO_ReadPin(I2CBUS_SCL_PORT, I2CBUS_SCL_PIN) == GPIO_PIN_SET
+			&& HAL_GPIO_ReadPin(I2CBUS_SDA_PORT, I2CBUS_SDA_PIN) == GPIO_PIN_SET);
+	if (!Released)
+	{
+		I2CBus.RecoveryFailed++;
+	}
+
+	// MspInit gives pins back to peripheral, interrupts are enabled only by MX_NVIC_Init
+	if (HAL_I2C_Init(hi2c) != HAL_OK)
+	{
+		Released = 0;
+	}
+	HAL_NVIC_EnableIRQ(I2C1_EV_IRQn);
+	HAL_NVIC_EnableIRQ(I2C1_ER_IRQn);
+
+	LOG_WARNING(LOG_MSG_I2C_RECOVERY, (unsigned long) I2CBus.Recoveries,
+			(unsigned long) Released);
+
+	return Released;
+}
+
+/*
+ * Change bus speed, CCR and TRISE are computed from PCLK1 by init,
+ * pins and DMA links stay
+ *
+ * @param[*hi2c] - i2c handle
+ * @param[Speed] - @speed or other rate up to I2CBUS_SPEED_FAST
+ * @return - HAL status, HAL_BUSY if transfer is in progress
+ */
+HAL_StatusTypeDef I2CBus_SetSpeed(I2C_HandleTypeDef *hi2c, uint32_t Speed)
+{
+	if (hi2c->State != HAL_I2C_STATE_READY)
+	{
+		return HAL_BUSY;
+	}
+
+	hi2c->Init.ClockSpeed = Speed;
+	hi2c->Init.DutyCycle = I2C_DUTYCYCLE_2;
+
+	return HAL_I2C_Init(hi2c);
+}
+
+/*
+ * Switch to new speed if all devices work at it, otherwise stay at old speed.
+ * Without devices nothing can be verified, bus is set to standard speed.
+ * Speed in use is in hi2c->Init.ClockSpeed.
+ *
+ * @param[*hi2c] - i2c handle
+ * @param[Speed] - @speed
+ * @param[*Devices] - 7 bit addresses of devices to test
+ * @param[*Registers] - register of every device which does not change by itself,
+ *                      2 bytes are compared
+ * @param[Count] - number of devices, up to I2CBUS_SELFTEST_DEVICES are tested
+ * @return - result @select
+ */
+uint8_t I2CBus_SelectSpeed(I2C_HandleTypeDef *hi2c, uint32_t Speed,
+		const uint8_t *Devices, const uint8_t *Registers, uint8_t Count)
+{
+	uint8_t Reference[I2CBUS_SELFTEST_DEVICES][2];
+	uint8_t Value[2];
+	uint32_t OldSpeed = hi2c->Init.ClockSpeed;
+	uint8_t Passed = 1;
+	uint8_t i, j;
+
+	if (Count == 0)
+	{
+		if (OldSpeed != I2CBUS_SPEED_STANDARD
+				&& I2CBus_SetSpeed(hi2c, I2CBUS_SPEED_STANDARD) != HAL_OK)
+		{
+			return I2CBUS_SELECT_BUSY;
+		}
+		LOG_INFO(LOG_MSG_I2C_SPEED, (unsigned long) hi2c->Init.ClockSpeed,
+				(unsigned long) Speed);
+		return I2CBUS_SELECT_NOT_VERIFIED;
+	}
+
+	if (Count > I2CBUS_SELFTEST_DEVICES)
+	{
+		Count = I2CBUS_SELFTEST_DEVICES;
+	}
+
+	// without reference there is nothing to compare
+	for (i = 0; i < Count; i++)
+	{
+		if (I2CBus_MemRead(hi2c, Devices[i] << 1, Registers[i], Reference[i], 2)
+				!= HAL_OK)
+		{
+			return I2CBUS_SELECT_FAILED;
+		}
+	}
+
+	if (I2CBus_SetSpeed(hi2c, Speed) != HAL_OK)
+	{
+		Passed = 0;
+	}
+
+	for (i = 0; i < Count && Passed; i++)
+	{
+		for (j = 0; j < I2CBUS_SELFTEST_READS; j++)
+		{
+			if (I2CBus_MemRead(hi2c, Devices[i] << 1, Registers[i], Value, 2) != HAL_OK
+					|| memcmp(Value, Reference[i], 2) != 0)
+			{
+				Passed = 0;
+				break;
+			}
+		}
+	}
+
+	if (!Passed)
+	{
+		I2CBus.SpeedFallbacks++;
+		I2CBus_SetSpeed(hi2c, OldSpeed);
+	}
+
+	LOG_INFO(LOG_MSG_I2C_SPEED, (unsigned long) hi2c->Init.ClockSpeed,
+			(unsigned long) Speed);
+
+	return Passed ? I2CBUS_SELECT_OK : I2CBUS_SELECT_FAILED;
+}
+
+/*
+ * Measure time of register read at current speed with DWT cycle counter,
+ * core clock must not change during the reads (main loop only)
+ *
+ * @param[*hi2c] - i2c handle
+ * @param[Device] - 7 bit address
+ * @param[Reg] - register to read, 2 bytes
+ * @param[*ReadTime] - average time of one read in us, set only for I2CBUS_BENCHMARK_OK
+ * @return - result @benchmark
+ */
+uint8_t I2CBus_Benchmark(I2C_HandleTypeDef *hi2c, uint8_t Device, uint8_t Reg,
+		uint32_t *ReadTime)
+{
+	uint8_t Value[2];
+	uint32_t Start;
+	uint32_t Cycles;
+	HAL_StatusTypeDef Status;
+	uint16_t i;
+
+	// counter runs also without debugger once trace is enabled, 32 bit lasts 51 s at 84 MHz
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+	Start = DWT->CYCCNT;
+	for (i = 0; i < I2CBUS_BENCHMARK_READS; i++)
+	{
+		Status = I2CBus_MemRead(hi2c, Device << 1, Reg, Value, 2);
+		if (Status == HAL_BUSY)
+		{
+			return I2CBUS_BENCHMARK_BUSY;
+		}
+		if (Status != HAL_OK)
+		{
+			return I2CBUS_BENCHMARK_FAILED;
+		}
+	}
+	Cycles = DWT->CYCCNT - Start;
+
+	*ReadTime = Cycles / (SystemCoreClock / 1000000) / I2CBUS_BENCHMARK_READS;
+
+	return I2CBUS_BENCHMARK_OK;
+}
+
+/*
+ * Put in main loop, recovers bus after error of DMA transfer when peripheral is free
+ *
+ * @param[*hi2c] - i2c handle
+ * @return - void
+ */
+void I2CBus_Process(I2C_HandleTypeDef *hi2c)
+{
+	if (I2CBus.RecoveryPending && hi2c->State == HAL_I2C_STATE_READY)
+	{
+		I2CBus_Recover(hi2c);
+	}
+}
+
+/*
+ * Bus waits for recovery, transfers started now would fail
+ *
+ * @return - 1 recovery pending
+ */
+uint8_t I2CBus_IsRecoveryPending(void)
+{
+	return I2CBus.RecoveryPending;
+}
+
+/*
+ * Error counters
+ *
+ * @return - counters
+ */
+const I2CBus_t *I2CBus_GetStats(void)
+{
+	return &I2CBus;
+}
+
+/*
+ * Callback to put in HAL_I2C_ErrorCallback
+ *
+ * @param[*hi2c] - i2c handle
+ * @return - void
+ */
+void I2CBus_ErrorCallback(I2C_HandleTypeDef *hi2c)
+{
+	if (I2CBus_CountError(hi2c, HAL_ERROR))
+	{
+		I2CBus.RecoveryPending = 1;
+	}
+}
@@ -0,0 +1,266 @@
+/*
+ * log.c
+ *
+ *  Created on: 19 October 2026
+ */
+
+/* Log records are written to a binary ring buffer from any context (also IRQ),
+ * it takes only a copy of few words. Formatting and transmission to USART2 is
+ * done later in Log_Process, called from main loop. Transmission is interrupt
+ * driven, so USART2 global interrupt has to be enabled.
+ *
+ * Terminal text is copied by Log_WriteText to text buffer and sent in order
+ * with log lines, as it is, without timestamp.
+ * Other code writing directly to USART2 should call Log_WaitIdle first.
+ *
+ * Line on the wire is a pool block, put Log_TxCpltCallback in HAL_UART_TxCpltCallback
+ * to give it back.
+ */
+
+#include "main.h"
+#include "usart.h"
+#include "stdio.h"
+#include "stdarg.h"
+#include "string.h"
+#include "log.h"
+#include "pool.h"
+
+static const char LogLevelSign[] = { 'D', 'I', 'W', 'E' };
+
+static Log_Record_t LogBuffer[LOG_BUFFER_SIZE];
+static volatile uint16_t LogHead;
+static volatile uint16_t LogTail;
+static volatile uint32_t LogDropped;
+
+// copies of terminal text, records point to them by start and lenght
+static char LogText[LOG_TEXT_BUFFER_SIZE];
+static uint16_t LogTextHead;
+static volatile uint16_t LogTextTail;
+
+// line that is currently transmitted, pool block
+static char *volatile LogLine;
+
+/*
+ * Write log record, can be called from IRQ
+ * Only the format pointer and arguments are copied, line is formatted in Log_Process.
+ * Use LOG_* macros, they count the arguments at compile time.
+ *
+ * @param[Level] - @levels
+ * @param[Count] - number of arguments, at most LOG_MAX_ARGS
+ * @param[*Format] - literal format string @messages
+ * @param[...] - long arguments
+ * @return - void
+ */
+void Log_Write(uint8_t Level, uint8_t Count, const char *Format, ...)
+{
+	long Args[LOG_MAX_ARGS] = { 0 };
+	uint8_t i;
+	va_list List;
+
+	va_start(List, Format);
+	for (i = 0; i < Count && i < LOG_MAX_ARGS; i++)
+	{
+		Args[i] = va_arg(List, long);
+	}
+	va_end(List);
+
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+
+	uint16_t HeadTmp = (LogHead + 1) % LOG_BUFFER_SIZE;
+
+	// buffer full - newest record is lost
+	if (HeadTmp == LogTail)
+	{
+		LogDropped++;
+		__set_PRIMASK(primask);
+		return;
+	}
+
+	Log_Record_t *Record = &LogBuffer[LogHead];
+	Record->Timestamp = HAL_GetTick();
+	Record->Format = Format;
+	Record->Level = Level;
+	Record->Args[0] = Args[0];
+	Record->Args[1] = Args[1];
+	Record->Args[2] = Args[2];
+	LogHead = HeadTmp;
+
+	__set_PRIMASK(primask);
+}
+
+/*
+ * Queue terminal text, can be called from IRQ
+ * Text is copied, it is sent without timestamp and end of line is not added.
+ *
+ * @param[*Text] - string, cut to LOG_LINE_SIZE
+ * @return - void
+ */
+void Log_WriteText(const char *Text)
+{
+	uint16_t Lenght = strlen(Text);
+	uint16_t Free;
+	uint16_t i;
+
+	if (Lenght > LOG_LINE_SIZE)
+	{
+		Lenght = LOG_LINE_SIZE;
+	}
+
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+
+	uint16_t HeadTmp = (LogHead + 1) % LOG_BUFFER_SIZE;
+	Free = (LogTextTail + LOG_TEXT_BUFFER_SIZE - LogTextHead - 1) % LOG_TEXT_BUFFER_SIZE;
+
+	// no record or no place for text - text is lost
+	if (HeadTmp == LogTail || Lenght > Free)
+	{
+		LogDropped++;
+		__set_PRIMASK(primask);
+		return;
+	}
+
+	Log_Record_t *Record = &LogBuffer[LogHead];
+	Record->Timestamp = HAL_GetTick();
+	Record->Format = NULL;
+	Record->Level = LOG_LEVEL_INFO;
+	Record->Args[0] = LogTextHead;
+	Record->Args[1] = Lenght;
+	Record->Args[2] = 0;
+
+	for (i = 0; i < Lenght; i++)
+	{
+		LogText[LogTextHead] = Text[i];
+		LogTextHead = (LogTextHead + 1) % LOG_TEXT_BUFFER_SIZE;
+	}
+	LogHead = HeadTmp;
+
+	__set_PRIMASK(primask);
+}
+
+/*
+ * Format and send one record if USART2 is free, call it from main loop
+ *
+ * @return - void
+ */
+void Log_Process(void)
+{
+	// previous line is still transmitted
+	if (huart2.gState != HAL_UART_STATE_READY)
+	{
+		return;
+	}
+
+	// nothing to send
+	if (LogHead == LogTail)
+	{
+		return;
+	}
+
+	// end of last line was not reported, block is not used by UART anymore
+	if (LogLine != NULL)
+	{
+		Pool_Free(LogLine);
+		LogLine = NULL;
+	}
+
+	// no free block - record waits for next call
+	LogLine = Pool_Alloc(LOG_LINE_SIZE);
+	if (LogLine == NULL)
+	{
+		return;
+	}
+
+	Log_Record_t *Record = &LogBuffer[LogTail];
+	int Lenght;
+	int Used;
+
+	// terminal text is sent as it is, its place in text buffer is given back
+	if (Record->Format == NULL)
+	{
+		for (Lenght = 0; Lenght < Record->Args[1]; Lenght++)
+		{
+			LogLine[Lenght] = LogText[(Record->Args[0] + Lenght) % LOG_TEXT_BUFFER_SIZE];
+		}
+		LogTextTail = (Record->Args[0] + Lenght) % LOG_TEXT_BUFFER_SIZE;
+		LogTail = (LogTail + 1) % LOG_BUFFER_SIZE;
+
+		if (HAL_UART_Transmit_IT(&huart2, (uint8_t*) LogLine, Lenght) != HAL_OK)
+		{
+			Pool_Free(LogLine);
+			LogLine = NULL;
+		}
+		return;
+	}
+
+	Lenght = snprintf(LogLine, LOG_LINE_SIZE, "[%lu] %c: ",
+			(unsigned long) Record->Timestamp,
+			LogLevelSign[Record->Level & 3]);
+
+	// format was checked at Log_Write, arguments not used by it are ignored
+	Used = snprintf(&LogLine[Lenght], LOG_LINE_SIZE - Lenght, Record->Format,
+			Record->Args[0], Record->Args[1], Record->Args[2]);
+
+	// line was cut, keep place for end of line
+	Lenght += Used;
+	if (Lenght > LOG_LINE_SIZE - 3)
+	{
+		Lenght = LOG_LINE_SIZE - 3;
+	}
+	LogLine[Lenght++] = '\n';
+	LogLine[Lenght++] = '\r';
+
+	// record is formatted, place can be used again
+	LogTail = (LogTail + 1) % LOG_BUFFER_SIZE;
+
+	if (HAL_UART_Transmit_IT(&huart2, (uint8_t*) LogLine, Lenght) != HAL_OK)
+	{
+		Pool_Free(LogLine);
+		LogLine = NULL;
+	}
+}
+
+/*
+ * Give back block of sent line, put in HAL_UART_TxCpltCallback
+ *
+ * @param[*huart] - uart handle
+ * @return - void
+ */
+void Log_TxCpltCallback(UART_HandleTypeDef *huart)
+{
+	if (huart->Instance == huart2.Instance && LogLine != NULL)
+	{
+		Pool_Free(LogLine);
+		LogLine = NULL;
+	}
+}
+
+/*
+ * Wait until log line transmission is finished, used before blocking
+ * transmission on USART2
+ *
+ * @return - void
+ */
+void Log_WaitIdle(void)
+{
+	uint32_t StartTime = HAL_GetTick();
+
+	while (huart2.gState != HAL_UART_STATE_READY)
+	{
+		if (HAL_GetTick() - StartTime > LOG_UART_TIMEOUT)
+		{
+			return;
+		}
+	}
+}
+
+/*
+ * Number of records lost because log buffer was full
+ *
+ * @return - dropped records
+ */
+uint32_t Log_GetDropped(void)
+{
+	return LogDropped;
+}
@@ -1,287 +1,510 @@
-/* USER CODE BEGIN Header */
-/**
- ******************************************************************************
- * @file           : main.c
- * @brief          : Main program body
- ******************************************************************************
- * @attention
- *
- * <h2><center>&copy; Copyright (c) 2021 STMicroelectronics.
- * All rights reserved.</center></h2>
- *
- * This software component is licensed by ST under BSD 3-Clause license,
- * the "License"; You may not use this file except in compliance with the
- * License. You may obtain a copy of the License at:
- *                        opensource.org/licenses/BSD-3-Clause
- *
- ******************************************************************************
- */
-/* USER CODE END Header */
-/* Includes ------------------------------------------------------------------*/
-#include "main.h"
-#include "dma.h"
-#include "i2c.h"
-#include "tim.h"
-#include "usart.h"
-#include "gpio.h"
-
-/* Private includes ----------------------------------------------------------*/
-/* USER CODE BEGIN Includes */
-#include "ringbuffer.h"
-#include "parse.h"
-#include "string.h"
-#include "JDY-09.h"
-#include "utils.h"
-#include "tmp102.h"
-#include "stm32_tm1637.h"
-/* USER CODE END Includes */
-
-/* Private typedef -----------------------------------------------------------*/
-/* USER CODE BEGIN PTD */
-
-/* USER CODE END PTD */
-
-/* Private define ------------------------------------------------------------*/
-/* USER CODE BEGIN PD */
-/* USER CODE END PD */
-
-/* Private macro -------------------------------------------------------------*/
-/* USER CODE BEGIN PM */
-
-/* USER CODE END PM */
-
-/* Private variables ---------------------------------------------------------*/
-
-/* USER CODE BEGIN PV */
-uint8_t TransferBuffer[64];
-uint8_t ParseStatus;
-JDY09_t JDY09_1;
-TMP102_t TMP102_1;
-uint8_t temperaturevalue[2];
-volatile uint32_t TimerCount10ms;
-/* USER CODE END PV */
-
-/* Private function prototypes -----------------------------------------------*/
-void SystemClock_Config(void);
-static void MX_NVIC_Init(void);
-/* USER CODE BEGIN PFP */
-
-/* USER CODE END PFP */
-
-/* Private user code ---------------------------------------------------------*/
-/* USER CODE BEGIN 0 */
-
-/* USER CODE END 0 */
-
-/**
-  * @brief  The application entry point.
-  * @retval int
-  */
-int main(void)
-{
-  /* USER CODE BEGIN 1 */
-
-  /* USER CODE END 1 */
-
-  /* MCU Configuration--------------------------------------------------------*/
-
-  /* Reset of all peripherals, Initializes the Flash interface and the Systick. */
-  HAL_Init();
-
-  /* USER CODE BEGIN Init */
-
-  /* USER CODE END Init */
-
-  /* Configure the system clock */
-  SystemClock_Config();
-
-  /* USER CODE BEGIN SysInit */
-
-  /* USER CODE END SysInit */
-
-  /* Initialize all configured peripherals */
-  MX_GPIO_Init();
-  MX_USART2_UART_Init();
-  MX_DMA_Init();
-  MX_USART1_UART_Init();
-  MX_I2C1_Init();
-  MX_TIM1_Init();
-
-  /* Initialize interrupts */
-  MX_NVIC_Init();
-  /* USER CODE BEGIN 2 */
-	I2CScan(&hi2c1);
-	JDY09_Init(&JDY09_1, &huart1, BT_STATE_GPIO_Port, BT_STATE_Pin);
-	TMP102Init(&TMP102_1, &hi2c1, TMP102_ADDRESS);
-	tm1637Init();
-
-  /* USER CODE END 2 */
-
-  /* Infinite loop */
-  /* USER CODE BEGIN WHILE */
-	while (1)
-	{
-		// check if there is msg - if yes transfer it to a buffer
-		if (JDY09_CheckPendingMessages(&JDY09_1, TransferBuffer) == JDY09_MESSAGEPENDING)
-		{
-			//clear pending flag
-			JDY09_ClearMsgPendingFlag(&JDY09_1);
-
-			//parse msg
-			ParseStatus = Parser_Parse(TransferBuffer, &TMP102_1);
-		}
-
-		//every 1 second make a display (delay 10ms)
-		if(TimerCount10ms % 10 == 1)
-		{
-			tm1637DisplayFloat(TMP102GetTempFloat(&TMP102_1));
-		}
-
-		// after one minute stop timer
-		if(TimerCount10ms > (10 * 60) +1)
-		{
-			// turn off timer
-			HAL_TIM_Base_Stop_IT(&htim1);
-			// turn of mosfet power to display
-			// reset timer
-			TimerCount10ms = 0;
-		}
-
-
-    /* USER CODE END WHILE */
-
-    /* USER CODE BEGIN 3 */
-	}
-  /* USER CODE END 3 */
-}
-
-/**
-  * @brief System Clock Configuration
-  * @retval None
-  */
-void SystemClock_Config(void)
-{
-  RCC_OscInitTypeDef RCC_OscInitStruct = {0};
-  RCC_ClkInitTypeDef RCC_ClkInitStruct = {0};
-
-  /** Configure the main internal regulator output voltage
-  */
-  __HAL_RCC_PWR_CLK_ENABLE();
-  __HAL_PWR_VOLTAGESCALING_CONFIG(PWR_REGULATOR_VOLTAGE_SCALE2);
-  /** Initializes the RCC Oscillators according to the specified parameters
-  * in the RCC_OscInitTypeDef structure.
-  */
-  RCC_OscInitStruct.OscillatorType = RCC_OSCILLATORTYPE_HSI;
-  RCC_OscInitStruct.HSIState = RCC_HSI_ON;
-  RCC_OscInitStruct.HSICalibrationValue = RCC_HSICALIBRATION_DEFAULT;
-  RCC_OscInitStruct.PLL.PLLState = RCC_PLL_ON;
-  RCC_OscInitStruct.PLL.PLLSource = RCC_PLLSOURCE_HSI;
-  RCC_OscInitStruct.PLL.PLLM = 16;
-  RCC_OscInitStruct.PLL.PLLN = 336;
-  RCC_OscInitStruct.PLL.PLLP = RCC_PLLP_DIV4;
-  RCC_OscInitStruct.PLL.PLLQ = 7;
-  if (HAL_RCC_OscConfig(&RCC_OscInitStruct) != HAL_OK)
-  {
-    Error_Handler();
-  }
-  /** Initializes the CPU, AHB and APB buses clocks
-  */
-  RCC_ClkInitStruct.ClockType = RCC_CLOCKTYPE_HCLK|RCC_CLOCKTYPE_SYSCLK
-                              |RCC_CLOCKTYPE_PCLK1|RCC_CLOCKTYPE_PCLK2;
-  RCC_ClkInitStruct.SYSCLKSource = RCC_SYSCLKSOURCE_PLLCLK;
-  RCC_ClkInitStruct.AHBCLKDivider = RCC_SYSCLK_DIV1;
-  RCC_ClkInitStruct.APB1CLKDivider = RCC_HCLK_DIV2;
-  RCC_ClkInitStruct.APB2CLKDivider = RCC_HCLK_DIV1;
-
-  if (HAL_RCC_ClockConfig(&RCC_ClkInitStruct, FLASH_LATENCY_2) != HAL_OK)
-  {
-    Error_Handler();
-  }
-}
-
-/**
-  * @brief NVIC Configuration.
-  * @retval None
-  */
-static void MX_NVIC_Init(void)
-{
-  /* EXTI3_IRQn interrupt configuration */
-  HAL_NVIC_SetPriority(EXTI3_IRQn, 0, 0);
-  HAL_NVIC_EnableIRQ(EXTI3_IRQn);
-  /* USART1_IRQn interrupt configuration */
-  HAL_NVIC_SetPriority(USART1_IRQn, 0, 0);
-  HAL_NVIC_EnableIRQ(USART1_IRQn);
-  /* DMA2_Stream2_IRQn interrupt configuration */
-  HAL_NVIC_SetPriority(DMA2_Stream2_IRQn, 0, 0);
-  HAL_NVIC_EnableIRQ(DMA2_Stream2_IRQn);
-  /* TIM1_UP_TIM10_IRQn interrupt configuration */
-  HAL_NVIC_SetPriority(TIM1_UP_TIM10_IRQn, 0, 0);
-  HAL_NVIC_EnableIRQ(TIM1_UP_TIM10_IRQn);
-}
-
-/* USER CODE BEGIN 4 */
-#if (JDY09_UART_RX_IT == 1)
-void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart)
-{
-
-	// Callback from BT module
-	JDY09_RxCpltCallbackIT(&JDY09_1, huart);
-}
-#endif
-
-#if (JDY09_UART_RX_DMA == 1)
-void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *huart, uint16_t Size)
-{
-	// Callback from BT module
-	JDY09_RxCpltCallbackDMA(&JDY09_1, huart, Size);
-}
-#endif
-
-void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin)
-{
-	// Callback from EXTI
-	JDY09_EXTICallback(&JDY09_1, GPIO_Pin);
-}
-
-void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim)
-{
-	if(htim->Instance == TIM1)
-	{
-		TimerCount10ms++;
-	}
-}
-/* USER CODE END 4 */
-
-/**
-  * @brief  This function is executed in case of error occurrence.
-  * @retval None
-  */
-void Error_Handler(void)
-{
-  /* USER CODE BEGIN Error_Handler_Debug */
-	/* User can add his own implementation to report the HAL error return state */
-	__disable_irq();
-	while (1)
-	{
-	}
-  /* USER CODE END Error_Handler_Debug */
-}
-
-#ifdef  USE_FULL_ASSERT
-/**
-  * @brief  Reports the name of the source file and the source line number
-  *         where the assert_param error has occurred.
-  * @param  file: pointer to the source file name
-  * @param  line: assert_param error line source number
-  * @retval None
-  */
-void assert_failed(uint8_t *file, uint32_t line)
-{
-  /* USER CODE BEGIN 6 */
-  /* User can add his own implementation to report the file name and line number,
-     ex: printf("Wrong parameters value: file %s on line %d\r\n", file, line) */
-  /* USER CODE END 6 */
-}
-#endif /* USE_FULL_ASSERT */
-
-/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
+/* USER CODE BEGIN Header */
+/**
+ ******************************************************************************
+ * @file           : main.c
+ * @brief          : Main program body
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2021 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+/* USER CODE END Header */
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include "dma.h"
+#include "i2c.h"
+#include "tim.h"
+#include "usart.h"
+#include "gpio.h"
+
+/* Private includes ----------------------------------------------------------*/
+/* USER CODE BEGIN Includes */
+#include "ringbuffer.h"
+#include "parse.h"
+#include "string.h"
+#include "JDY-09.h"
+#include "utils.h"
+#include "tmp102.h"
+#include "tmp102_array.h"
+#include "display.h"
+#include "pages.h"
+#include "log.h"
+#include "report.h"
+#include "flashlog.h"
+#include "clockgov.h"
+#include "memstat.h"
+#include "pool.h"
+#include "crash.h"
+#include "supervisor.h"
+#include "i2cbus.h"
+/* USER CODE END Includes */
+
+/* Private typedef -----------------------------------------------------------*/
+/* USER CODE BEGIN PTD */
+
+/* USER CODE END PTD */
+
+/* Private define ------------------------------------------------------------*/
+/* USER CODE BEGIN PD */
+// 1 - no periodic reading, only ALERT events are sent
+#define TMP102_ALARM_ONLY			0
+// alert thresholds in thousandths of deg C
+#define TMP102_ALERT_LOW_TEMP		26000
+#define TMP102_ALERT_HIGH_TEMP		30000
+// maximum time between check ins of supervised tasks in ms
+#define MAINLOOP_DEADLINE			3000
+#define SENSORS_DEADLINE			2000
+#define BLUETOOTH_DEADLINE			2000
+#define TERMINAL_DEADLINE			2000
+/* USER CODE END PD */
+
+/* Private macro -------------------------------------------------------------*/
+/* USER CODE BEGIN PM */
+
+/* USER CODE END PM */
+
+/* Private variables ---------------------------------------------------------*/
+
+/* USER CODE BEGIN PV */
+// addresses probed before first measurement, all sensor drivers
+uint8_t SensorAddresses[SENSOR_MAX_ACTIVE];
+uint8_t ParseStatus;
+// supervised tasks
+uint8_t TaskMainLoop;
+uint8_t TaskSensors;
+uint8_t TaskBluetooth;
+uint8_t TaskTerminal;
+JDY09_t JDY09_1;
+TMP102Array_t TMP102Array_1;
+Display_t Display_1;
+uint8_t temperaturevalue[2];
+TMP102AlertEvent_t AlertEvents[TMP102_ARRAY_MAX_SENSORS];
+/* USER CODE END PV */
+
+/* Private function prototypes -----------------------------------------------*/
+void SystemClock_Config(void);
+static void MX_NVIC_Init(void);
+/* USER CODE BEGIN PFP */
+
+/* USER CODE END PFP */
+
+/* Private user code ---------------------------------------------------------*/
+/* USER CODE BEGIN 0 */
+
+/* USER CODE END 0 */
+
+/**
+  * @brief  The application entry point.
+  * @retval int
+  */
+int main(void)
+{
+  /* USER CODE BEGIN 1 */
+	// fill free stack, MEM; command reports its high water mark
+	MemStat_PaintStack();
+  /* USER CODE END 1 */
+
+  /* MCU Configuration--------------------------------------------------------*/
+
+  /* Reset of all peripherals, Initializes the Flash interface and the Systick. */
+  HAL_Init();
+
+  /* USER CODE BEGIN Init */
+	// message buffers of all modules are taken from pool
+	Pool_Init();
+
+  /* USER CODE END Init */
+
+  /* Configure the system clock */
+  SystemClock_Config();
+
+  /* USER CODE BEGIN SysInit */
+
+  /* USER CODE END SysInit */
+
+  /* Initialize all configured peripherals */
+  MX_GPIO_Init();
+  MX_USART2_UART_Init();
+  MX_DMA_Init();
+  MX_USART1_UART_Init();
+  MX_I2C1_Init();
+  MX_TIM1_Init();
+
+  /* Initialize interrupts */
+  MX_NVIC_Init();
+  /* USER CODE BEGIN 2 */
+	// record of crash before reset goes to log and later to master
+	Crash_Init();
+
+	// scan only sensor addresses in background, bluetooth init runs meanwhile
+	I2CScanStart(&hi2c1, SensorAddresses,
+			Sensor_GetAddresses(SensorAddresses, SENSOR_MAX_ACTIVE));
+	JDY09_Init(&JDY09_1, &huart1, BT_STATE_GPIO_Port, BT_STATE_Pin);
+	JDY09_SetBaudRate(&JDY09_1, JDY09_BAUDRATE_115200);
+	Parser_Init(&JDY09_1);
+
+	// i2c bus has to be free for sensor init
+	uint32_t ScanTime = HAL_GetTick();
+	while (I2CScanIsBusy() && (HAL_GetTick() - ScanTime) < 100)
+	{
+	}
+	TMP102ArrayInit(&TMP102Array_1, &hi2c1);
+	// fast mode cuts bus time of every read, bus stays at 100 kHz if self-test fails
+	TMP102ArraySelectSpeed(&TMP102Array_1, I2CBUS_SPEED_FAST);
+	// log stays off when its sectors can not be used
+	uint8_t FlashLogStatus = FlashLog_Init();
+	if (FlashLogStatus != FLASHLOG_OK)
+	{
+		LOG_ERROR(LOG_MSG_FLASHLOG_OFF, (unsigned long) FlashLogStatus);
+	}
+	uint32_t FlashLogTime = HAL_GetTick();
+	TMP102ArrayConfigureAlert(&TMP102Array_1, TMP102_ALERT_Pin,
+			TMP102_ALERT_LOW_TEMP, TMP102_ALERT_HIGH_TEMP);
+#if (TMP102_ALARM_ONLY == 0)
+	// sample rate is low, so sensors convert only when read
+	TMP102ArraySetOneShot(&TMP102Array_1, 1);
+	// read period follows temperature changes
+	TMP102ArraySetAdaptive(&TMP102Array_1, 1);
+	TMP102ArrayStartRead(&TMP102Array_1);
+#endif
+	Display_Init(&Display_1, &TM1637_Display);
+	Pages_Init();
+	ClockGov_Init();
+
+	// from now IWDG resets node when any task stops checking in
+	TaskMainLoop = Supervisor_Register("MAINLOOP", MAINLOOP_DEADLINE);
+	TaskSensors = Supervisor_Register("SENSORS", SENSORS_DEADLINE);
+	TaskBluetooth = Supervisor_Register("BLUETOOTH", BLUETOOTH_DEADLINE);
+	TaskTerminal = Supervisor_Register("TERMINAL", TERMINAL_DEADLINE);
+	Supervisor_Start();
+
+	// received line is moved here before parsing, block is kept for whole run
+	uint8_t *TransferBuffer = Pool_Alloc(JDY09_MAX_LINE_LENGHT + 2);
+	if (TransferBuffer == NULL)
+	{
+		Error_Handler();
+	}
+
+  /* USER CODE END 2 */
+
+  /* Infinite loop */
+  /* USER CODE BEGIN WHILE */
+	while (1)
+	{
+		// loop is running, blocking parts have to end before deadline
+		Supervisor_CheckIn(TaskMainLoop);
+
+		// check if there is msg - if yes transfer it to transfer buffer
+		if (JDY09_CheckPendingMessages(&JDY09_1, TransferBuffer) == JDY09_MESSAGEPENDING)
+		{
+			//clear pending flag
+			JDY09_ClearMsgPendingFlag(&JDY09_1);
+
+			//parse msg and queue commands
+			ParseStatus = Parser_Parse(TransferBuffer);
+		}
+
+		// execute one queued command
+		Parser_Execute(&TMP102Array_1);
+
+		// read all temperature sensors in one DMA chain
+		TMP102ArrayProcess(&TMP102Array_1);
+
+		// boot to first measurement, recorded once
+		if (TMP102Array_1.SensorCount > 0 && TMP102Array_1.Sensors[0].HistoryCount > 0)
+		{
+			Supervisor_MarkFirstSample();
+		}
+
+		// bus error from DMA chain is recovered when peripheral is free
+		I2CBus_Process(&hi2c1);
+
+		// DMA chain which never finishes means hung I2C bus
+		if (!TMP102ArrayIsBusy(&TMP102Array_1))
+		{
+			Supervisor_CheckIn(TaskSensors);
+		}
+
+		// threshold crossings have own queue, they go out at once without pacing
+		uint8_t AlertCount = TMP102ArrayCheckAlert(&TMP102Array_1, AlertEvents);
+		for (uint8_t i = 0; i < AlertCount; i++)
+		{
+			Report_Queue(AlertEvents[i].Type, AlertEvents[i].Address,
+					&AlertEvents[i].Sample);
+		}
+
+		// store newest samples in flash, history survives reset
+		if (FlashLogStatus == FLASHLOG_OK
+				&& (HAL_GetTick() - FlashLogTime) >= FLASHLOG_PERIOD)
+		{
+			FlashLogTime = HAL_GetTick();
+			TMP102Sample_t LogSample;
+			for (uint8_t i = 0; i < TMP102Array_1.SensorCount; i++)
+			{
+				// stale sensor would log its old sample again
+				if (!TMP102ArrayIsStale(&TMP102Array_1, i)
+						&& TMP102ArrayGetHistory(&TMP102Array_1, i, &LogSample, 1))
+				{
+					FlashLog_Append(TMP102Array_1.Sensors[i].Sensor.Address,
+							&LogSample);
+				}
+			}
+		}
+
+		// queue readings that passed reporting policy, kept while master is away
+		TMP102Sample_t ReportSample;
+		for (uint8_t i = 0; i < TMP102Array_1.SensorCount; i++)
+		{
+			if (Report_Check(&TMP102Array_1, i, &ReportSample))
+			{
+				Report_Queue(TMP102_ALERT_NONE,
+						TMP102Array_1.Sensors[i].Sensor.Address,
+						&ReportSample);
+			}
+		}
+
+		// send telemetry, after reconnect backlog is replayed in paced frames
+		if (JDY09_IsConnected(&JDY09_1))
+		{
+			// crash before last reset is reported first
+			if (Crash_IsReportPending())
+			{
+				Parser_SendCrash();
+			}
+			Parser_SendReports();
+		}
+
+		// start next queued bluetooth frame
+		JDY09_TxProcess(&JDY09_1);
+
+		// send one log record to terminal
+		Log_Process();
+
+		// transmissions which never finish block both links
+		if (huart1.gState == HAL_UART_STATE_READY)
+		{
+			Supervisor_CheckIn(TaskBluetooth);
+		}
+		if (huart2.gState == HAL_UART_STATE_READY)
+		{
+			Supervisor_CheckIn(TaskTerminal);
+		}
+
+		// PLL only for commands, dump and replay of backlog, HSI otherwise
+		ClockGov_Process(Parser_IsBusy()
+				|| (JDY09_IsConnected(&JDY09_1)
+						&& Report_GetBacklog() > REPORT_REPLAY_CHUNK));
+
+		// pages rotated after DISPLAY command, only changed frames are written
+		Pages_Process(&Display_1, &TMP102Array_1, JDY09_IsConnected(&JDY09_1));
+
+
+    /* USER CODE END WHILE */
+
+    /* USER CODE BEGIN 3 */
+	}
+  /* USER CODE END 3 */
+}
+
+/**
+  * @brief System Clock Configuration
+  * @retval None
+  */
+void SystemClock_Config(void)
+{
+  RCC_OscInitTypeDef RCC_OscInitStruct = {0};
+  RCC_ClkInitTypeDef RCC_ClkInitStruct = {0};
+
+  /** Configure the main internal regulator output voltage
+  */
+  __HAL_RCC_PWR_CLK_ENABLE();
+  __HAL_PWR_VOLTAGESCALING_CONFIG(PWR_REGULATOR_VOLTAGE_SCALE2);
+  /** Initializes the RCC Oscillators according to the specified parameters
+  * in the RCC_OscInitTypeDef structure.
+  */
+  RCC_OscInitStruct.OscillatorType = RCC_OSCILLATORTYPE_HSI;
+  RCC_OscInitStruct.HSIState = RCC_HSI_ON;
+  RCC_OscInitStruct.HSICalibrationValue = RCC_HSICALIBRATION_DEFAULT;
+  RCC_OscInitStruct.PLL.PLLState = RCC_PLL_ON;
+  RCC_OscInitStruct.PLL.PLLSource = RCC_PLLSOURCE_HSI;
+  RCC_OscInitStruct.PLL.PLLM = 16;
+  RCC_OscInitStruct.PLL.PLLN = 336;
+  RCC_OscInitStruct.PLL.PLLP = RCC_PLLP_DIV4;
+  RCC_OscInitStruct.PLL.PLLQ = 7;
+  if (HAL_RCC_OscConfig(&RCC_OscInitStruct) != HAL_OK)
+  {
+    Error_Handler();
+  }
+  /** Initializes the CPU, AHB and APB buses clocks
+  */
+  RCC_ClkInitStruct.ClockType = RCC_CLOCKTYPE_HCLK|RCC_CLOCKTYPE_SYSCLK
+                              |RCC_CLOCKTYPE_PCLK1|RCC_CLOCKTYPE_PCLK2;
+  RCC_ClkInitStruct.SYSCLKSource = RCC_SYSCLKSOURCE_PLLCLK;
+  RCC_ClkInitStruct.AHBCLKDivider = RCC_SYSCLK_DIV1;
+  RCC_ClkInitStruct.APB1CLKDivider = RCC_HCLK_DIV2;
+  RCC_ClkInitStruct.APB2CLKDivider = RCC_HCLK_DIV1;
+
+  if (HAL_RCC_ClockConfig(&RCC_ClkInitStruct, FLASH_LATENCY_2) != HAL_OK)
+  {
+    Error_Handler();
+  }
+}
+
+/**
+  * @brief NVIC Configuration.
+  * @retval None
+  */
+static void MX_NVIC_Init(void)
+{
+  /* EXTI3_IRQn interrupt configuration */
+  HAL_NVIC_SetPriority(EXTI3_IRQn, 0, 0);
+  HAL_NVIC_EnableIRQ(EXTI3_IRQn);
+  /* DMA1_Stream0_IRQn interrupt configuration */
+  HAL_NVIC_SetPriority(DMA1_Stream0_IRQn, 0, 0);
+  HAL_NVIC_EnableIRQ(DMA1_Stream0_IRQn);
+  /* EXTI9_5_IRQn interrupt configuration */
+  HAL_NVIC_SetPriority(EXTI9_5_IRQn, 0, 0);
+  HAL_NVIC_EnableIRQ(EXTI9_5_IRQn);
+  /* USART1_IRQn interrupt configuration */
+  HAL_NVIC_SetPriority(USART1_IRQn, 0, 0);
+  HAL_NVIC_EnableIRQ(USART1_IRQn);
+  /* USART2_IRQn interrupt configuration */
+  HAL_NVIC_SetPriority(USART2_IRQn, 0, 0);
+  HAL_NVIC_EnableIRQ(USART2_IRQn);
+  /* DMA2_Stream2_IRQn interrupt configuration */
+  HAL_NVIC_SetPriority(DMA2_Stream2_IRQn, 0, 0);
+  HAL_NVIC_EnableIRQ(DMA2_Stream2_IRQn);
+  /* DMA2_Stream7_IRQn interrupt configuration */
+  HAL_NVIC_SetPriority(DMA2_Stream7_IRQn, 0, 0);
+  HAL_NVIC_EnableIRQ(DMA2_Stream7_IRQn);
+  /* I2C1_EV_IRQn interrupt configuration */
+  HAL_NVIC_SetPriority(I2C1_EV_IRQn, 0, 0);
+  HAL_NVIC_EnableIRQ(I2C1_EV_IRQn);
+  /* I2C1_ER_IRQn interrupt configuration */
+  HAL_NVIC_SetPriority(I2C1_ER_IRQn, 0, 0);
+  HAL_NVIC_EnableIRQ(I2C1_ER_IRQn);
+  /* TIM1_UP_TIM10_IRQn interrupt configuration */
+  HAL_NVIC_SetPriority(TIM1_UP_TIM10_IRQn, 0, 0);
+  HAL_NVIC_EnableIRQ(TIM1_UP_TIM10_IRQn);
+}
+
+/* USER CODE BEGIN 4 */
+#if (JDY09_UART_RX_IT == 1)
+void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart)
+{
+
+	// Callback from BT module
+	JDY09_RxCpltCallbackIT(&JDY09_1, huart);
+}
+#endif
+
+#if (JDY09_UART_RX_DMA == 1)
+void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *huart, uint16_t Size)
+{
+	// Callback from BT module
+	JDY09_RxCpltCallbackDMA(&JDY09_1, huart, Size);
+}
+#endif
+
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart)
+{
+	// Callback from bluetooth transmit queue
+	JDY09_TxCpltCallback(&JDY09_1, huart);
+	// Callback from terminal log
+	Log_TxCpltCallback(huart);
+}
+
+void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin)
+{
+	// Callback from EXTI
+	JDY09_EXTICallback(&JDY09_1, GPIO_Pin);
+	// Callback from TMP102 ALERT line
+	TMP102Array_EXTICallback(&TMP102Array_1, GPIO_Pin);
+}
+
+void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+	// Callback from background i2c scan
+	I2CScan_TxCpltCallback(hi2c);
+}
+
+void HAL_I2C_MemRxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+	// Callback from temperature sensors DMA chain
+	TMP102Array_MemRxCpltCallback(&TMP102Array_1, hi2c);
+}
+
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c)
+{
+	// Callback from bus guard, first so others know if bus waits for recovery
+	I2CBus_ErrorCallback(hi2c);
+	// Callback from background i2c scan
+	I2CScan_ErrorCallback(hi2c);
+	// Callback from temperature sensors DMA chain
+	TMP102Array_ErrorCallback(&TMP102Array_1, hi2c);
+}
+
+void HAL_FLASH_EndOfOperationCallback(uint32_t ReturnValue)
+{
+	// Callback from flash log background erase
+	FlashLog_EraseCpltCallback();
+}
+
+void HAL_FLASH_OperationErrorCallback(uint32_t ReturnValue)
+{
+	// Callback from flash log background erase
+	FlashLog_EraseErrorCallback();
+}
+
+void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim)
+{
+	if(htim->Instance == TIM1)
+	{
+		Pages_Tick();
+	}
+}
+/* USER CODE END 4 */
+
+/**
+  * @brief  This function is executed in case of error occurrence.
+  * @retval None
+  */
+void Error_Handler(void)
+{
+  /* USER CODE BEGIN Error_Handler_Debug */
+	/* User can add his own implementation to report the HAL error return state */
+	// caller is stored for next boot and MCU is reset
+	Crash_Error((uint32_t) __builtin_return_address(0));
+	__disable_irq();
+	while (1)
+	{
+	}
+  /* USER CODE END Error_Handler_Debug */
+}
+
+#ifdef  USE_FULL_ASSERT
+/**
+  * @brief  Reports the name of the source file and the source line number
+  *         where the assert_param error has occurred.
+  * @param  file: pointer to the source file name
+  * @param  line: assert_param error line source number
+  * @retval None
+  */
+void assert_failed(uint8_t *file, uint32_t line)
+{
+  /* USER CODE BEGIN 6 */
+  /* User can add his own implementation to report the file name and line number,
+     ex: printf("Wrong parameters value: file %s on line %d\r\n", file, line) */
+  /* USER CODE END 6 */
+}
+#endif /* USE_FULL_ASSERT */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
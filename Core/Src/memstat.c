@@ -0,0 +1,123 @@
+/*
+ * memstat.c
+ *
+ *  Created on: 19 October 2026
+ */
+
+/* RAM budget of the firmware.
+ *
+ * Static part is read from linker symbols. Tools/memreport.py gives per module split
+ * from the .map file of the build and stack of every function from .su files
+ * (-fstack-usage). Heap is not planned, _sbrk reports every request here, with
+ * MEMSTAT_HEAP_TRAP first request stops in Error_Handler so the caller can be found
+ * in debugger. Text is formatted and parsed without %f, strtod and strtok, they can take heap.
+ *
+ * Reserved stack is painted before HAL_Init, MEM; command reports how deep
+ * the stack has grown since boot.
+ */
+
+#include "main.h"
+#include "memstat.h"
+
+// Symbols defined in the linker script
+extern uint8_t _sdata;
+extern uint8_t _edata;
+extern uint8_t _sbss;
+extern uint8_t _ebss;
+extern uint8_t _end;
+extern uint8_t _estack;
+extern uint32_t _Min_Stack_Size;
+
+extern void *_sbrk(ptrdiff_t incr);
+
+static uint32_t HeapRequests;
+
+/*
+ * Lowest address of reserved stack
+ *
+ * @return - address
+ */
+static uint32_t *MemStat_StackLimit(void)
+{
+	return (uint32_t*) ((uint32_t) &_estack - (uint32_t) &_Min_Stack_Size);
+}
+
+/*
+ * Fill unused part of reserved stack with MEMSTAT_STACK_PAINT.
+ * Call first in main, before any interrupt is enabled.
+ *
+ * @return - void
+ */
+void MemStat_PaintStack(void)
+{
+	uint32_t *Word = MemStat_StackLimit();
+	uint32_t *Top = (uint32_t*) (__get_MSP() - MEMSTAT_PAINT_MARGIN);
+
+	while (Word < Top)
+	{
+		*Word++ = MEMSTAT_STACK_PAINT;
+	}
+}
+
+/*
+ * Deepest stack use since boot, equal to reserved size means stack overflowed
+ *
+ * @return - bytes
+ */
+uint32_t MemStat_GetStackHighWater(void)
+{
+	uint32_t *Word = MemStat_StackLimit();
+	uint32_t *Top = (uint32_t*) &_estack;
+
+	// words below deepest use are still painted
+	while (Word < Top && *Word == MEMSTAT_STACK_PAINT)
+	{
+		Word++;
+	}
+
+	return (uint32_t) Top - (uint32_t) Word;
+}
+
+/*
+ * Called by _sbrk for every heap request
+ *
+ * @param[Incr] - requested bytes
+ * @return - void
+ */
+void MemStat_HeapRequest(ptrdiff_t Incr)
+{
+	if (Incr <= 0)
+	{
+		return;
+	}
+
+	HeapRequests++;
+
+#if (MEMSTAT_HEAP_TRAP == 1)
+	Error_Handler();
+#endif
+}
+
+/*
+ * Fill RAM usage
+ *
+ * @param[*Usage] - structure to fill
+ * @return - void
+ */
+void MemStat_GetUsage(MemStat_Usage_t *Usage)
+{
+	// .data is placed first in RAM
+	Usage->Total = (uint32_t) &_estack - (uint32_t) &_sdata;
+	Usage->Data = (uint32_t) &_edata - (uint32_t) &_sdata;
+	Usage->Bss = (uint32_t) &_ebss - (uint32_t) &_sbss;
+
+	// zero size request only returns end of heap
+	Usage->Heap = (uint32_t) _sbrk(0) - (uint32_t) &_end;
+	Usage->HeapRequests = HeapRequests;
+
+	Usage->StackReserved = (uint32_t) &_Min_Stack_Size;
+	Usage->StackUsed = MemStat_GetStackHighWater();
+
+	Usage->Free = Usage->Total - Usage->Data - Usage->Bss - Usage->Heap
+			- Usage->StackReserved;
+}
@@ -0,0 +1,367 @@
+/*
+ * pages.c
+ *
+ *  Created on: 19 October 2026
+ */
+
+/* Pages rotated on segment display.
+ *
+ * DISPLAY command starts rotation for PAGES_SHOW_TIME, every page shows its name first
+ * and then its value for its dwell time. TIM1 interrupt only counts ticks, pages are
+ * drawn from main loop by Pages_Process, display writes only changed frames.
+ *
+ * Minimum, maximum and average of first sensor are counted since boot from its history,
+ * also while rotation is not running.
+ *
+ * put Pages_Tick in HAL_TIM_PeriodElapsedCallback of TIM1
+ */
+
+#include "main.h"
+#include "string.h"
+#include "tim.h"
+#include "clockgov.h"
+#include "pages.h"
+
+static Pages_t Pages;
+
+// names used by PAGES command
+static const char *const Pages_Names[PAGES_COUNT] = {
+		"T", "MIN", "MAX", "AVG", "RATE", "LINK"
+};
+
+// names shown on display before value
+static const char *const Pages_Labels[PAGES_COUNT] = {
+		"t", "Lo", "Hi", "AVG", "rAtE", "bt"
+};
+
+/*
+ * TIM1 ticks of time, rounded down
+ */
+static uint32_t Pages_Ticks(uint32_t Time)
+{
+	return (uint32_t) (((uint64_t) Time * 1000) / Pages.TickTime);
+}
+
+/*
+ * Count new samples of first sensor to statistics
+ */
+static void Pages_UpdateStats(TMP102Array_t *TMP102Array)
+{
+	TMP102Sample_t History[TMP102_ARRAY_HISTORY_SIZE];
+	uint8_t Count;
+	uint8_t i;
+
+	if ((HAL_GetTick() - Pages.LastStats) < PAGES_STATS_PERIOD)
+	{
+		return;
+	}
+	Pages.LastStats = HAL_GetTick();
+
+	Count = TMP102ArrayGetHistory(TMP102Array, 0, History, TMP102_ARRAY_HISTORY_SIZE);
+
+	// history is newest first, count from oldest not counted yet
+	for (i = Count; i > 0; i--)
+	{
+		TMP102Sample_t *Sample = &History[i - 1];
+
+		if (Pages.Samples > 0 && (int32_t) (Sample->Timestamp - Pages.LastTimestamp) <= 0)
+		{
+			continue;
+		}
+
+		if (Pages.Samples == 0 || Sample->Value < Pages.Min)
+		{
+			Pages.Min = Sample->Value;
+		}
+		if (Pages.Samples == 0 || Sample->Value > Pages.Max)
+		{
+			Pages.Max = Sample->Value;
+		}
+		Pages.Sum += Sample->Value;
+		Pages.Samples++;
+		Pages.LastTimestamp = Sample->Timestamp;
+	}
+}
+
+/*
+ * Draw value of current page
+ */
+static void Pages_ShowValue(Display_t *Display, TMP102Array_t *TMP102Array, uint8_t LinkUp)
+{
+	Sensor_t *Sensor = TMP102ArrayGetSensor(TMP102Array, 0);
+	TMP102Sample_t Sample;
+	float Value;
+
+	switch (Pages.Pages[Pages.Current])
+	{
+	case PAGES_PAGE_TEMP:
+		if (TMP102ArrayIsStale(TMP102Array, 0)
+				|| TMP102ArrayGetHistory(TMP102Array, 0, &Sample, 1) == 0
+				|| Sensor_ToFloat(Sensor, Sample.Value, &Value) != SENSOR_OK)
+		{
+			Display_ShowText(Display, "----");
+			break;
+		}
+		Display_ShowFloat(Display, Value);
+		break;
+
+	case PAGES_PAGE_MIN:
+	case PAGES_PAGE_MAX:
+	case PAGES_PAGE_AVG:
+		// one count in units, average is in counts
+		if (Pages.Samples == 0 || Sensor_ToFloat(Sensor, 1, &Value) != SENSOR_OK)
+		{
+			Display_ShowText(Display, "----");
+		}
+		else if (Pages.Pages[Pages.Current] == PAGES_PAGE_MIN)
+		{
+			Display_ShowFloat(Display, Value * Pages.Min);
+		}
+		else if (Pages.Pages[Pages.Current] == PAGES_PAGE_MAX)
+		{
+			Display_ShowFloat(Display, Value * Pages.Max);
+		}
+		else
+		{
+			Display_ShowFloat(Display, Value * ((float) Pages.Sum / Pages.Samples));
+		}
+		break;
+
+	case PAGES_PAGE_RATE:
+		// 0 - reads are started by user only
+		if (TMP102Array->ReadPeriod == 0)
+		{
+			Display_ShowText(Display, "----");
+			break;
+		}
+		Display_ShowFloat(Display, 1000.0f / TMP102Array->ReadPeriod);
+		break;
+
+	case PAGES_PAGE_LINK:
+		Display_ShowText(Display, LinkUp ? "On" : "OFF");
+		break;
+	}
+}
+
+/*
+ * Default rotation, all pages
+ *
+ * @return - void
+ */
+void Pages_Init(void)
+{
+	memset(&Pages, 0, sizeof(Pages_t));
+
+	for (uint8_t i = 0; i < PAGES_COUNT; i++)
+	{
+		Pages.Pages[i] = i;
+		Pages.Dwell[i] = PAGES_DEFAULT_DWELL;
+	}
+	Pages.Count = PAGES_COUNT;
+}
+
+/*
+ * Set pages in rotation, running rotation starts again from first page
+ *
+ * @param[*List] - pages in order of rotation @page
+ * @param[*Dwell] - time on every page in s
+ * @param[Count] - number of pages
+ * @return - @status
+ */
+uint8_t Pages_Set(const uint8_t *List, const uint8_t *Dwell, uint8_t Count)
+{
+	uint8_t i;
+
+	if (Count == 0 || Count > PAGES_MAX_PAGES)
+	{
+		return PAGES_ERR_ARG;
+	}
+	for (i = 0; i < Count; i++)
+	{
+		if (List[i] >= PAGES_COUNT || Dwell[i] == 0 || Dwell[i] > PAGES_MAX_DWELL)
+		{
+			return PAGES_ERR_ARG;
+		}
+	}
+
+	memcpy(Pages.Pages, List, Count);
+	memcpy(Pages.Dwell, Dwell, Count);
+	Pages.Count = Count;
+
+	Pages.Current = 0;
+	Pages.PageStart = Pages.Ticks;
+	Pages.Label = 1;
+	Pages.Update = 1;
+
+	return PAGES_OK;
+}
+
+/*
+ * Pages in rotation
+ *
+ * @param[*List] - buffer for PAGES_MAX_PAGES pages
+ * @param[*Dwell] - buffer for PAGES_MAX_PAGES dwell times in s
+ * @return - number of pages
+ */
+uint8_t Pages_Get(uint8_t *List, uint8_t *Dwell)
+{
+	memcpy(List, Pages.Pages, Pages.Count);
+	memcpy(Dwell, Pages.Dwell, Pages.Count);
+
+	return Pages.Count;
+}
+
+/*
+ * Page with name
+ *
+ * @param[*Name] - name, does not have to end with 0
+ * @param[Lenght] - lenght of name
+ * @return - @page or PAGES_NONE
+ */
+uint8_t Pages_Find(const char *Name, uint8_t Lenght)
+{
+	for (uint8_t i = 0; i < PAGES_COUNT; i++)
+	{
+		if (strlen(Pages_Names[i]) == Lenght && strncmp(Pages_Names[i], Name, Lenght) == 0)
+		{
+			return i;
+		}
+	}
+
+	return PAGES_NONE;
+}
+
+/*
+ * Name of page used by PAGES command
+ *
+ * @param[Page] - @page
+ * @return - name
+ */
+const char *Pages_Name(uint8_t Page)
+{
+	if (Page >= PAGES_COUNT)
+	{
+		return "?";
+	}
+
+	return Pages_Names[Page];
+}
+
+/*
+ * Start rotation from first page for PAGES_SHOW_TIME
+ *
+ * @return - void
+ */
+void Pages_Start(void)
+{
+	// update event comes every Period + 1 counts
+	Pages.TickTime = (htim1.Init.Period + 1) * (1000000 / CLOCKGOV_TIM1_TICK);
+	Pages.Ticks = 0;
+	Pages.Current = 0;
+	Pages.PageStart = 0;
+	Pages.Label = 1;
+	Pages.Update = 1;
+	Pages.Active = 1;
+
+	HAL_TIM_Base_Start_IT(&htim1);
+}
+
+/*
+ * Stop rotation, last page stays on display
+ *
+ * @return - void
+ */
+void Pages_Stop(void)
+{
+	HAL_TIM_Base_Stop_IT(&htim1);
+	Pages.Active = 0;
+}
+
+/*
+ * Check if pages are rotated
+ *
+ * @return - 1 rotation runs, 0 stopped
+ */
+uint8_t Pages_IsActive(void)
+{
+	return Pages.Active;
+}
+
+/*
+ * Count time of rotation, put in HAL_TIM_PeriodElapsedCallback of TIM1
+ *
+ * @return - void
+ */
+void Pages_Tick(void)
+{
+	if (Pages.Active)
+	{
+		Pages.Ticks++;
+	}
+}
+
+/*
+ * Switch pages and draw them, put in main loop
+ *
+ * @param[*Display] - display structure
+ * @param[*TMP102Array] - sensors shown on pages
+ * @param[LinkUp] - bluetooth connection state
+ * @return - void
+ */
+void Pages_Process(Display_t *Display, TMP102Array_t *TMP102Array, uint8_t LinkUp)
+{
+	uint32_t Now = Pages.Ticks;
+	uint32_t DwellTicks;
+	uint32_t LabelTicks;
+
+	Pages_UpdateStats(TMP102Array);
+
+	if (!Pages.Active)
+	{
+		return;
+	}
+
+	if (Now >= Pages_Ticks(PAGES_SHOW_TIME))
+	{
+		Pages_Stop();
+		return;
+	}
+
+	// name takes at most quarter of dwell
+	DwellTicks = Pages_Ticks(Pages.Dwell[Pages.Current] * 1000);
+	LabelTicks = Pages_Ticks(PAGES_LABEL_TIME);
+	if (LabelTicks > DwellTicks / 4)
+	{
+		LabelTicks = DwellTicks / 4;
+	}
+
+	// single page is not switched, its name is shown only at start
+	if ((Now - Pages.PageStart) >= DwellTicks && Pages.Count > 1)
+	{
+		Pages.Current = (Pages.Current + 1) % Pages.Count;
+		Pages.PageStart = Now;
+		Pages.Label = 1;
+		Pages.Update = 1;
+	}
+	else if (Pages.Label && (Now - Pages.PageStart) >= LabelTicks)
+	{
+		Pages.Label = 0;
+		Pages.Update = 1;
+	}
+
+	if (!Pages.Update && (Now - Pages.LastRefresh) < Pages_Ticks(PAGES_REFRESH))
+	{
+		return;
+	}
+	Pages.Update = 0;
+	Pages.LastRefresh = Now;
+
+	if (Pages.Label)
+	{
+		Display_ShowText(Display, Pages_Labels[Pages.Pages[Pages.Current]]);
+	}
+	else
+	{
+		Pages_ShowValue(Display, TMP102Array, LinkUp);
+	}
+}
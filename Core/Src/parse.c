@@ -1,249 +1,1407 @@
-/*
- * parse.c
- *
- *  Created on: 2 May, 2023
- *      Author: Ezrah Buki
- */
-
-#include "main.h"
-#include "string.h"
-#include "ringbuffer.h"
-#include "usart.h"
-#include "tim.h"
-#include "tmp102.h"
-#include "stdlib.h"
-#include "stdio.h"
-#include "parse.h"
-
-extern volatile uint32_t TimerCount10ms;
-
-void Parser_DisplayTerminal(char *Msg)
-{
-	uint8_t Lenght = strlen(Msg);
-	HAL_UART_Transmit(&huart1, (uint8_t*) Msg, Lenght, 1000);
-}
-
-
-void Parse_WriteDataToBuffer(Ringbuffer_t *RecieveBuffer, uint8_t *ParseBuffer)
-{
-	uint8_t i = 0;
-	uint8_t temp;
-	do
-	{
-		RB_Read(RecieveBuffer, &temp);
-		if (temp == ENDLINE)
-		{
-			ParseBuffer[i] = '\n';
-			ParseBuffer[i + 1] = 0;
-		}
-		else
-		{
-			ParseBuffer[i] = temp;
-		}
-		i++;
-	} while (temp != ENDLINE);
-}
-
-/*
- * @ WAKE UP procedure
- */
-static void Parser_WAKEUP(void)
-{
-	//wake up for 5 mins
-	Parser_DisplayTerminal("System wake up\n\r");
-
-}
-
-/*
- * @ MEASURE procedure
- */
-static void Parser_MEASURE(TMP102_t *TMP102)
-{
-	// send log to uart
-	Parser_DisplayTerminal("Measurment done :");
-
-
-	uint8_t Msg[32];
-#if (TMP102_USE_FLOATNUMBERS == 1)
-	float temperature;
-	temperature = TMP102GetTempFloat(TMP102);
-	sprintf((char*)Msg, " %2.2f deg C\n\r",temperature);
-#else
-
-	uint8_t TempBuffer[2];
-	TMP102GetTempInt(TMP102,buffer);
-	if (buffer[1] > 9)
-	{
-	sprintf((char*)Msg, " %d.%d deg C\n\r",TempBuffer[0],TempBuffer[1]);
-	}
-	else
-	{
-	sprintf((char*)Msg, " %d.0%d deg C\n\r",TempBuffer[0],TempBuffer[1]);
-	}
-
-#endif
-
-	Parser_DisplayTerminal((char*)Msg);
-	return;
-
-	//bluetooth send to master
-}
-
-/*
- * @ DISPLAY procedure
- */
-static void Parser_DISPLAY(void)
-{
-	// send log to uart
-	Parser_DisplayTerminal("Temperature displayed for 1 minute \n\r");
-
-	// start timer
-	TimerCount10ms = 0;
-	HAL_TIM_Base_Start_IT(&htim1);
-}
-
-static void Parser_HELP(void)
-{
-	// send log to uart
-	Parser_DisplayTerminal("WAKEUP; - wake up from sleep mode \n\r");
-	Parser_DisplayTerminal("MEASURE; - measure and send to terminal \n\r");
-	Parser_DisplayTerminal("DISPLAY; - start measuring and display on 8segment \n\r");
-	Parser_DisplayTerminal("SLEEP; - enter sleep mode \n\r");
-	Parser_DisplayTerminal("HELP; - print all commands \n\r");
-
-}
-
-/*
- * @ SLEEP procedure
- */
-static void Parser_SLEEP(uint8_t *ParseBuffer)
-{
-	//execute sleep
-
-	//stop timer
-	HAL_TIM_Base_Stop_IT(&htim1);
-
-	//delete all the commands after SLEEP
-	memset(ParseBuffer,0,(sizeof(ParseBuffer)));
-
-	//send log on uart
-	Parser_DisplayTerminal("Entering sleep mode\n\r");
-
-	//stop hal tick
-	HAL_SuspendTick();
-
-	//enter sleep mode -> it will wait for IRQ to wake up
-	HAL_PWR_EnterSLEEPMode(PWR_MAINREGULATOR_ON, PWR_SLEEPENTRY_WFI);
-
-	//after wake up continue tick
-	HAL_ResumeTick();
-
-	//send log on uart
-	Parser_DisplayTerminal("Waking up...\n\r");
-
-	//start count down for going back to sleep
-	HAL_TIM_Base_Start_IT(&htim1);
-
-}
-
-
-/*
- * @ function parse message and start command procedures
- */
-
-uint8_t Parser_Parse(uint8_t *ParseBuffer, TMP102_t *TMP102)
-{
-	// Count how many commands we have to parse
-	uint8_t cmd_count = 0;
-	uint8_t i = 0;
-	uint8_t LastCommand[16] =  {0};
-
-	// For every semicolon count up until EOL
-	do
-	{
-		if (ParseBuffer[i] == ';')
-		{
-			cmd_count++;
-		}
-		i++;
-	} while (ParseBuffer[i] != '\n');
-
-
-	// if there is no msg that we want to parse then just send it
-
-	if (cmd_count == 0)
-	{
-		Parser_DisplayTerminal("Message received :");
-		Parser_DisplayTerminal((char*)ParseBuffer);
-		// return ERROR
-		return PARSE_ERROR_NOCMD;
-	}
-
-
-	uint8_t *ParsePointer;
-
-	// Execute cmd_count number of commands
-	for (i = 0; i < cmd_count; i++)
-	{
-
-		// cut command from the message -> from beginning to ;
-		//if first msg start from beginning
-		if(i == 0)
-		{
-			ParsePointer = (uint8_t*)(strtok((char*)ParseBuffer, ";"));
-
-		}else
-		{
-			ParsePointer = (uint8_t*)(strtok(NULL, ";"));
-		}
-
-
-		// if you put two same commands in a row - error
-		if(strcmp((char*)ParsePointer,(char*)LastCommand) == 0)
-		{
-			Parser_DisplayTerminal("Error, same command twice in a row!\n\r");
-			return PARSE_ERROR_2CMDS;
-		}
-
-		/*
-		 * EXECUTE COMMANDS
-		 */
-
-		// do WAKE_UP
-		if (strcmp("WAKEUP", (char*)ParsePointer) == 0)
-		{
-			Parser_WAKEUP();
-		}
-		// do MEASURE
-		else if (strcmp("MEASURE", (char*)ParsePointer) == 0)
-		{
-			Parser_MEASURE(TMP102);
-		}
-		// do DISPLAY
-		else if (strcmp("DISPLAY", (char*)ParsePointer) == 0)
-		{
-			Parser_DISPLAY();
-		}
-		//do help
-		else if (strcmp("HELP", (char*)ParsePointer) == 0)
-		{
-			Parser_HELP();
-		}
-		// do SLEEP
-		else if (strcmp("SLEEP", (char*)ParsePointer) == 0)
-		{
-			Parser_SLEEP(ParsePointer);
-			return PARSE_OK;
-		}
-		else
-		{
-			Parser_DisplayTerminal("Commmand unknown \n\r");
-			Parser_HELP();
-			return PARSE_ERROR_NOCMD;
-		}
-
-		strcpy((char*)LastCommand,(char*)ParsePointer);
-	}
-
-	return PARSE_OK;
-}
+/*
+ * parse.c
+ *
+ *  Created on: 2 May, 2023
+ *      Author: Ezrah Buki
+ */
+
+#include "main.h"
+#include "string.h"
+#include "ringbuffer.h"
+#include "usart.h"
+#include "tmp102_array.h"
+#include "stdlib.h"
+#include "stdio.h"
+#include "parse.h"
+#include "report.h"
+#include "encode.h"
+#include "flashlog.h"
+#include "clockgov.h"
+#include "memstat.h"
+#include "pool.h"
+#include "crash.h"
+#include "supervisor.h"
+#include "i2cbus.h"
+#include "pages.h"
+
+// response frames are pool blocks, one is filled while others wait in transmit queue of JDY-09
+static uint8_t *ResponseFrame;
+static uint16_t ResponseLenght;
+static JDY09_t *Parser_JDY09;
+// part of response since last flush was not sent
+static uint8_t ResponseLost;
+// messages lost because no frame was free in pool
+static uint32_t ResponseAllocFailed;
+
+// commands waiting for execution
+static Parser_CmdQueue_t CmdQueue;
+
+// flash log records still to send by DUMP
+static uint32_t DumpNext;
+static uint32_t DumpEnd;
+
+/*
+ * Add message to response frame, frame is sent at the end of parsed line
+ * or when buffer is full. Message is lost when no frame is free in pool.
+ *
+ * @param[*Msg] - string to send
+ * @return - void
+ */
+void Parser_DisplayTerminal(char *Msg)
+{
+	uint16_t Lenght = strlen(Msg);
+	uint16_t Chunk;
+
+	while (Lenght > 0)
+	{
+		// no place left - send what we have, final flush reports if it failed
+		if (ResponseLenght == PARSE_RESPONSE_BUFFER_SIZE
+				&& Parser_FlushResponse() != PARSE_OK)
+		{
+			ResponseLost = 1;
+		}
+
+		if (ResponseFrame == NULL)
+		{
+			ResponseFrame = Pool_Alloc(PARSE_RESPONSE_BUFFER_SIZE);
+			// all frames wait for transmission, sending them gives blocks back
+			if (ResponseFrame == NULL
+					&& JDY09_WaitTxIdle(Parser_JDY09, PARSE_UART_TIMEOUT) == JDY09_OK)
+			{
+				ResponseFrame = Pool_Alloc(PARSE_RESPONSE_BUFFER_SIZE);
+			}
+			if (ResponseFrame == NULL)
+			{
+				ResponseAllocFailed++;
+				ResponseLost = 1;
+				return;
+			}
+		}
+
+		Chunk = PARSE_RESPONSE_BUFFER_SIZE - ResponseLenght;
+		if (Chunk > Lenght)
+		{
+			Chunk = Lenght;
+		}
+
+		memcpy(&ResponseFrame[ResponseLenght], Msg, Chunk);
+		ResponseLenght += Chunk;
+		Msg += Chunk;
+		Lenght -= Chunk;
+	}
+}
+
+/*
+ * Queue collected response frame for transmission in one DMA transfer.
+ * Frame is dropped only when the queue stays full for PARSE_UART_TIMEOUT,
+ * it is counted in transmit statistics of JDY-09.
+ *
+ * @return - PARSE_OK everything since last flush was queued, PARSE_BUSY part was lost
+ */
+uint8_t Parser_FlushResponse(void)
+{
+	uint8_t Status = ResponseLost ? PARSE_BUSY : PARSE_OK;
+
+	ResponseLost = 0;
+	if (ResponseLenght == 0)
+	{
+		return Status;
+	}
+
+	if (JDY09_Transmit(Parser_JDY09, ResponseFrame, ResponseLenght,
+			PARSE_UART_TIMEOUT) != JDY09_OK)
+	{
+		Status = PARSE_BUSY;
+	}
+	JDY09_TxProcess(Parser_JDY09);
+
+	// next messages go to a new frame
+	ResponseFrame = NULL;
+	ResponseLenght = 0;
+
+	return Status;
+}
+
+/*
+ * Bind parser to bluetooth module, responses are sent through its transmit queue
+ *
+ * @param[*jdy09] - pointer to struct for JDY09 bluetooth module
+ * @return - void
+ */
+void Parser_Init(JDY09_t *jdy09)
+{
+	Parser_JDY09 = jdy09;
+}
+
+/*
+ * Move one line from ring buffer to parse buffer.
+ * Line longer than parse buffer is truncated, rest of it is removed from ring buffer.
+ *
+ * @param[*RecieveBuffer] - ring buffer with received lines
+ * @param[*ParseBuffer] - buffer for the line
+ * @param[BufferSize] - size of parse buffer, at least 2 bytes (end of line and 0)
+ * @return - void
+ */
+void Parse_WriteDataToBuffer(Ringbuffer_t *RecieveBuffer, uint8_t *ParseBuffer,
+		uint16_t BufferSize)
+{
+	uint16_t i = 0;
+	uint8_t temp;
+	do
+	{
+		// stop when ring buffer is empty
+		if (RB_Read(RecieveBuffer, &temp) != RB_OK)
+		{
+			break;
+		}
+		// keep place for end of line and 0
+		if (temp != ENDLINE && i < BufferSize - 2)
+		{
+			ParseBuffer[i] = temp;
+			i++;
+		}
+	} while (temp != ENDLINE);
+
+	ParseBuffer[i] = '\n';
+	ParseBuffer[i + 1] = 0;
+}
+
+/*
+ * @ WAKE UP procedure
+ */
+static void Parser_WAKEUP(void)
+{
+	//wake up for 5 mins
+	Parser_DisplayTerminal("System wake up\n\r");
+
+}
+
+/*
+ * Write value with 2 decimals without float, %f of newlib can take heap.
+ * Sign is written on its own, integer part of values between -1 and 0 is 0
+ * and would lose it.
+ *
+ * @param[*Buffer] - at least 14 bytes
+ * @param[Milli] - value in thousandths
+ * @return - Buffer
+ */
+static char *Parser_FormatMilli(char *Buffer, int32_t Milli)
+{
+	uint32_t Abs = (Milli < 0) ? -(uint32_t) Milli : (uint32_t) Milli;
+
+	// -0.004 is shown as 0.00
+	sprintf(Buffer, "%s%lu.%02lu", (Milli < 0 && Abs >= 10) ? "-" : "",
+			(unsigned long) (Abs / 1000), (unsigned long) (Abs % 1000 / 10));
+
+	return Buffer;
+}
+
+/*
+ * Write sample in units of its sensor, unknown sensor gives counts marked by #
+ *
+ * @param[*Buffer] - at least 14 bytes
+ * @param[*Sensor] - sensor of sample, NULL - unknown
+ * @param[Value] - sample in counts
+ * @return - Buffer
+ */
+static char *Parser_FormatSample(char *Buffer, const Sensor_t *Sensor, int16_t Value)
+{
+	int32_t Milli;
+
+	if (Sensor_ToMilli(Sensor, Value, &Milli) != SENSOR_OK)
+	{
+		sprintf(Buffer, "#%d", Value);
+		return Buffer;
+	}
+
+	return Parser_FormatMilli(Buffer, Milli);
+}
+
+/*
+ * @ MEASURE procedure
+ * Reports last sample of every sensor with time of its conversion
+ */
+static void Parser_MEASURE(TMP102Array_t *TMP102Array)
+{
+	uint8_t Msg[64];
+	TMP102Sample_t Sample;
+	Sensor_t *Sensor;
+	uint8_t i;
+
+	// send log to uart
+	Parser_DisplayTerminal("Measurment done :\n\r");
+
+	for (i = 0; i < TMP102Array->SensorCount; i++)
+	{
+		Sensor = TMP102ArrayGetSensor(TMP102Array, i);
+
+		if (TMP102ArrayGetHistory(TMP102Array, i, &Sample, 1) == 0)
+		{
+			sprintf((char*) Msg, " 0x%02X %s : no data\n\r", Sensor->Address,
+					Sensor->Driver->Name);
+		}
+		else
+		{
+			char Value[14];
+			sprintf((char*) Msg, " 0x%02X %s : %s %s at %lu ms%s\n\r",
+					Sensor->Address, Sensor->Driver->Name,
+					Parser_FormatSample(Value, Sensor, Sample.Value),
+					Sensor->Driver->Unit, (unsigned long) Sample.Timestamp,
+					TMP102ArrayIsStale(TMP102Array, i) ? ", stale" : "");
+		}
+		Parser_DisplayTerminal((char*) Msg);
+	}
+	return;
+
+	//bluetooth send to master
+}
+
+/*
+ * Format one telemetry entry, sequence number lets gateway find gaps and duplicates
+ *
+ * @param[*Entry] - reading or alert from backlog
+ * @return - void
+ */
+static void Parser_ReportEntry(Report_Entry_t *Entry)
+{
+	uint8_t Msg[56];
+	char Type[8];
+	// sensor of stored address gives the unit, unknown address stays in counts
+	const Sensor_t *Sensor = Sensor_Find(Entry->Address);
+
+	if (Entry->Type == TMP102_ALERT_NONE)
+	{
+		strcpy(Type, "T");
+	}
+	else
+	{
+		strcpy(Type, (Entry->Type == TMP102_ALERT_HIGH) ? "A HIGH" : "A LOW");
+	}
+
+	char Value[14];
+	sprintf((char*) Msg, "%s %lu 0x%02X %s at %lu\n\r", Type,
+			(unsigned long) Entry->Sequence, Entry->Address,
+			Parser_FormatSample(Value, Sensor, Entry->Sample.Value),
+			(unsigned long) Entry->Sample.Timestamp);
+
+	Parser_DisplayTerminal((char*) Msg);
+}
+
+/*
+ * Send queued telemetry. Put in main loop while master is connected.
+ * Alerts are sent at once. For readings, commands waiting in queue and frames
+ * already on the wire go first and replay is paced.
+ * Entries stay queued until their frame is accepted by transmit queue.
+ * Alerts have their own frame, response of commands executed so far is kept
+ * and sent when the line is done.
+ *
+ * @return - void
+ */
+void Parser_SendReports(void)
+{
+	Report_Entry_t Entry;
+	uint8_t i;
+	uint8_t *CmdFrame = ResponseFrame;
+	uint16_t CmdLenght = ResponseLenght;
+	uint8_t CmdLost = ResponseLost;
+
+	ResponseFrame = NULL;
+	ResponseLenght = 0;
+	ResponseLost = 0;
+
+	for (i = 0; i < REPORT_REPLAY_CHUNK && Report_PeekAlert(i, &Entry); i++)
+	{
+		Parser_ReportEntry(&Entry);
+	}
+	if (i > 0 && Parser_FlushResponse() == PARSE_OK)
+	{
+		Report_PopAlert(i);
+	}
+
+	// back to response of commands
+	ResponseFrame = CmdFrame;
+	ResponseLenght = CmdLenght;
+	ResponseLost = CmdLost;
+
+	if (CmdQueue.Count != 0 || JDY09_IsTxBusy(Parser_JDY09)
+			|| !Report_FrameAllowed())
+	{
+		return;
+	}
+
+	for (i = 0; i < REPORT_REPLAY_CHUNK && Report_Peek(i, &Entry); i++)
+	{
+		Parser_ReportEntry(&Entry);
+	}
+	if (Parser_FlushResponse() == PARSE_OK)
+	{
+		Report_Pop(i);
+	}
+	Report_FrameSent();
+}
+
+/*
+ * @ REPORT procedure
+ */
+static void Parser_REPORT(Parser_Cmd_t *Command)
+{
+	uint8_t Msg[72];
+
+	Report_SetPolicy(Command->Arg[0], Command->Arg[1]);
+	Report_SetPacing(Command->Arg[2]);
+
+	sprintf((char*) Msg, "Report deadband %lu.%03lu, silence %lu s, pacing %lu ms\n\r",
+			(unsigned long) (Command->Arg[0] / 1000),
+			(unsigned long) (Command->Arg[0] % 1000),
+			(unsigned long) (Command->Arg[1] / 1000),
+			(unsigned long) Command->Arg[2]);
+	Parser_DisplayTerminal((char*) Msg);
+}
+
+/*
+ * @ HISTORY procedure
+ * Sends history of every sensor as base64 of delta encoded batch (encode.c).
+ * Base64 adds a third to the batch, 16 steady samples (51 B) take 68 characters,
+ * less than 96 bytes of raw binary samples, hex took 102.
+ * Tests/history_decode.c decodes the lines, Tests/test_encode.c measures sizes.
+ */
+static void Parser_HISTORY(TMP102Array_t *TMP102Array)
+{
+	TMP102Sample_t Samples[TMP102_ARRAY_HISTORY_SIZE];
+	int16_t Values[TMP102_ARRAY_HISTORY_SIZE];
+	uint32_t Timestamps[TMP102_ARRAY_HISTORY_SIZE];
+	uint8_t Batch[ENCODE_BATCH_SIZE(TMP102_ARRAY_HISTORY_SIZE)];
+	// text of whole groups of 3 bytes, padding only in last part
+	char Msg[ENCODE_BASE64_SIZE(PARSE_HISTORY_CHUNK) + 1];
+	uint16_t Lenght;
+	uint16_t Chunk;
+	uint8_t Count;
+	uint8_t i, j;
+
+	for (i = 0; i < TMP102Array->SensorCount; i++)
+	{
+		Count = TMP102ArrayGetHistory(TMP102Array, i, Samples,
+				TMP102_ARRAY_HISTORY_SIZE);
+
+		// history is newest first, batch is oldest first
+		for (j = 0; j < Count; j++)
+		{
+			Values[j] = Samples[Count - 1 - j].Value;
+			Timestamps[j] = Samples[Count - 1 - j].Timestamp;
+		}
+		Lenght = Encode_DeltaBatch(Values, Timestamps, Count, Batch,
+				sizeof(Batch));
+
+		sprintf(Msg, "H 0x%02X ", TMP102Array->Sensors[i].Sensor.Address);
+		Parser_DisplayTerminal(Msg);
+		for (j = 0; j < Lenght; j += Chunk)
+		{
+			Chunk = (Lenght - j < PARSE_HISTORY_CHUNK) ? (Lenght - j) : PARSE_HISTORY_CHUNK;
+			Msg[Encode_Base64(&Batch[j], Chunk, Msg)] = 0;
+			Parser_DisplayTerminal(Msg);
+		}
+		Parser_DisplayTerminal("\n\r");
+	}
+}
+
+/*
+ * @ DUMP procedure
+ * Only range is set here, records are streamed by Parser_DumpContinue
+ */
+static void Parser_DUMP(Parser_Cmd_t *Command)
+{
+	uint8_t Msg[48];
+	uint32_t Total = FlashLog_GetCount();
+
+	DumpNext = (Command->Arg[0] < Total) ? Command->Arg[0] : Total;
+	DumpEnd = DumpNext
+			+ ((Command->Arg[1] < Total - DumpNext) ?
+					Command->Arg[1] : (Total - DumpNext));
+
+	sprintf((char*) Msg, "DUMP %lu-%lu of %lu\n\r", (unsigned long) DumpNext,
+			(unsigned long) DumpEnd, (unsigned long) Total);
+	Parser_DisplayTerminal((char*) Msg);
+}
+
+/*
+ * Send next part of DUMP stream when link is free, so main loop is not blocked
+ * for the whole log and commands received meanwhile are executed
+ *
+ * @return - void
+ */
+static void Parser_DumpContinue(void)
+{
+	uint8_t Msg[48];
+	FlashLog_Record_t Record;
+	uint8_t i;
+
+	if (DumpNext >= DumpEnd || JDY09_IsTxBusy(Parser_JDY09))
+	{
+		return;
+	}
+
+	for (i = 0; i < PARSE_DUMP_CHUNK && DumpNext < DumpEnd; i++, DumpNext++)
+	{
+		if (FlashLog_Read(DumpNext, &Record) != FLASHLOG_OK)
+		{
+			sprintf((char*) Msg, "D %lu empty\n\r", (unsigned long) DumpNext);
+		}
+		else
+		{
+			char Value[14];
+			sprintf((char*) Msg, "D %lu %u 0x%02X %s %lu\n\r",
+					(unsigned long) DumpNext, Record.Boot, Record.Address,
+					Parser_FormatSample(Value, Sensor_Find(Record.Address), Record.Value),
+					(unsigned long) Record.Time);
+		}
+		Parser_DisplayTerminal((char*) Msg);
+	}
+
+	if (DumpNext >= DumpEnd)
+	{
+		Parser_DisplayTerminal("DUMP END\n\r");
+	}
+	Parser_FlushResponse();
+}
+
+/*
+ * @ CLOCK procedure
+ * Reports time spent on every clock level since boot and how long boot took
+ */
+static void Parser_CLOCK(void)
+{
+	uint8_t Msg[64];
+	uint32_t BootTime;
+	uint32_t FirstSampleTime;
+
+	sprintf((char*) Msg, "Clock %s, switches %lu\n\r",
+			(ClockGov_GetLevel() == CLOCKGOV_LEVEL_RUN) ? "PLL 84 MHz" : "HSI 16 MHz",
+			(unsigned long) ClockGov_GetSwitches());
+	Parser_DisplayTerminal((char*) Msg);
+
+	sprintf((char*) Msg, " PLL %lu ms, HSI %lu ms\n\r",
+			(unsigned long) ClockGov_GetResidency(CLOCKGOV_LEVEL_RUN),
+			(unsigned long) ClockGov_GetResidency(CLOCKGOV_LEVEL_IDLE));
+	Parser_DisplayTerminal((char*) Msg);
+
+	Supervisor_GetBootTime(&BootTime, &FirstSampleTime);
+	sprintf((char*) Msg, " init %lu ms, first sample %lu ms after reset\n\r",
+			(unsigned long) BootTime, (unsigned long) FirstSampleTime);
+	Parser_DisplayTerminal((char*) Msg);
+}
+
+/*
+ * @ MEM procedure
+ * Reports RAM budget and stack high water mark
+ */
+static void Parser_MEM(void)
+{
+	uint8_t Msg[96];
+	MemStat_Usage_t Usage;
+
+	MemStat_GetUsage(&Usage);
+
+	sprintf((char*) Msg, "RAM %lu B, data %lu B, bss %lu B\n\r",
+			(unsigned long) Usage.Total, (unsigned long) Usage.Data,
+			(unsigned long) Usage.Bss);
+	Parser_DisplayTerminal((char*) Msg);
+
+	sprintf((char*) Msg, " heap %lu B in %lu requests\n\r",
+			(unsigned long) Usage.Heap, (unsigned long) Usage.HeapRequests);
+	Parser_DisplayTerminal((char*) Msg);
+
+	sprintf((char*) Msg, " stack %lu of %lu B, free %lu B\n\r",
+			(unsigned long) Usage.StackUsed,
+			(unsigned long) Usage.StackReserved, (unsigned long) Usage.Free);
+	Parser_DisplayTerminal((char*) Msg);
+
+	sprintf((char*) Msg, " command queue %u of %u\n\r",
+			CmdQueue.HighWaterMark, PARSE_CMD_QUEUE_SIZE);
+	Parser_DisplayTerminal((char*) Msg);
+
+	sprintf((char*) Msg, " bt tx %lu frames, retries %lu, dropped %lu (%lu refused)\n\r",
+			(unsigned long) Parser_JDY09->TxStats.Frames,
+			(unsigned long) Parser_JDY09->TxStats.Retries,
+			(unsigned long) Parser_JDY09->TxStats.Dropped,
+			(unsigned long) Parser_JDY09->TxStats.RetryDrops);
+	Parser_DisplayTerminal((char*) Msg);
+
+	sprintf((char*) Msg, " responses lost, no frame %lu\n\r",
+			(unsigned long) ResponseAllocFailed);
+	Parser_DisplayTerminal((char*) Msg);
+
+	for (uint8_t i = 0; i < POOL_CLASSES; i++)
+	{
+		const Pool_t *Pool = Pool_GetClass(i);
+
+		sprintf((char*) Msg, " pool %u B: %u of %u, max %u, failed %lu\n\r",
+				Pool->BlockSize, Pool->Used, Pool->BlockCount,
+				Pool->HighWaterMark, (unsigned long) Pool->Failed);
+		Parser_DisplayTerminal((char*) Msg);
+	}
+}
+
+/*
+ * Time of one read or why it was not measured
+ *
+ * @param[*Text] - at least 24 bytes
+ * @param[Result] - result of I2CBus_Benchmark @benchmark
+ * @param[ReadTime] - time of one read in us
+ * @return - Text
+ */
+static char *Parser_FormatReadTime(char *Text, uint8_t Result, uint32_t ReadTime)
+{
+	if (Result == I2CBUS_BENCHMARK_OK)
+	{
+		sprintf(Text, "%lu us per read", (unsigned long) ReadTime);
+	}
+	else
+	{
+		strcpy(Text, (Result == I2CBUS_BENCHMARK_BUSY) ? "busy" : "read failed");
+	}
+
+	return Text;
+}
+
+/*
+ * @ I2C procedure
+ * Reports bus error counters and failed reads of every sensor.
+ * With speed argument bus is switched to it and read of first sensor is timed
+ * at old and new speed.
+ */
+static void Parser_I2C(TMP102Array_t *TMP102Array, Parser_Cmd_t *Command)
+{
+	uint8_t Msg[80];
+	const I2CBus_t *Bus = I2CBus_GetStats();
+	I2C_HandleTypeDef *hi2c = TMP102Array->I2CHandle;
+	uint8_t Device;
+	uint8_t Register;
+	uint8_t Result;
+	uint8_t Timed;
+	uint32_t ReadTime = 0;
+	char Time[24];
+	uint8_t i;
+
+	if (Command->Arg[0] != 0)
+	{
+		// no sensor to benchmark and to verify new speed
+		if (TMP102Array->SensorCount == 0)
+		{
+			TMP102ArraySelectSpeed(TMP102Array, Command->Arg[0]);
+			sprintf((char*) Msg, "I2C %lu kHz, no sensor, speed not verified\n\r",
+					(unsigned long) (hi2c->Init.ClockSpeed / 1000));
+			Parser_DisplayTerminal((char*) Msg);
+			return;
+		}
+
+		Device = TMP102Array->Sensors[0].Sensor.Address;
+		Register = TMP102Array->Sensors[0].Sensor.Driver->TestRegister;
+
+		Timed = I2CBus_Benchmark(hi2c, Device, Register, &ReadTime);
+		sprintf((char*) Msg, "I2C %lu kHz : %s\n\r",
+				(unsigned long) (hi2c->Init.ClockSpeed / 1000),
+				Parser_FormatReadTime(Time, Timed, ReadTime));
+		Parser_DisplayTerminal((char*) Msg);
+
+		Result = TMP102ArraySelectSpeed(TMP102Array, Command->Arg[0]);
+		Timed = I2CBus_Benchmark(hi2c, Device, Register, &ReadTime);
+		sprintf((char*) Msg, "I2C %lu kHz : %s%s\n\r",
+				(unsigned long) (hi2c->Init.ClockSpeed / 1000),
+				Parser_FormatReadTime(Time, Timed, ReadTime),
+				(Result == I2CBUS_SELECT_FAILED) ? ", self-test failed" :
+				(Result == I2CBUS_SELECT_BUSY) ? ", bus busy" : "");
+		Parser_DisplayTerminal((char*) Msg);
+		return;
+	}
+
+	sprintf((char*) Msg, "I2C %lu kHz, timeouts %lu, nacks %lu\n\r",
+			(unsigned long) (hi2c->Init.ClockSpeed / 1000),
+			(unsigned long) Bus->Timeouts, (unsigned long) Bus->Nacks);
+	Parser_DisplayTerminal((char*) Msg);
+
+	sprintf((char*) Msg, " busy %lu, arbitration lost %lu, bus errors %lu\n\r",
+			(unsigned long) Bus->Busy, (unsigned long) Bus->ArbitrationLost,
+			(unsigned long) Bus->BusErrors);
+	Parser_DisplayTerminal((char*) Msg);
+
+	sprintf((char*) Msg, " recoveries %lu, failed %lu, speed fallbacks %lu\n\r",
+			(unsigned long) Bus->Recoveries, (unsigned long) Bus->RecoveryFailed,
+			(unsigned long) Bus->SpeedFallbacks);
+	Parser_DisplayTerminal((char*) Msg);
+
+	for (i = 0; i < TMP102Array->SensorCount; i++)
+	{
+		sprintf((char*) Msg, " 0x%02X : errors %lu%s\n\r",
+				TMP102Array->Sensors[i].Sensor.Address,
+				(unsigned long) TMP102Array->Sensors[i].ErrorCount,
+				TMP102ArrayIsStale(TMP102Array, i) ? ", stale" : "");
+		Parser_DisplayTerminal((char*) Msg);
+	}
+}
+
+/*
+ * @ CRASH procedure
+ * Reports record of crash before last reset
+ */
+static void Parser_CRASH(void)
+{
+	uint8_t Msg[64];
+	Crash_Record_t Record;
+	uint32_t i;
+
+	if (!Crash_GetLast(&Record))
+	{
+		sprintf((char*) Msg, "CRASH none, %lu since power on\n\r",
+				(unsigned long) Crash_GetCount());
+		Parser_DisplayTerminal((char*) Msg);
+		return;
+	}
+
+	sprintf((char*) Msg, "CRASH %s at %lu ms, %lu since power on\n\r",
+			Crash_TypeName(Record.Type), (unsigned long) Record.Uptime,
+			(unsigned long) Crash_GetCount());
+	Parser_DisplayTerminal((char*) Msg);
+
+	if (Record.Type == CRASH_TYPE_WATCHDOG)
+	{
+		sprintf((char*) Msg, " TASK %lu %s\n\r", (unsigned long) Record.Task,
+				Supervisor_TaskName(Record.Task));
+		Parser_DisplayTerminal((char*) Msg);
+	}
+
+	sprintf((char*) Msg, " PC 0x%08lX LR 0x%08lX PSR 0x%08lX\n\r",
+			(unsigned long) Record.PC, (unsigned long) Record.LR,
+			(unsigned long) Record.PSR);
+	Parser_DisplayTerminal((char*) Msg);
+
+	sprintf((char*) Msg, " R0 0x%08lX R1 0x%08lX R2 0x%08lX\n\r",
+			(unsigned long) Record.R0, (unsigned long) Record.R1,
+			(unsigned long) Record.R2);
+	Parser_DisplayTerminal((char*) Msg);
+
+	sprintf((char*) Msg, " R3 0x%08lX R12 0x%08lX EXC 0x%08lX\n\r",
+			(unsigned long) Record.R3, (unsigned long) Record.R12,
+			(unsigned long) Record.ExcReturn);
+	Parser_DisplayTerminal((char*) Msg);
+
+	sprintf((char*) Msg, " CFSR 0x%08lX HFSR 0x%08lX\n\r",
+			(unsigned long) Record.CFSR, (unsigned long) Record.HFSR);
+	Parser_DisplayTerminal((char*) Msg);
+
+	sprintf((char*) Msg, " MMFAR 0x%08lX BFAR 0x%08lX\n\r",
+			(unsigned long) Record.MMFAR, (unsigned long) Record.BFAR);
+	Parser_DisplayTerminal((char*) Msg);
+
+	Parser_DisplayTerminal(" TRACE");
+	for (i = 0; i < Record.TraceCount && i < CRASH_TRACE_SIZE; i++)
+	{
+		sprintf((char*) Msg, " 0x%08lX", (unsigned long) Record.Trace[i]);
+		Parser_DisplayTerminal((char*) Msg);
+	}
+	Parser_DisplayTerminal("\n\r");
+}
+
+/*
+ * Send crash record once after reset, put in main loop while master is connected
+ *
+ * @return - void
+ */
+void Parser_SendCrash(void)
+{
+	if (CmdQueue.Count != 0 || JDY09_IsTxBusy(Parser_JDY09))
+	{
+		return;
+	}
+
+	Parser_CRASH();
+	Parser_FlushResponse();
+	Crash_ClearReportPending();
+}
+
+/*
+ * @ DISPLAY procedure
+ */
+static void Parser_DISPLAY(void)
+{
+	// send log to uart
+	Parser_DisplayTerminal("Pages rotated on display for 1 minute \n\r");
+
+	// start timer
+	Pages_Start();
+}
+
+/*
+ * @ PAGES procedure
+ * Sets pages rotated by DISPLAY and reports them
+ */
+static void Parser_PAGES(Parser_Cmd_t *Command)
+{
+	uint8_t Msg[16];
+	uint8_t List[PAGES_MAX_PAGES];
+	uint8_t Dwell[PAGES_MAX_PAGES];
+	uint8_t Count = 0;
+	uint8_t i;
+
+	if (Command->Arg[0] != 0)
+	{
+		while (Count < PAGES_MAX_PAGES && ((Command->Arg[0] >> (4 * Count)) & 0x0F) != 0)
+		{
+			List[Count] = ((Command->Arg[0] >> (4 * Count)) & 0x0F) - 1;
+			Dwell[Count] = Command->Arg[1 + Count / 4] >> (8 * (Count % 4));
+			Count++;
+		}
+
+		if (Pages_Set(List, Dwell, Count) != PAGES_OK)
+		{
+			Parser_DisplayTerminal("PAGES not set\n\r");
+		}
+	}
+
+	Count = Pages_Get(List, Dwell);
+	Parser_DisplayTerminal("PAGES=");
+	for (i = 0; i < Count; i++)
+	{
+		sprintf((char*) Msg, "%s%s:%u", (i > 0) ? "," : "", Pages_Name(List[i]), Dwell[i]);
+		Parser_DisplayTerminal((char*) Msg);
+	}
+	Parser_DisplayTerminal(";\n\r");
+}
+
+static void Parser_HELP(void)
+{
+	// send log to uart
+	Parser_DisplayTerminal("WAKEUP; - wake up from sleep mode \n\r");
+	Parser_DisplayTerminal("MEASURE; - measure and send to terminal \n\r");
+	Parser_DisplayTerminal("DISPLAY; - rotate pages on 8segment for 1 minute \n\r");
+	Parser_DisplayTerminal("SLEEP; - enter sleep mode \n\r");
+	Parser_DisplayTerminal("HELP; - print all commands \n\r");
+	Parser_DisplayTerminal("HISTORY; - send encoded history of all sensors \n\r");
+	Parser_DisplayTerminal("DUMP; or DUMP=<first>,<count>; - send records from flash log \n\r");
+	Parser_DisplayTerminal("REPORT=0.25,60; - send reading on 0.25 unit (deg C) change or every 60 s \n\r");
+	Parser_DisplayTerminal("CLOCK; - time spent on every clock level \n\r");
+	Parser_DisplayTerminal("MEM; - RAM, stack and pool usage \n\r");
+	Parser_DisplayTerminal("CRASH; - record of crash before last reset \n\r");
+	Parser_DisplayTerminal("I2C; - bus errors, recoveries and stale sensors \n\r");
+	Parser_DisplayTerminal("I2C=400; - bus speed in kHz, read time before and after \n\r");
+	Parser_DisplayTerminal("PAGES=T,MIN:8,MAX; - pages of DISPLAY with dwell s (T,MIN,MAX,AVG,RATE,LINK) \n\r");
+
+}
+
+/*
+ * @ SLEEP procedure
+ */
+static void Parser_SLEEP(void)
+{
+	uint8_t Rotating = Pages_IsActive();
+
+	//execute sleep
+
+	//stop timer
+	Pages_Stop();
+
+	//send log on uart, response has to be sent before sleep
+	Parser_DisplayTerminal("Entering sleep mode\n\r");
+	Parser_FlushResponse();
+	JDY09_WaitTxIdle(Parser_JDY09, PARSE_UART_TIMEOUT);
+
+	//enter sleep mode -> it will wait for IRQ to wake up
+	//hal tick keeps running to refresh watchdog, it does not end sleep
+	Supervisor_Sleep();
+
+	//send log on uart
+	Parser_DisplayTerminal("Waking up...\n\r");
+
+	//rotation stopped by sleep goes on from first page, TIM1 is started by it
+	if (Rotating)
+	{
+		Pages_Start();
+	}
+}
+
+
+/*
+ * Put command to the queue
+ *
+ * @param[*Command] - parsed command
+ * @return - PARSE_OK or PARSE_BUSY when queue is full
+ */
+static uint8_t Parser_QueuePush(Parser_Cmd_t *Command)
+{
+	if (CmdQueue.Count >= PARSE_CMD_QUEUE_SIZE)
+	{
+		return PARSE_BUSY;
+	}
+
+	CmdQueue.Buffer[CmdQueue.Head] = *Command;
+	CmdQueue.Head = (CmdQueue.Head + 1) % PARSE_CMD_QUEUE_SIZE;
+	CmdQueue.Count++;
+
+	if (CmdQueue.Count > CmdQueue.HighWaterMark)
+	{
+		CmdQueue.HighWaterMark = CmdQueue.Count;
+	}
+
+	return PARSE_OK;
+}
+
+/*
+ * Remove newest commands from the queue, used when a line can not be queued whole
+ *
+ * @param[Count] - number of commands to remove
+ * @return - void
+ */
+static void Parser_QueueRollback(uint8_t Count)
+{
+	if (Count > CmdQueue.Count)
+	{
+		Count = CmdQueue.Count;
+	}
+
+	CmdQueue.Head = (CmdQueue.Head + PARSE_CMD_QUEUE_SIZE - Count) % PARSE_CMD_QUEUE_SIZE;
+	CmdQueue.Count -= Count;
+}
+
+/*
+ * Take command from the queue
+ *
+ * @param[*Command] - command to execute
+ * @return - PARSE_OK or PARSE_ERROR_NOCMD when queue is empty
+ */
+static uint8_t Parser_QueuePop(Parser_Cmd_t *Command)
+{
+	if (CmdQueue.Count == 0)
+	{
+		return PARSE_ERROR_NOCMD;
+	}
+
+	*Command = CmdQueue.Buffer[CmdQueue.Tail];
+	CmdQueue.Tail = (CmdQueue.Tail + 1) % PARSE_CMD_QUEUE_SIZE;
+	CmdQueue.Count--;
+
+	return PARSE_OK;
+}
+
+/*
+ * Maximum number of commands that were waiting in queue at once
+ *
+ * @return - high water mark of command queue
+ */
+uint8_t Parser_GetQueueHighWaterMark(void)
+{
+	return CmdQueue.HighWaterMark;
+}
+
+/*
+ * Commands waiting or DUMP stream running, core should run at full clock
+ *
+ * @return - 1 if busy
+ */
+uint8_t Parser_IsBusy(void)
+{
+	return (CmdQueue.Count != 0) || (DumpNext < DumpEnd);
+}
+
+/*
+ * Read decimal number without float, strtod of newlib can take heap.
+ * Up to 3 decimals are kept, next one rounds, rest is skipped.
+ *
+ * @param[*Text] - number, "12", "0.25", ".5" or "3."
+ * @param[**End] - first character after number
+ * @param[*Milli] - value in thousandths
+ * @return - PARSE_OK or PARSE_ERROR_NOCMD if there is no digit or value is too big
+ */
+static uint8_t Parser_ParseMilli(const char *Text, char **End, uint32_t *Milli)
+{
+	uint32_t Value = 0;
+	uint32_t Scale = 1000;
+	uint8_t Digits = 0;
+
+	for (; *Text >= '0' && *Text <= '9'; Text++, Digits++)
+	{
+		if (Value > PARSE_MILLI_MAX / 10000)
+		{
+			return PARSE_ERROR_NOCMD;
+		}
+		Value = (Value * 10) + (*Text - '0');
+	}
+	Value *= 1000;
+
+	if (*Text == '.')
+	{
+		for (Text++; *Text >= '0' && *Text <= '9'; Text++, Digits++)
+		{
+			if (Scale > 1)
+			{
+				Scale /= 10;
+				Value += (*Text - '0') * Scale;
+			}
+			else if (Scale == 1)
+			{
+				Value += (*Text >= '5');
+				Scale = 0;
+			}
+		}
+	}
+
+	*End = (char*) Text;
+	if (Digits == 0)
+	{
+		return PARSE_ERROR_NOCMD;
+	}
+
+	*Milli = Value;
+	return PARSE_OK;
+}
+
+/*
+ * Decode arguments of REPORT=0.25,60 or REPORT=0.25,60,50
+ *
+ * @param[*Args] - text after '='
+ * @param[*Arg] - [0] deadband in thousandths of unit, [1] max silence in ms, [2] replay pacing in ms
+ * @return - PARSE_OK or PARSE_ERROR_NOCMD if arguments are wrong
+ */
+static uint8_t Parser_DecodeReport(uint8_t *Args, uint32_t *Arg)
+{
+	char *End;
+	uint32_t Deadband;
+	unsigned long Silence;
+	unsigned long Pacing = REPORT_DEFAULT_PACING;
+
+	if (Parser_ParseMilli((char*) Args, &End, &Deadband) != PARSE_OK || *End != ','
+			|| Deadband > REPORT_MAX_DEADBAND)
+	{
+		return PARSE_ERROR_NOCMD;
+	}
+
+	Args = (uint8_t*) (End + 1);
+	Silence = strtoul((char*) Args, &End, 10);
+	if (End == (char*) Args || (*End != 0 && *End != ',')
+			|| Silence > REPORT_MAX_SILENCE_LIMIT)
+	{
+		return PARSE_ERROR_NOCMD;
+	}
+
+	// optional pacing of backlog replay
+	if (*End == ',')
+	{
+		Args = (uint8_t*) (End + 1);
+		Pacing = strtoul((char*) Args, &End, 10);
+		if (End == (char*) Args || *End != 0 || Pacing > REPORT_MAX_PACING)
+		{
+			return PARSE_ERROR_NOCMD;
+		}
+	}
+
+	// thousandths of unit, every sensor rounds it to its resolution
+	Arg[0] = Deadband;
+	Arg[1] = Silence * 1000;
+	Arg[2] = Pacing;
+
+	return PARSE_OK;
+}
+
+/*
+ * Decode arguments of DUMP=100,50
+ *
+ * @param[*Args] - text after '='
+ * @param[*Arg] - [0] first record, [1] number of records
+ * @return - PARSE_OK or PARSE_ERROR_NOCMD if arguments are wrong
+ */
+static uint8_t Parser_DecodeRange(uint8_t *Args, uint32_t *Arg)
+{
+	char *End;
+
+	Arg[0] = strtoul((char*) Args, &End, 10);
+	if (End == (char*) Args || *End != ',')
+	{
+		return PARSE_ERROR_NOCMD;
+	}
+
+	Args = (uint8_t*) (End + 1);
+	Arg[1] = strtoul((char*) Args, &End, 10);
+	if (End == (char*) Args || *End != 0)
+	{
+		return PARSE_ERROR_NOCMD;
+	}
+
+	return PARSE_OK;
+}
+
+/*
+ * Decode argument of I2C=400
+ *
+ * @param[*Args] - text after '='
+ * @param[*Arg] - [0] bus speed in Hz
+ * @return - PARSE_OK or PARSE_ERROR_NOCMD if argument is wrong
+ */
+static uint8_t Parser_DecodeSpeed(uint8_t *Args, uint32_t *Arg)
+{
+	char *End;
+	unsigned long Speed;
+
+	Speed = strtoul((char*) Args, &End, 10);
+	if (End == (char*) Args || *End != 0 || Speed < PARSE_I2C_MIN_SPEED
+			|| Speed > (I2CBUS_SPEED_FAST / 1000))
+	{
+		return PARSE_ERROR_NOCMD;
+	}
+
+	Arg[0] = Speed * 1000;
+
+	return PARSE_OK;
+}
+
+/*
+ * Decode arguments of PAGES=T,MIN:8,MAX
+ *
+ * @param[*Args] - text after '=', page names with optional dwell in s
+ * @param[*Arg] - [0] page + 1 in every 4 bits, [1] and [2] dwell in every byte
+ * @return - PARSE_OK or PARSE_ERROR_NOCMD if arguments are wrong
+ */
+static uint8_t Parser_DecodePages(uint8_t *Args, uint32_t *Arg)
+{
+	char *Name = (char*) Args;
+	char *End;
+	unsigned long Dwell;
+	uint8_t Page;
+	uint8_t Count = 0;
+
+	Arg[0] = 0;
+	Arg[1] = 0;
+	Arg[2] = 0;
+
+	// line is being cut by strtok_r, names are cut by hand
+	while (1)
+	{
+		Page = Pages_Find(Name, strcspn(Name, ",:"));
+		if (Page == PAGES_NONE || Count == PAGES_MAX_PAGES)
+		{
+			return PARSE_ERROR_NOCMD;
+		}
+		Name += strcspn(Name, ",:");
+
+		Dwell = PAGES_DEFAULT_DWELL;
+		if (*Name == ':')
+		{
+			Dwell = strtoul(Name + 1, &End, 10);
+			if (End == Name + 1 || Dwell == 0 || Dwell > PAGES_MAX_DWELL)
+			{
+				return PARSE_ERROR_NOCMD;
+			}
+			Name = End;
+		}
+
+		Arg[0] |= (uint32_t) (Page + 1) << (4 * Count);
+		Arg[1 + Count / 4] |= (uint32_t) Dwell << (8 * (Count % 4));
+		Count++;
+
+		if (*Name == 0)
+		{
+			return PARSE_OK;
+		}
+		if (*Name != ',')
+		{
+			return PARSE_ERROR_NOCMD;
+		}
+		Name++;
+	}
+}
+
+/*
+ * @ function parse message and put commands to the queue
+ */
+
+static uint8_t Parser_ParseBatch(uint8_t *ParseBuffer)
+{
+	// Count how many commands we have to parse
+	uint8_t cmd_count = 0;
+	uint8_t i = 0;
+	uint8_t LastCommand[16] =  {0};
+
+	// For every semicolon count up until EOL (or end of string),
+	// empty commands (;;) are not counted
+	while (ParseBuffer[i] != '\n' && ParseBuffer[i] != 0)
+	{
+		if (ParseBuffer[i] == ';' && i > 0 && ParseBuffer[i - 1] != ';')
+		{
+			cmd_count++;
+		}
+		i++;
+	}
+
+
+	// if there is no msg that we want to parse then just send it
+
+	if (cmd_count == 0)
+	{
+		Parser_DisplayTerminal("Message received :");
+		Parser_DisplayTerminal((char*)ParseBuffer);
+		// return ERROR
+		return PARSE_ERROR_NOCMD;
+	}
+
+	// line never fits in queue, BUSY would make sender repeat it forever
+	if (cmd_count > PARSE_CMD_QUEUE_SIZE)
+	{
+		Parser_DisplayTerminal("TOO MANY COMMANDS\n\r");
+		return PARSE_ERROR_TOO_MANY;
+	}
+
+	uint8_t *ParsePointer;
+	char *SavePointer;
+	Parser_Cmd_t Command;
+	uint8_t Queued = 0;
+
+	// Queue cmd_count number of commands
+	for (i = 0; i < cmd_count; i++)
+	{
+
+		// cut command from the message -> from beginning to ;
+		//if first msg start from beginning
+		// strtok_r keeps its place here, strtok of newlib-nano can take heap for it
+		if(i == 0)
+		{
+			ParsePointer = (uint8_t*)(strtok_r((char*)ParseBuffer, ";", &SavePointer));
+
+		}else
+		{
+			ParsePointer = (uint8_t*)(strtok_r(NULL, ";", &SavePointer));
+		}
+
+		// empty commands (;;) are skipped by strtok_r
+		if (ParsePointer == NULL)
+		{
+			break;
+		}
+
+		// if you put two same commands in a row - error
+		if(strcmp((char*)ParsePointer,(char*)LastCommand) == 0)
+		{
+			Parser_DisplayTerminal("Error, same command twice in a row!\n\r");
+			return PARSE_ERROR_2CMDS;
+		}
+
+		/*
+		 * DECODE COMMANDS
+		 */
+
+		if (strcmp("WAKEUP", (char*)ParsePointer) == 0)
+		{
+			Command.Command = WAKE_UP;
+		}
+		else if (strcmp("MEASURE", (char*)ParsePointer) == 0)
+		{
+			Command.Command = MEASURE;
+		}
+		else if (strcmp("DISPLAY", (char*)ParsePointer) == 0)
+		{
+			Command.Command = DISPLAY;
+		}
+		else if (strcmp("HELP", (char*)ParsePointer) == 0)
+		{
+			Command.Command = HELP;
+		}
+		else if (strcmp("SLEEP", (char*)ParsePointer) == 0)
+		{
+			Command.Command = SLEEP;
+		}
+		else if (strcmp("HISTORY", (char*)ParsePointer) == 0)
+		{
+			Command.Command = HISTORY;
+		}
+		else if (strcmp("CLOCK", (char*)ParsePointer) == 0)
+		{
+			Command.Command = CLOCK;
+		}
+		else if (strcmp("MEM", (char*)ParsePointer) == 0)
+		{
+			Command.Command = MEM;
+		}
+		else if (strcmp("CRASH", (char*)ParsePointer) == 0)
+		{
+			Command.Command = CRASH;
+		}
+		else if (strcmp("I2C", (char*)ParsePointer) == 0)
+		{
+			// only statistics
+			Command.Command = I2C;
+			Command.Arg[0] = 0;
+		}
+		else if (strncmp("I2C=", (char*)ParsePointer, 4) == 0)
+		{
+			Command.Command = I2C;
+			if (Parser_DecodeSpeed(ParsePointer + 4, Command.Arg) != PARSE_OK)
+			{
+				Parser_DisplayTerminal("I2C=<speed kHz, 10 - 400>;\n\r");
+				return PARSE_ERROR_NOCMD;
+			}
+		}
+		else if (strcmp("PAGES", (char*)ParsePointer) == 0)
+		{
+			// only print
+			Command.Command = PAGES;
+			Command.Arg[0] = 0;
+		}
+		else if (strncmp("PAGES=", (char*)ParsePointer, 6) == 0)
+		{
+			Command.Command = PAGES;
+			if (Parser_DecodePages(ParsePointer + 6, Command.Arg) != PARSE_OK)
+			{
+				Parser_DisplayTerminal("PAGES=<T|MIN|MAX|AVG|RATE|LINK>[:<dwell s>],...;\n\r");
+				return PARSE_ERROR_NOCMD;
+			}
+		}
+		else if (strcmp("DUMP", (char*)ParsePointer) == 0)
+		{
+			// whole log
+			Command.Command = DUMP;
+			Command.Arg[0] = 0;
+			Command.Arg[1] = 0xFFFFFFFF;
+		}
+		else if (strncmp("DUMP=", (char*)ParsePointer, 5) == 0)
+		{
+			Command.Command = DUMP;
+			if (Parser_DecodeRange(ParsePointer + 5, Command.Arg) != PARSE_OK)
+			{
+				Parser_DisplayTerminal("DUMP=<first record>,<count>;\n\r");
+				return PARSE_ERROR_NOCMD;
+			}
+		}
+		else if (strncmp("REPORT=", (char*)ParsePointer, 7) == 0)
+		{
+			Command.Command = REPORT;
+			if (Parser_DecodeReport(ParsePointer + 7, Command.Arg) != PARSE_OK)
+			{
+				Parser_DisplayTerminal("REPORT=<deadband unit>,<max silence s>[,<pacing ms>];\n\r");
+				return PARSE_ERROR_NOCMD;
+			}
+		}
+		else
+		{
+			Parser_DisplayTerminal("Commmand unknown \n\r");
+			Parser_HELP();
+			return PARSE_ERROR_NOCMD;
+		}
+
+		// queue full for now - commands of this line are taken back, sender repeats whole line later
+		if (Parser_QueuePush(&Command) != PARSE_OK)
+		{
+			Parser_QueueRollback(Queued);
+			Parser_DisplayTerminal("BUSY\n\r");
+			return PARSE_BUSY;
+		}
+		Queued++;
+
+		// all the commands after SLEEP are ignored
+		if (Command.Command == SLEEP)
+		{
+			return PARSE_OK;
+		}
+
+		// commands with arguments can be longer than buffer
+		strncpy((char*)LastCommand,(char*)ParsePointer, sizeof(LastCommand) - 1);
+	}
+
+	return PARSE_OK;
+}
+
+/*
+ * Parse all commands in the line and put them to command queue
+ *
+ * @param[*ParseBuffer] - line to parse
+ * @return - parse status PARSE_STATUS
+ */
+uint8_t Parser_Parse(uint8_t *ParseBuffer)
+{
+	uint8_t Status;
+
+	Status = Parser_ParseBatch(ParseBuffer);
+
+	// nothing to execute - send parse errors right away
+	if (CmdQueue.Count == 0)
+	{
+		Parser_FlushResponse();
+	}
+
+	return Status;
+}
+
+/*
+ * Execute one command from the queue, responses of all queued commands
+ * are sent as one frame when the queue is empty
+ *
+ * @param[*TMP102Array] - TMP102 sensors structure
+ * @return - void
+ */
+void Parser_Execute(TMP102Array_t *TMP102Array)
+{
+	Parser_Cmd_t Command;
+
+	if (Parser_QueuePop(&Command) != PARSE_OK)
+	{
+		// no commands - continue streaming flash log
+		Parser_DumpContinue();
+		return;
+	}
+
+	switch (Command.Command)
+	{
+	case WAKE_UP:
+		Parser_WAKEUP();
+		break;
+
+	case MEASURE:
+		Parser_MEASURE(TMP102Array);
+		break;
+
+	case DISPLAY:
+		Parser_DISPLAY();
+		break;
+
+	case HELP:
+		Parser_HELP();
+		break;
+
+	case SLEEP:
+		Parser_SLEEP();
+		break;
+
+	case REPORT:
+		Parser_REPORT(&Command);
+		break;
+
+	case HISTORY:
+		Parser_HISTORY(TMP102Array);
+		break;
+
+	case DUMP:
+		Parser_DUMP(&Command);
+		break;
+
+	case CLOCK:
+		Parser_CLOCK();
+		break;
+
+	case MEM:
+		Parser_MEM();
+		break;
+
+	case CRASH:
+		Parser_CRASH();
+		break;
+
+	case I2C:
+		Parser_I2C(TMP102Array, &Command);
+		break;
+
+	case PAGES:
+		Parser_PAGES(&Command);
+		break;
+	}
+
+	// send everything collected from handlers
+	if (CmdQueue.Count == 0)
+	{
+		Parser_FlushResponse();
+	}
+}
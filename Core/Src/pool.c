@@ -0,0 +1,180 @@
+/*
+ * pool.c
+ *
+ *  Created on: 19 October 2026
+ */
+
+/* Fixed-block allocator for message buffers.
+ *
+ * Every size class is a static array of equal blocks, free blocks are kept in
+ * a single linked list, so alloc and free only take or put the first block.
+ * Both run with interrupts disabled for few instructions, they can be called
+ * from IRQ and from main loop. When the fitting class is empty, next bigger class
+ * is used, request fails only when no bigger block is free.
+ *
+ * Every block has in-use bit. Pointer which is not start of a block or block
+ * which is already free stops in Error_Handler, pool would be broken after it.
+ *
+ * Usage of every class is reported by MEM; command.
+ */
+
+#include "main.h"
+#include "pool.h"
+
+static uint32_t PoolLineStorage[POOL_LINE_COUNT * POOL_LINE_SIZE / 4];
+static uint32_t PoolTextStorage[POOL_TEXT_COUNT * POOL_TEXT_SIZE / 4];
+static uint32_t PoolFrameStorage[POOL_FRAME_COUNT * POOL_FRAME_SIZE / 4];
+
+// ordered from smallest block
+static Pool_t Pool[POOL_CLASSES] =
+{
+	[POOL_CLASS_LINE] = { .BlockSize = POOL_LINE_SIZE, .BlockCount =
+	POOL_LINE_COUNT, .Storage = (uint8_t*) PoolLineStorage },
+	[POOL_CLASS_TEXT] = { .BlockSize = POOL_TEXT_SIZE, .BlockCount =
+	POOL_TEXT_COUNT, .Storage = (uint8_t*) PoolTextStorage },
+	[POOL_CLASS_FRAME] = { .BlockSize = POOL_FRAME_SIZE, .BlockCount =
+	POOL_FRAME_COUNT, .Storage = (uint8_t*) PoolFrameStorage },
+};
+
+/*
+ * Link all blocks to free lists, call once before any module takes a block
+ *
+ * @return - void
+ */
+void Pool_Init(void)
+{
+	uint8_t i, j;
+	uint8_t *Block;
+
+	for (i = 0; i < POOL_CLASSES; i++)
+	{
+		Pool[i].FreeList = NULL;
+		Pool[i].InUse = 0;
+		Pool[i].Used = 0;
+		Pool[i].HighWaterMark = 0;
+		Pool[i].Failed = 0;
+
+		// last block is linked first, list starts with block 0
+		for (j = Pool[i].BlockCount; j > 0; j--)
+		{
+			Block = &Pool[i].Storage[(j - 1) * Pool[i].BlockSize];
+			*(void**) Block = Pool[i].FreeList;
+			Pool[i].FreeList = Block;
+		}
+	}
+}
+
+/*
+ * Take block of at least Size bytes
+ *
+ * @param[Size] - bytes needed
+ * @return - block or NULL when no block is free
+ */
+void *Pool_Alloc(uint16_t Size)
+{
+	void *Block = NULL;
+	uint8_t Fitting = 1;
+	uint8_t i;
+
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+
+	for (i = 0; i < POOL_CLASSES; i++)
+	{
+		if (Pool[i].BlockSize < Size)
+		{
+			continue;
+		}
+
+		if (Pool[i].FreeList != NULL)
+		{
+			Block = Pool[i].FreeList;
+			Pool[i].FreeList = *(void**) Block;
+			Pool[i].InUse |= 1UL << (((uint8_t*) Block - Pool[i].Storage) / Pool[i].BlockSize);
+			Pool[i].Used++;
+			if (Pool[i].Used > Pool[i].HighWaterMark)
+			{
+				Pool[i].HighWaterMark = Pool[i].Used;
+			}
+			break;
+		}
+
+		// only fitting class counts failure, bigger ones are a fallback
+		if (Fitting)
+		{
+			Pool[i].Failed++;
+			Fitting = 0;
+		}
+	}
+
+	__set_PRIMASK(primask);
+
+	return Block;
+}
+
+/*
+ * Give block back, class is found from block address.
+ * Pointer not given by Pool_Alloc and double free stop in Error_Handler.
+ *
+ * @param[*Block] - block from Pool_Alloc, NULL is ignored
+ * @return - void
+ */
+void Pool_Free(void *Block)
+{
+	uint8_t *Address = (uint8_t*) Block;
+	uint32_t Offset;
+	uint32_t Bit;
+	uint8_t i;
+
+	if (Block == NULL)
+	{
+		return;
+	}
+
+	for (i = 0; i < POOL_CLASSES; i++)
+	{
+		if (Address >= Pool[i].Storage
+				&& Address < Pool[i].Storage + (Pool[i].BlockCount * Pool[i].BlockSize))
+		{
+			Offset = Address - Pool[i].Storage;
+			Bit = 1UL << (Offset / Pool[i].BlockSize);
+
+			uint32_t primask = __get_PRIMASK();
+			__disable_irq();
+
+			// inside of a block or block already free - free list would be broken
+			if ((Offset % Pool[i].BlockSize) != 0 || (Pool[i].InUse & Bit) == 0)
+			{
+				__set_PRIMASK(primask);
+				Error_Handler();
+				return;
+			}
+
+			Pool[i].InUse &= ~Bit;
+			*(void**) Block = Pool[i].FreeList;
+			Pool[i].FreeList = Block;
+			Pool[i].Used--;
+			__set_PRIMASK(primask);
+			return;
+		}
+	}
+
+	// not from pool
+	Error_Handler();
+}
+
+/*
+ * Usage counters of size class
+ *
+ * @param[Class] - @class
+ * @return - pool or NULL for wrong class
+ */
+const Pool_t *Pool_GetClass(uint8_t Class)
+{
+	if (Class >= POOL_CLASSES)
+	{
+		return NULL;
+	}
+
+	return &Pool[Class];
+}
@@ -0,0 +1,282 @@
+/*
+ * report.c
+ *
+ *  Created on: 19 October 2026
+ */
+
+/* Reporting policy between sampler and bluetooth link.
+ * New sample is sent only when it differs from the last sent value by more than
+ * deadband, or when nothing was sent for max silence time.
+ *
+ * put Report_Check for every sensor in main loop, queue sample when it returns 1
+ *
+ * All telemetry gets a sequence number. Readings go through backlog, while master is
+ * connected backlog is sent at once, after reconnect it is replayed in frames of
+ * REPORT_REPLAY_CHUNK entries, with pacing gap so commands from master get through.
+ * Threshold crossings have their own queue which is sent at once, without pacing.
+ *
+ * Entries are removed only after their frame was queued for transmission, so they are
+ * sent again when it failed. Gateway drops duplicates by sequence number.
+ */
+
+#include "main.h"
+#include "string.h"
+#include "stdlib.h"
+#include "report.h"
+
+static Report_t Report = { .Deadband = REPORT_DEFAULT_DEADBAND, .MaxSilence =
+REPORT_DEFAULT_MAX_SILENCE, .Pacing = REPORT_DEFAULT_PACING };
+
+/*
+ * Set reporting policy, first sample of every sensor is sent after change
+ *
+ * @param[Deadband] - change in thousandths of sensor unit needed to send,
+ *                    up to REPORT_MAX_DEADBAND
+ * @param[MaxSilence] - ms after which reading is sent anyway, 0 - never
+ * @return - void
+ */
+void Report_SetPolicy(uint32_t Deadband, uint32_t MaxSilence)
+{
+	if (Deadband > REPORT_MAX_DEADBAND)
+	{
+		Deadband = REPORT_MAX_DEADBAND;
+	}
+	Report.Deadband = Deadband;
+	Report.MaxSilence = MaxSilence;
+	Report_Reset();
+}
+
+/*
+ * Get current reporting policy
+ *
+ * @param[*Deadband] - change in thousandths of sensor unit needed to send
+ * @param[*MaxSilence] - ms after which reading is sent anyway
+ * @return - void
+ */
+void Report_GetPolicy(uint32_t *Deadband, uint32_t *MaxSilence)
+{
+	*Deadband = Report.Deadband;
+	*MaxSilence = Report.MaxSilence;
+}
+
+/*
+ * Forget sent values, next sample of every sensor is sent
+ *
+ * @return - void
+ */
+void Report_Reset(void)
+{
+	Report.ReportedMask = 0;
+}
+
+/*
+ * Check newest sample of sensor against policy
+ *
+ * @param[*array] - sensor array structure
+ * @param[Index] - sensor number
+ * @param[*Sample] - sample to send
+ * @return - 1 sample has to be sent, 0 nothing new or not changed enough
+ */
+uint8_t Report_Check(TMP102Array_t *array, uint8_t Index, TMP102Sample_t *Sample)
+{
+	int32_t Deadband;
+
+	// stale sensor has only old sample, heartbeat would send it as new
+	if (Index >= TMP102_ARRAY_MAX_SENSORS || TMP102ArrayIsStale(array, Index)
+			|| TMP102ArrayGetHistory(array, Index, Sample, 1) == 0)
+	{
+		return 0;
+	}
+
+	// sample already checked
+	if ((Report.ReportedMask & (1 << Index))
+			&& Sample->Timestamp == Report.LastSampleTime[Index])
+	{
+		return 0;
+	}
+	Report.LastSampleTime[Index] = Sample->Timestamp;
+
+	// deadband in counts of this sensor, rounded, Report_SetPolicy limits it so
+	// millionths fit in 32 bits
+	Deadband = (int32_t) ((Report.Deadband * 1000
+			+ array->Sensors[Index].Sensor.Driver->Resolution / 2)
+			/ array->Sensors[Index].Sensor.Driver->Resolution);
+
+	if ((Report.ReportedMask & (1 << Index))
+			&& abs(Sample->Value - Report.LastValue[Index]) <= Deadband
+			&& (Report.MaxSilence == 0
+					|| (HAL_GetTick() - Report.LastReportTime[Index])
+							< Report.MaxSilence))
+	{
+		Report.Suppressed++;
+		return 0;
+	}
+
+	Report.ReportedMask |= (1 << Index);
+	Report.LastValue[Index] = Sample->Value;
+	Report.LastReportTime[Index] = HAL_GetTick();
+	Report.Sent++;
+
+	return 1;
+}
+
+/*
+ * Put telemetry to backlog or alert queue, oldest entry is overwritten when it is full
+ *
+ * @param[Type] - TMP102_ALERT_NONE for reading or @alert
+ * @param[Address] - sensor address
+ * @param[*Sample] - temperature
+ * @return - void
+ */
+void Report_Queue(uint8_t Type, uint8_t Address, TMP102Sample_t *Sample)
+{
+	Report_Entry_t *Entry;
+
+	if (Type != TMP102_ALERT_NONE)
+	{
+		if (Report.AlertCount == REPORT_ALERT_QUEUE_SIZE)
+		{
+			Report.AlertTail = (Report.AlertTail + 1) % REPORT_ALERT_QUEUE_SIZE;
+			Report.AlertCount--;
+			Report.Overwritten++;
+		}
+		Entry = &Report.Alerts[(Report.AlertTail + Report.AlertCount)
+				% REPORT_ALERT_QUEUE_SIZE];
+		Report.AlertCount++;
+	}
+	else
+	{
+		if (Report.BacklogCount == REPORT_BACKLOG_SIZE)
+		{
+			// gateway sees the gap in sequence numbers
+			Report.BacklogTail = (Report.BacklogTail + 1) % REPORT_BACKLOG_SIZE;
+			Report.BacklogCount--;
+			Report.Overwritten++;
+		}
+		Entry = &Report.Backlog[(Report.BacklogTail + Report.BacklogCount)
+				% REPORT_BACKLOG_SIZE];
+		Report.BacklogCount++;
+	}
+
+	Entry->Sequence = Report.Sequence++;
+	Entry->Type = Type;
+	Entry->Address = Address;
+	Entry->Sample = *Sample;
+}
+
+/*
+ * Get reading from backlog without removing it
+ *
+ * @param[Index] - 0 for oldest entry
+ * @param[*Entry] - copied entry
+ * @return - 1 entry copied, 0 backlog has no such entry
+ */
+uint8_t Report_Peek(uint8_t Index, Report_Entry_t *Entry)
+{
+	if (Index >= Report.BacklogCount)
+	{
+		return 0;
+	}
+
+	*Entry = Report.Backlog[(Report.BacklogTail + Index) % REPORT_BACKLOG_SIZE];
+	return 1;
+}
+
+/*
+ * Remove oldest readings after their frame was queued for transmission
+ *
+ * @param[Count] - number of entries
+ * @return - void
+ */
+void Report_Pop(uint8_t Count)
+{
+	if (Count > Report.BacklogCount)
+	{
+		Count = Report.BacklogCount;
+	}
+
+	Report.BacklogTail = (Report.BacklogTail + Count) % REPORT_BACKLOG_SIZE;
+	Report.BacklogCount -= Count;
+}
+
+/*
+ * Get threshold crossing without removing it
+ *
+ * @param[Index] - 0 for oldest alert
+ * @param[*Entry] - copied entry
+ * @return - 1 entry copied, 0 queue has no such entry
+ */
+uint8_t Report_PeekAlert(uint8_t Index, Report_Entry_t *Entry)
+{
+	if (Index >= Report.AlertCount)
+	{
+		return 0;
+	}
+
+	*Entry = Report.Alerts[(Report.AlertTail + Index) % REPORT_ALERT_QUEUE_SIZE];
+	return 1;
+}
+
+/*
+ * Remove oldest alerts after their frame was queued for transmission
+ *
+ * @param[Count] - number of entries
+ * @return - void
+ */
+void Report_PopAlert(uint8_t Count)
+{
+	if (Count > Report.AlertCount)
+	{
+		Count = Report.AlertCount;
+	}
+
+	Report.AlertTail = (Report.AlertTail + Count) % REPORT_ALERT_QUEUE_SIZE;
+	Report.AlertCount -= Count;
+}
+
+/*
+ * Number of entries waiting for link
+ *
+ * @return - readings in backlog and alerts
+ */
+uint8_t Report_GetBacklog(void)
+{
+	return Report.BacklogCount + Report.AlertCount;
+}
+
+/*
+ * Set gap between replay frames
+ *
+ * @param[Pacing] - ms, 0 - full link rate
+ * @return - void
+ */
+void Report_SetPacing(uint32_t Pacing)
+{
+	Report.Pacing = Pacing;
+}
+
+/*
+ * Check if next frame of readings can be sent. Pacing is used only for replay,
+ * single new entry after idle time goes out at once. Alerts do not wait for it.
+ *
+ * @return - 1 frame can be sent
+ */
+uint8_t Report_FrameAllowed(void)
+{
+	if (Report.BacklogCount == 0)
+	{
+		return 0;
+	}
+
+	return ((HAL_GetTick() - Report.LastFrameTime) >= Report.Pacing);
+}
+
+/*
+ * Mark that frame was sent, next one waits for pacing time
+ *
+ * @return - void
+ */
+void Report_FrameSent(void)
+{
+	Report.LastFrameTime = HAL_GetTick();
+}
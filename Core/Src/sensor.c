@@ -0,0 +1,223 @@
+/*
+ * sensor.c
+ *
+ *  Created on: 19 October 2026
+ */
+
+/* Common interface of sensors on i2c bus.
+ *
+ * Every sensor type has constant driver with its parameters and functions,
+ * sampler and reports call only the driver, so new sensor type needs only
+ * its driver, place in Sensor_Device_t and Sensor_Drivers.
+ *
+ * Values are kept in counts of driver resolution, sensors initialized by Sensor_Init
+ * can be found by address, so stored samples can be converted to units later.
+ */
+
+#include "main.h"
+#include "string.h"
+#include "sensor.h"
+
+// first driver is used when nothing is found on the bus
+static const Sensor_Driver_t *const Sensor_Drivers[] = { &TMP102_Driver };
+
+#define SENSOR_DRIVER_COUNT		(sizeof(Sensor_Drivers) / sizeof(Sensor_Drivers[0]))
+
+static const Sensor_t *Sensor_Active[SENSOR_MAX_ACTIVE];
+static uint8_t Sensor_ActiveCount;
+
+/*
+ * Bind sensor to driver and initialize it
+ *
+ * @param[*Sensor] - sensor structure
+ * @param[*Driver] - driver of sensor type
+ * @param[*I2CHandle] - i2c handle
+ * @param[Address] - 7 bit address
+ * @return - @status
+ */
+uint8_t Sensor_Init(Sensor_t *Sensor, const Sensor_Driver_t *Driver,
+		I2C_HandleTypeDef *I2CHandle, uint8_t Address)
+{
+	uint8_t i;
+
+	memset(Sensor, 0, sizeof(Sensor_t));
+	Sensor->Driver = Driver;
+	Sensor->I2CHandle = I2CHandle;
+	Sensor->Address = Address;
+
+	// sensor initialized again takes its old place
+	for (i = 0; i < Sensor_ActiveCount; i++)
+	{
+		if (Sensor_Active[i]->Address == Address)
+		{
+			break;
+		}
+	}
+	if (i < SENSOR_MAX_ACTIVE)
+	{
+		Sensor_Active[i] = Sensor;
+		if (i == Sensor_ActiveCount)
+		{
+			Sensor_ActiveCount++;
+		}
+	}
+
+	return Driver->Init(Sensor);
+}
+
+/*
+ * Addresses used by all drivers, for i2c scan
+ *
+ * @param[*Addresses] - buffer for addresses
+ * @param[MaxCount] - size of buffer
+ * @return - number of addresses
+ */
+uint8_t Sensor_GetAddresses(uint8_t *Addresses, uint8_t MaxCount)
+{
+	uint8_t Count = 0;
+	uint8_t i, j;
+
+	for (i = 0; i < SENSOR_DRIVER_COUNT; i++)
+	{
+		for (j = 0; j < Sensor_Drivers[i]->AddressCount && Count < MaxCount; j++)
+		{
+			Addresses[Count++] = Sensor_Drivers[i]->FirstAddress + j;
+		}
+	}
+
+	return Count;
+}
+
+/*
+ * Driver of part which can use address, first registered driver wins
+ *
+ * @param[Address] - 7 bit address
+ * @return - driver or NULL
+ */
+const Sensor_Driver_t *Sensor_FindDriver(uint8_t Address)
+{
+	uint8_t i;
+
+	for (i = 0; i < SENSOR_DRIVER_COUNT; i++)
+	{
+		if (Address >= Sensor_Drivers[i]->FirstAddress
+				&& Address < Sensor_Drivers[i]->FirstAddress
+								+ Sensor_Drivers[i]->AddressCount)
+		{
+			return Sensor_Drivers[i];
+		}
+	}
+
+	return NULL;
+}
+
+/*
+ * Driver used when nothing is found on the bus
+ *
+ * @return - driver
+ */
+const Sensor_Driver_t *Sensor_GetDefaultDriver(void)
+{
+	return Sensor_Drivers[0];
+}
+
+/*
+ * Sensor initialized on address
+ *
+ * @param[Address] - 7 bit address
+ * @return - sensor or NULL
+ */
+const Sensor_t *Sensor_Find(uint8_t Address)
+{
+	uint8_t i;
+
+	for (i = 0; i < Sensor_ActiveCount; i++)
+	{
+		if (Sensor_Active[i]->Address == Address)
+		{
+			return Sensor_Active[i];
+		}
+	}
+
+	return NULL;
+}
+
+/*
+ * Convert counts to units
+ *
+ * @param[*Sensor] - sensor, NULL - unknown sensor
+ * @param[Value] - value in counts
+ * @param[*Result] - value in units of driver
+ * @return - @status, SENSOR_ERR_UNKNOWN if there is no sensor
+ */
+uint8_t Sensor_ToFloat(const Sensor_t *Sensor, int16_t Value, float *Result)
+{
+	if (Sensor == NULL)
+	{
+		return SENSOR_ERR_UNKNOWN;
+	}
+
+	*Result = (float) Value * Sensor->Driver->Resolution / 1000000.0f;
+
+	return SENSOR_OK;
+}
+
+/*
+ * Convert counts to thousandths of units, without float
+ *
+ * @param[*Sensor] - sensor, NULL - unknown sensor
+ * @param[Value] - value in counts
+ * @param[*Milli] - value in thousandths of units of driver
+ * @return - @status, SENSOR_ERR_UNKNOWN if there is no sensor
+ */
+uint8_t Sensor_ToMilli(const Sensor_t *Sensor, int16_t Value, int32_t *Milli)
+{
+	if (Sensor == NULL)
+	{
+		return SENSOR_ERR_UNKNOWN;
+	}
+
+	*Milli = (int32_t) (((int64_t) Value * Sensor->Driver->Resolution) / 1000);
+
+	return SENSOR_OK;
+}
+
+/*
+ * Convert units to counts
+ *
+ * @param[*Sensor] - sensor
+ * @param[Value] - value in units of driver
+ * @return - value in counts
+ */
+int16_t Sensor_FromFloat(const Sensor_t *Sensor, float Value)
+{
+	return (int16_t) (Value * 1000000.0f / Sensor->Driver->Resolution);
+}
+
+/*
+ * Convert thousandths of units to counts, without float
+ *
+ * @param[*Sensor] - sensor
+ * @param[Milli] - value in thousandths of units of driver
+ * @return - value in counts
+ */
+int16_t Sensor_FromMilli(const Sensor_t *Sensor, int32_t Milli)
+{
+	return (int16_t) (((int64_t) Milli * 1000) / Sensor->Driver->Resolution);
+}
+
+/*
+ * Unit of sensor values
+ *
+ * @param[*Sensor] - sensor, NULL - unknown sensor
+ * @return - unit, empty for unknown sensor
+ */
+const char *Sensor_Unit(const Sensor_t *Sensor)
+{
+	if (Sensor == NULL)
+	{
+		return "";
+	}
+
+	return Sensor->Driver->Unit;
+}
@@ -0,0 +1,264 @@
+/*
+ * supervisor.c
+ *
+ *  Created on: 19 October 2026
+ */
+
+/* Watchdog supervisor of main loop tasks.
+ *
+ * Every periodic task registers with its deadline and checks in when it made progress.
+ * Deadlines are checked from tick interrupt, so they are checked also when main loop
+ * is stuck. IWDG is refreshed only while all tasks are live. When a task misses its
+ * deadline, it is stored to crash record and IWDG is not refreshed anymore, so node
+ * is reset and the task is reported on next boot (crash.c).
+ * Flash erase stalls whole core, Supervisor_Hold and Supervisor_Release are put
+ * around it.
+ *
+ * put Supervisor_Tick in SysTick_Handler
+ */
+
+#include "main.h"
+#include "crash.h"
+#include "log.h"
+#include "supervisor.h"
+
+static Supervisor_t Supervisor;
+
+/*
+ * Add task to supervision, all tasks have to be registered before start
+ *
+ * @param[*Name] - task name for reports
+ * @param[Deadline] - maximum time between check ins in ms
+ * @return - task id or SUPERVISOR_NO_TASK
+ */
+uint8_t Supervisor_Register(const char *Name, uint32_t Deadline)
+{
+	if (Supervisor.Started || Supervisor.TaskCount >= SUPERVISOR_MAX_TASKS)
+	{
+		return SUPERVISOR_NO_TASK;
+	}
+
+	Supervisor_Task_t *Task = &Supervisor.Tasks[Supervisor.TaskCount];
+	Task->Name = Name;
+	Task->Deadline = Deadline;
+	Task->LastCheckIn = HAL_GetTick();
+
+	return Supervisor.TaskCount++;
+}
+
+/*
+ * Start IWDG, from now on it can not be stopped
+ *
+ * @return - void
+ */
+void Supervisor_Start(void)
+{
+	uint32_t Now = HAL_GetTick();
+
+	// time of boot does not count to deadlines
+	for (uint8_t i = 0; i < Supervisor.TaskCount; i++)
+	{
+		Supervisor.Tasks[i].LastCheckIn = Now;
+	}
+	Supervisor.LastCheck = Now;
+
+	// watchdog does not reset core stopped by debugger
+	__HAL_DBGMCU_FREEZE_IWDG();
+
+	Supervisor.hiwdg.Instance = IWDG;
+	Supervisor.hiwdg.Init.Prescaler = SUPERVISOR_IWDG_PRESCALER;
+	Supervisor.hiwdg.Init.Reload = SUPERVISOR_IWDG_RELOAD;
+	if (HAL_IWDG_Init(&Supervisor.hiwdg) != HAL_OK)
+	{
+		Error_Handler();
+	}
+
+	Supervisor.Started = 1;
+
+	// tick counts from HAL_Init, so this is the whole init after reset
+	Supervisor.BootTime = HAL_GetTick();
+	LOG_INFO(LOG_MSG_BOOT_DONE, (unsigned long) Supervisor.BootTime);
+}
+
+/*
+ * First sample is stored, only the first call is recorded
+ *
+ * @return - void
+ */
+void Supervisor_MarkFirstSample(void)
+{
+	if (Supervisor.FirstSampleTime != 0)
+	{
+		return;
+	}
+
+	Supervisor.FirstSampleTime = HAL_GetTick();
+	LOG_INFO(LOG_MSG_FIRST_SAMPLE, (unsigned long) Supervisor.FirstSampleTime);
+}
+
+/*
+ * Time of boot phases, measured from reset in ms
+ *
+ * @param[*BootTime] - end of init
+ * @param[*FirstSampleTime] - first sample, 0 - no sample yet
+ * @return - void
+ */
+void Supervisor_GetBootTime(uint32_t *BootTime, uint32_t *FirstSampleTime)
+{
+	*BootTime = Supervisor.BootTime;
+	*FirstSampleTime = Supervisor.FirstSampleTime;
+}
+
+/*
+ * Task made progress
+ *
+ * @param[Task] - task id from Supervisor_Register
+ * @return - void
+ */
+void Supervisor_CheckIn(uint8_t Task)
+{
+	if (Task < Supervisor.TaskCount)
+	{
+		Supervisor.Tasks[Task].LastCheckIn = HAL_GetTick();
+	}
+}
+
+/*
+ * Check deadlines and refresh IWDG, put in SysTick_Handler
+ *
+ * @return - void
+ */
+void Supervisor_Tick(void)
+{
+	uint32_t Now = HAL_GetTick();
+	uint32_t Late;
+	uint32_t MaxLate = 0;
+	uint8_t StaleTask = SUPERVISOR_NO_TASK;
+
+	if (!Supervisor.Started || Supervisor.Stale
+			|| (Now - Supervisor.LastCheck) < SUPERVISOR_CHECK_PERIOD)
+	{
+		return;
+	}
+	Supervisor.LastCheck = Now;
+
+	if (!Supervisor.Paused && !Supervisor.Held)
+	{
+		// task which is late the most is reported
+		for (uint8_t i = 0; i < Supervisor.TaskCount; i++)
+		{
+			Late = Now - Supervisor.Tasks[i].LastCheckIn;
+			if (Late > Supervisor.Tasks[i].Deadline
+					&& (Late - Supervisor.Tasks[i].Deadline) >= MaxLate)
+			{
+				MaxLate = Late - Supervisor.Tasks[i].Deadline;
+				StaleTask = i;
+			}
+		}
+
+		if (StaleTask != SUPERVISOR_NO_TASK)
+		{
+			// no more refresh, IWDG resets node
+			Supervisor.Stale = 1;
+			Crash_Watchdog(StaleTask);
+			return;
+		}
+	}
+
+	HAL_IWDG_Refresh(&Supervisor.hiwdg);
+}
+
+/*
+ * Sleep until interrupt other than tick. Tick keeps running and refreshes IWDG,
+ * deadlines are not checked meanwhile.
+ *
+ * @return - void
+ */
+void Supervisor_Sleep(void)
+{
+	uint8_t Wake = 0;
+	uint8_t i;
+
+	Supervisor.Paused = 1;
+
+	// with interrupts masked WFI still ends on pending interrupt, its source is checked
+	// before the handler runs
+	__disable_irq();
+	while (!Wake)
+	{
+		HAL_PWR_EnterSLEEPMode(PWR_MAINREGULATOR_ON, PWR_SLEEPENTRY_WFI);
+
+		// tick is pending in SCB, peripheral interrupts in NVIC
+		for (i = 0; i < 8; i++)
+		{
+			if (NVIC->ISPR[i] & NVIC->ISER[i])
+			{
+				Wake = 1;
+			}
+		}
+
+		// let pending handlers run
+		__enable_irq();
+		__disable_irq();
+	}
+	__enable_irq();
+
+	// time of sleep does not count to deadlines
+	uint32_t Now = HAL_GetTick();
+	for (i = 0; i < Supervisor.TaskCount; i++)
+	{
+		Supervisor.Tasks[i].LastCheckIn = Now;
+	}
+
+	Supervisor.Paused = 0;
+}
+
+/*
+ * Stop checking deadlines before flash erase, IWDG is refreshed now so whole
+ * timeout is left for the erase. Can be called from interrupt.
+ *
+ * @return - void
+ */
+void Supervisor_Hold(void)
+{
+	Supervisor.Held = 1;
+
+	if (Supervisor.Started && !Supervisor.Stale)
+	{
+		HAL_IWDG_Refresh(&Supervisor.hiwdg);
+	}
+}
+
+/*
+ * Check deadlines again after flash erase, time of erase does not count to them.
+ * Can be called from interrupt.
+ *
+ * @return - void
+ */
+void Supervisor_Release(void)
+{
+	uint32_t Now = HAL_GetTick();
+
+	for (uint8_t i = 0; i < Supervisor.TaskCount; i++)
+	{
+		Supervisor.Tasks[i].LastCheckIn = Now;
+	}
+
+	Supervisor.Held = 0;
+}
+
+/*
+ * Name of registered task
+ *
+ * @param[Task] - task id
+ * @return - name
+ */
+const char *Supervisor_TaskName(uint8_t Task)
+{
+	if (Task >= Supervisor.TaskCount)
+	{
+		return "UNKNOWN";
+	}
+
+	return Supervisor.Tasks[Task].Name;
+}
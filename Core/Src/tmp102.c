@@ -1,514 +1,957 @@
-/*
- * tmp102.c
- *
- *  Created on: May 1, 2023
- *      Author: Ezrah Buki
- */
-
-#include "stdio.h"
-#include "math.h"
-#include "stdlib.h"
-#include "string.h"
-#include "usart.h"
-#include "tmp102.h"
-
-// edit register macro
-#define TMP102_EDITCONIFG_1BIT(config,value,offset)				(config) &= ~(1 << (offset)); (config) |= ((value) << (offset))
-#define TMP102_EDITCONIFG_2BIT(config,value,offset)				(config) &= ~(3 << (offset)); (config) |= ((value) << (offset))
-
-// check if the value defined by user is not to big for register macro
-#define TMP102_CHECK_REGISTER_1BIT(value,errorbuffer)			if((value) > 1) { (errorbuffer) = TMP102_ERR_WRONGCONFIG; return (errorbuffer);}
-#define TMP102_CHECK_REGISTER_2BIT(value,errorbuffer)			if((value) > 3) { (errorbuffer) = TMP102_ERR_WRONGCONFIG; return (errorbuffer);}
-
-//Convert to 2's complement, since temperature can be negative
-#define TMP102_CHECKSIGN_12BIT(value)							if (value > 0x7FF){value |= 0xF000;}
-#define TMP102_CHECKSIGN_13BIT(value)							if (value > 0xFFF){value |= 0xE000;}
-
-/*
- * Read 2 bytes from TMP102
- *
- * @param[*tmp102] - TMP102 sensor structure
- * @param[reg] - predefined registers address
- *
- * @return - 16 bit value from register
- */
-static uint16_t TMP102_Read16(TMP102_t *tmp102, uint8_t reg)
-{
-
-	// buffer for return data
-	uint8_t value[2];
-
-	// check if register address is more than 3
-	if (reg > TMP102_REG_MAXTEMP)
-	{
-		tmp102->ErrorCode = TMP102_ERR_WRONGREGISTERDEFINED;
-		return 0;
-	}
-
-	// address has to be shifted one place left because hal requires left allinged 7bit address
-	HAL_I2C_Mem_Read(tmp102->I2CHandle, ((tmp102->DeviceAdress) << 1), reg, 1,
-			value, 2, TMP102_I2C_TIMEOUT);
-
-	// write to 16 bits , two 8 bits registers
-	// 0000 0000 0000 0000 , first we write value[0] which has 8 significant bits as X << 4 XXXX XXXX
-	// 0000 0000 XXXX XXXX // << 4
-	// 0000 XXXX XXXX 0000 // then we push value[1] which has only 4 significant bits (YYYY 0000) >> 4
-	// 0000 XXXX XXXX YYYY // combined
-
-	// return 16 bit data
-	if (reg != TMP102_REG_CONFIG)
-	{
-		if (tmp102->Configuration.TMP102_EM == 0)
-		{
-			return (value[0] << 4) | (value[1] >> 4);
-		}
-		else
-		{
-			return (value[0] << 5) | (value[1] >> 3);
-		}
-	}
-	else
-	{
-		// use union structure for config register
-		return (value[0]) | (value[1] << 8);
-	}
-}
-
-/*
- * Write 2 bytes to TMP102
- *
- * @param[*tmp102] - TMP102 sensor structure
- * @param[reg] - predefined registers address
- * @param[value] - value to write
- * @return - 16 bit value from register
- */
-static void TMP102_Write16(TMP102_t *tmp102, uint8_t reg, uint16_t value)
-{
-	// buffer to take 2 bytes
-	uint8_t buf[2];
-
-	// check if register address is more than 3
-	if (reg > TMP102_REG_MAXTEMP)
-	{
-		tmp102->ErrorCode = TMP102_ERR_WRONGREGISTERDEFINED;
-		return;
-	}
-
-	// define bit structure for temp and config
-	if (reg != TMP102_REG_CONFIG)
-	{
-		buf[0] = value >> 4;
-		buf[1] = value << 4;
-	}
-	else
-	{
-		buf[0] = value;
-		buf[1] = value >> 8;
-	}
-
-	// write 16 bit data to TMP102
-	HAL_I2C_Mem_Write(tmp102->I2CHandle, ((tmp102->DeviceAdress) << 1), reg, 1,
-			buf, 2, TMP102_I2C_TIMEOUT);
-	tmp102->ErrorCode = TMP102_ERR_NOERROR;
-	return;
-}
-
-#if (TMP102_USE_FLOATNUMBERS == 1)
-/*
- * Calculate temperature and return float value
- *
- * @param[*tmp102] - TMP102 sensor structure
- * @return - temperature calculated from register
- */
-float TMP102GetTempFloat(TMP102_t *tmp102)
-{
-	// define variables
-	int16_t val = 0;
-	float temp_c = 0;
-
-	// check configuration
-	TMP102GetConfiguration(tmp102);
-
-	// read temp data from register
-	val = (int16_t) TMP102_Read16(tmp102, TMP102_REG_TEMP);
-
-	// 12 bit mode - normal
-	if (tmp102->Configuration.TMP102_EM == 0)
-	{
-		// check if value is negative
-		TMP102_CHECKSIGN_12BIT(val);
-	}
-	else
-	//13 bit mode - extended
-	{
-		TMP102_CHECKSIGN_13BIT(val);
-	}
-
-	// Convert to float temperature value (Celsius)
-	temp_c = (float) (val * 0.0625);
-
-	return temp_c;
-}
-#endif
-
-/*
- * Calculate temperature and return integer/decimal parts
- *
- * @param[*tmp102] - TMP102 sensor structure
- * @param[*value] - array of 2 bytes, [0] integer part , [1] decimal part
- * @return - void
- */
-void TMP102GetTempInt(TMP102_t *tmp102, int8_t *value)
-{
-	// define variables
-	int16_t val;
-	// read temp data from register
-	val = (int16_t) TMP102_Read16(tmp102, TMP102_REG_TEMP);
-
-	// 12 bit mode - normal
-	if (tmp102->Configuration.TMP102_EM == 0)
-	{
-		// check if value is negative
-		TMP102_CHECKSIGN_12BIT(val);
-	}
-	else
-	//13 bit mode - extended
-	{
-		TMP102_CHECKSIGN_13BIT(val);
-	}
-
-	// Convert to float temperature value (Celsius)
-	value[0] = val * TMP102_RESOLUTION; // // integer part
-	value[1] = ((val * 100) * TMP102_RESOLUTION) - (value[0] * 100); // decimal part
-}
-
-/*
- * Save configuration in TMP102 struct
- *
- * @param[*tmp102] - TMP102 sensor structure
- * @return - void
- */
-void TMP102GetConfiguration(TMP102_t *tmp102)
-{
-	// read uint16 config register value and convert it to bitfield
-	configConverter tempConfig;
-	tempConfig.i = TMP102_Read16(tmp102, TMP102_REG_CONFIG);
-	tmp102->Configuration = tempConfig.conf;
-}
-
-/*
- * Change configuration register of TMP102
- *
- * @param[*tmp102] - TMP102 sensor structure
- * @param[command] - predefined command TMP102_WRITE_XXX @commands
- * @param[value] - predefined register values TMP102_CR_XXX @config
- * @return - status msg
- */
-uint8_t TMP102WriteConfig(TMP102_t *tmp102, TMP102writeConfig command,
-		uint16_t value)
-{
-	// read raw config value
-	uint16_t config;
-	config = TMP102_Read16(tmp102, TMP102_REG_CONFIG);
-
-	// CONTROL REGISTER :
-	// MSB [CR1][CR0][AL][EM][0][0][0][0][OS][R1][R0][F1][F0][POL][TM][SD] LSB
-	//     [7]  [6]  [5] [4] [3][2][1][0] [7] [6] [5] [4] [3] [2] [1] [0]
-
-	TMP102_CHECK_REGISTER_2BIT(value, tmp102->ErrorCode);
-	// select command
-	switch (command)
-	{
-
-	case TMP102_WRITE_SHUTDOWN:
-
-		TMP102_CHECK_REGISTER_1BIT(value, tmp102->ErrorCode)
-		;
-		TMP102_EDITCONIFG_1BIT(config, value, TMP102_CR_OFFSET_SD)
-		;
-		break;
-
-	case TMP102_WRITE_THERMOSTATMODE:
-
-		TMP102_CHECK_REGISTER_1BIT(value, tmp102->ErrorCode)
-		;
-		TMP102_EDITCONIFG_1BIT(config, value, TMP102_CR_OFFSET_TM)
-		;
-		break;
-
-	case TMP102_WRITE_POLARITY:
-
-		TMP102_CHECK_REGISTER_1BIT(value, tmp102->ErrorCode)
-		;
-		TMP102_EDITCONIFG_1BIT(config, value, TMP102_CR_OFFSET_POL)
-		;
-		break;
-
-	case TMP102_WRITE_FALUTQUEUE:
-
-		TMP102_EDITCONIFG_2BIT(config, value, TMP102_CR_OFFSET_FQ)
-		;
-		break;
-
-	case TMP102_WRITE_EXTENDEDMODE:
-
-		TMP102_CHECK_REGISTER_1BIT(value, tmp102->ErrorCode)
-		;
-		TMP102_EDITCONIFG_1BIT(config, value, TMP102_CR_OFFSET_EM)
-		;
-		break;
-
-	case TMP102_WRITE_CONV_RATE:
-
-		TMP102_EDITCONIFG_2BIT(config, value, TMP102_CR_OFFSET_CR)
-		;
-		break;
-	}
-
-	// write new config to register
-	TMP102_Write16(tmp102, TMP102_REG_CONFIG, config);
-
-	// read updated config to structure
-	TMP102GetConfiguration(tmp102);
-	return tmp102->ErrorCode;
-}
-
-/*
- * Read from min and max temp registers and save it to struct
- *
- * @param[*tmp102] - TMP102 sensor structure
- * @return - void
- */
-void TMP102GetMinMaxTemp(TMP102_t *tmp102)
-{
-	// define variables
-	int16_t val_max, val_min;
-
-	// read temp data from register
-	val_max = (int16_t) TMP102_Read16(tmp102, TMP102_REG_MAXTEMP);
-	val_min = (int16_t) TMP102_Read16(tmp102, TMP102_REG_MINTEMP);
-
-	// Convert to 2's complement, since temperature can be negative
-
-	// 12 bit mode - normal
-	if (tmp102->Configuration.TMP102_EM == 0)
-	{
-		TMP102_CHECKSIGN_12BIT(val_min);
-		TMP102_CHECKSIGN_12BIT(val_max);
-	}
-	else
-	//13 bit mode - extended
-	{
-		TMP102_CHECKSIGN_13BIT(val_min);
-		TMP102_CHECKSIGN_13BIT(val_max);
-	}
-
-#if(TMP102_USE_FLOATNUMBERS == 1)
-	// Convert to float temperature value (Celsius)
-	tmp102->MaxTemperature = (float) (val_max * TMP102_RESOLUTION);
-	tmp102->MinTemperature = (float) (val_min * TMP102_RESOLUTION);
-#else
-	tmp102->MaxTemperatureIntegerPart = (val_max * TMP102_RESOLUTION);
-	tmp102->MaxTemperatureDecimalPart = abs(((val_max - (tmp102->MaxTemperatureIntegerPart / TMP102_RESOLUTION)) * 100) * TMP102_RESOLUTION);
-	tmp102->MinTemperatureIntegerPart = (val_min * TMP102_RESOLUTION);
-	tmp102->MinTemperatureDecimalPart = abs(((val_min - (tmp102->MinTemperatureIntegerPart / TMP102_RESOLUTION)) * 100) * TMP102_RESOLUTION);
-#endif
-
-}
-
-/*
- * Write new maximum and minimum temperature that will set the alarm
- * using floats
- *
- * @param[*tmp102] - TMP102 sensor structure
- * @param[temp] - temperature value to edit
- * @param[MinOrMax] - TMP102_MIN or TMP102_MAX @defines
- * @return - status
- */
-#if (TMP102_USE_FLOATNUMBERS == 1)
-uint8_t TMP102WriteMinMaxTempFloat(TMP102_t *tmp102, float temp,
-		uint8_t MinOrMax)
-{
-
-	// value send to function is too high or too low
-	// limits : -128 - +128 C
-	if (fabs(temp) > 128)
-	{
-		tmp102->ErrorCode = TMP102_ERR_TEMPOUTOFLIMITS;
-		return tmp102->ErrorCode;
-	}
-
-	uint16_t reg_value;
-
-	// count from float to digital min temperature
-	if (temp > 0)
-	{
-		reg_value = (uint16_t) (temp / TMP102_RESOLUTION);
-	}
-	else
-	{
-		reg_value = (uint16_t) (fabs(temp) / TMP102_RESOLUTION);
-		reg_value = ~reg_value;
-		reg_value += 1;
-	}
-
-	// write to min or max register
-	if (MinOrMax == TMP102_MIN)
-	{
-		TMP102_Write16(tmp102, TMP102_REG_MINTEMP, reg_value);
-	}
-	else if (MinOrMax == TMP102_MAX)
-	{
-		TMP102_Write16(tmp102, TMP102_REG_MAXTEMP, reg_value);
-	}
-
-	// read values in the registers
-	TMP102GetMinMaxTemp(tmp102);
-
-	// compare boundries
-	if (tmp102->MinTemperature > tmp102->MaxTemperature)
-	{
-		tmp102->ErrorCode = TMP102_ERR_WRONGMINMAXVALUES;
-		return tmp102->ErrorCode;
-	}
-
-	// check if the value written match value in the registers
-	// if value returned is not bigger/smaller than 0.0625 (resolution) then operation was successful
-	if (MinOrMax == TMP102_MIN)
-	{
-		if (fabs(tmp102->MinTemperature - temp) > TMP102_RESOLUTION)
-		{
-			tmp102->ErrorCode = TMP102_ERR_WRITEUNSUCCESSFUL;
-			return tmp102->ErrorCode;
-		}
-
-	}
-	else if (MinOrMax == TMP102_MAX)
-
-	{
-		if (fabs(tmp102->MaxTemperature - temp) > TMP102_RESOLUTION)
-		{
-			tmp102->ErrorCode = TMP102_ERR_WRITEUNSUCCESSFUL;
-			return tmp102->ErrorCode;
-		}
-	}
-
-	tmp102->ErrorCode = TMP102_ERR_NOERROR;
-	return tmp102->ErrorCode;
-
-}
-#else
-
-/*
- * Write new maximum and minimum temperature that will set the alarm
- * using int numbers
- * i have my doubts about using this function, using floats seems more user-friendly
- *
- * @param[*tmp102] - TMP102 sensor structure
- * @param[IntegerPart] - Integer part of temperature [-128 to 128]
- * @param[DecimalPart] - Decimal part of temperature [0 to 99]
- * @param[MinOrMax] - TMP102_MIN or TMP102_MAX (which boundary we edit) @defines
- * @return - status
- */
-uint8_t TMP102WriteMinMaxTempInt(TMP102_t *tmp102, int8_t IntegerPart, uint8_t DecimalPart, uint8_t MinOrMax)
-{
-	// putting arguments to this function can be confusing, i want user to define if sign is positive/negative in integer part
-	// but to make it look more "human friendly" i leave decimal number as always positive
-	// so now user can put in the function something like TMP102WriteMinMaxTempInt(tmp102, -20,65 , TEMP102_MIN)
-	// which make it look that the value is -20.65 (not like -20,-65 which would be true because decimal part is also negative in this case)
-
-
-	// lets work on 2 decimal digits
-	if (DecimalPart > 99)
-		{
-		DecimalPart /= 10;
-		}
-
-
-	uint16_t reg_value;
-
-	// calculate user value to TMP102 value
-	if (IntegerPart > 0)
-	{
-		reg_value = (IntegerPart / TMP102_RESOLUTION) + (DecimalPart / (100 * TMP102_RESOLUTION));
-	}
-	else
-	{
-		reg_value = (abs(IntegerPart) / TMP102_RESOLUTION) + (DecimalPart / (100 * TMP102_RESOLUTION)) ;
-		reg_value = ~reg_value;
-		reg_value += 1;
-	}
-
-	// write to min or max register
-	if (MinOrMax == TMP102_MIN)
-	{
-		TMP102_Write16(tmp102, TMP102_REG_MINTEMP, reg_value);
-	}
-	else if (MinOrMax == TMP102_MAX)
-	{
-		TMP102_Write16(tmp102, TMP102_REG_MAXTEMP, reg_value);
-	}
-
-	// read values in the registers to check
-	TMP102GetMinMaxTemp(tmp102);
-
-
-	// compare boundries
-		if (tmp102->MinTemperature > tmp102->MaxTemperature)
-		{
-			tmp102->ErrorCode = TMP102_ERR_WRONGMINMAXVALUES;
-			return tmp102->ErrorCode;
-		}
-
-	// check if the value written match value in the registers
-	if (MinOrMax == TMP102_MIN)
-	{
-		if (tmp102->MinTemperatureIntegerPart != IntegerPart || abs(tmp102->MinTemperatureDecimalPart - DecimalPart) > (TMP102_RESOLUTION * 100))
-		{
-			tmp102->ErrorCode = TMP102_ERR_WRITEUNSUCCESSFUL;
-			return tmp102->ErrorCode;
-		}
-
-	}
-	else if (MinOrMax == TMP102_MAX)
-
-	{
-		if (tmp102->MaxTemperatureIntegerPart != IntegerPart || abs(tmp102->MaxTemperatureDecimalPart - DecimalPart) > (TMP102_RESOLUTION * 100))
-		{
-			tmp102->ErrorCode = TMP102_ERR_WRITEUNSUCCESSFUL;
-			return tmp102->ErrorCode;
-		}
-	}
-
-	tmp102->ErrorCode = TMP102_ERR_NOERROR;
-	return tmp102->ErrorCode;
-}
-#endif
-
-/*
- * Assign i2c handler and device address. Read starting configuration and Min/Max temperature from registers and save it in structure.
- * More configuration options defined by user.
- *
- * @param[*tmp102] - TMP102 sensor structure
- * @param[*initI2CHandle] - i2c handler
- * @param[initDeviceAddress] - device address @address
- * @return - void
- */
-void TMP102Init(TMP102_t *tmp102, I2C_HandleTypeDef *initI2CHandle,
-		uint8_t initDeviceAddress)
-{
-
-	// Read basic information
-	tmp102->I2CHandle = initI2CHandle;
-	tmp102->DeviceAdress = initDeviceAddress;
-
-	// Write new config - defined by user
-	TMP102WriteConfig(tmp102, TMP102_WRITE_CONV_RATE, TMP102_CR_CONV_RATE_8Hz);
-	TMP102WriteConfig(tmp102, TMP102_WRITE_SHUTDOWN, TMP102_CR_MODE_CONTINUOS);
-	TMP102WriteConfig(tmp102, TMP102_WRITE_EXTENDEDMODE,
-	TMP102_CR_EXTENDED_ON);
-
-	TMP102GetConfiguration(tmp102);
-	TMP102GetMinMaxTemp(tmp102);
-}
-
+/*
+ * tmp102.c
+ *
+ *  Created on: May 1, 2023
+ *      Author: Ezrah Buki
+ */
+
+#include "stdio.h"
+#include "math.h"
+#include "stdlib.h"
+#include "string.h"
+#include "usart.h"
+#include "i2cbus.h"
+#include "tmp102.h"
+#include "sensor.h"
+
+// edit register macro
+#define TMP102_EDITCONIFG_1BIT(config,value,offset)				(config) &= ~(1 << (offset)); (config) |= ((value) << (offset))
+#define TMP102_EDITCONIFG_2BIT(config,value,offset)				(config) &= ~(3 << (offset)); (config) |= ((value) << (offset))
+
+// check if the value defined by user is not to big for register macro
+#define TMP102_CHECK_REGISTER_1BIT(value,errorbuffer)			if((value) > 1) { (errorbuffer) = TMP102_ERR_WRONGCONFIG; return (errorbuffer);}
+#define TMP102_CHECK_REGISTER_2BIT(value,errorbuffer)			if((value) > 3) { (errorbuffer) = TMP102_ERR_WRONGCONFIG; return (errorbuffer);}
+
+//Convert to 2's complement, since temperature can be negative
+#define TMP102_CHECKSIGN_12BIT(value)							if (value > 0x7FF){value |= 0xF000;}
+#define TMP102_CHECKSIGN_13BIT(value)							if (value > 0xFFF){value |= 0xE000;}
+
+// Order of registers in cache transactions, config first because it defines format of the rest
+static const uint8_t TMP102_CacheOrder[TMP102_REG_COUNT] = { TMP102_REG_CONFIG,
+		TMP102_REG_TEMP, TMP102_REG_MINTEMP, TMP102_REG_MAXTEMP };
+
+/*
+ * Read 2 bytes from TMP102
+ *
+ * @param[*tmp102] - TMP102 sensor structure
+ * @param[reg] - predefined registers address
+ *
+ * @return - 16 bit value from register
+ */
+static uint16_t TMP102_Read16(TMP102_t *tmp102, uint8_t reg)
+{
+
+	// buffer for return data
+	uint8_t value[2];
+
+	// check if register address is more than 3
+	if (reg > TMP102_REG_MAXTEMP)
+	{
+		tmp102->ErrorCode = TMP102_ERR_WRONGREGISTERDEFINED;
+		return 0;
+	}
+
+	// address has to be shifted one place left because hal requires left allinged 7bit address
+	// timeout follows bus speed, stuck bus is recovered
+	if (I2CBus_MemRead(tmp102->I2CHandle, ((tmp102->DeviceAdress) << 1), reg,
+			value, 2) != HAL_OK)
+	{
+		tmp102->ErrorCode = TMP102_ERR_BUSERROR;
+		return 0;
+	}
+
+	// write to 16 bits , two 8 bits registers
+	// 0000 0000 0000 0000 , first we write value[0] which has 8 significant bits as X << 4 XXXX XXXX
+	// 0000 0000 XXXX XXXX // << 4
+	// 0000 XXXX XXXX 0000 // then we push value[1] which has only 4 significant bits (YYYY 0000) >> 4
+	// 0000 XXXX XXXX YYYY // combined
+
+	// return 16 bit data
+	if (reg != TMP102_REG_CONFIG)
+	{
+		if (tmp102->Configuration.TMP102_EM == 0)
+		{
+			return (value[0] << 4) | (value[1] >> 4);
+		}
+		else
+		{
+			return (value[0] << 5) | (value[1] >> 3);
+		}
+	}
+	else
+	{
+		// use union structure for config register
+		return (value[0]) | (value[1] << 8);
+	}
+}
+
+/*
+ * Write 2 bytes to TMP102
+ *
+ * @param[*tmp102] - TMP102 sensor structure
+ * @param[reg] - predefined registers address
+ * @param[value] - value to write
+ * @return - 16 bit value from register
+ */
+static void TMP102_Write16(TMP102_t *tmp102, uint8_t reg, uint16_t value)
+{
+	// buffer to take 2 bytes
+	uint8_t buf[2];
+
+	// check if register address is more than 3
+	if (reg > TMP102_REG_MAXTEMP)
+	{
+		tmp102->ErrorCode = TMP102_ERR_WRONGREGISTERDEFINED;
+		return;
+	}
+
+	// define bit structure for temp and config
+	if (reg != TMP102_REG_CONFIG)
+	{
+		// limit registers use the same 12/13 bit format as temperature
+		if (tmp102->Configuration.TMP102_EM == 0)
+		{
+			buf[0] = value >> 4;
+			buf[1] = value << 4;
+		}
+		else
+		{
+			buf[0] = value >> 5;
+			buf[1] = value << 3;
+		}
+	}
+	else
+	{
+		buf[0] = value;
+		buf[1] = value >> 8;
+	}
+
+	// write 16 bit data to TMP102
+	if (I2CBus_MemWrite(tmp102->I2CHandle, ((tmp102->DeviceAdress) << 1), reg,
+			buf, 2) != HAL_OK)
+	{
+		tmp102->ErrorCode = TMP102_ERR_BUSERROR;
+		return;
+	}
+	tmp102->ErrorCode = TMP102_ERR_NOERROR;
+	return;
+}
+
+/*
+ * Get register from cache, read it from TMP102 only if it is not known
+ *
+ * @param[*tmp102] - TMP102 sensor structure
+ * @param[reg] - predefined registers address
+ * @return - 16 bit value of register
+ */
+static uint16_t TMP102_CacheRead(TMP102_t *tmp102, uint8_t reg)
+{
+	configConverter tempConfig;
+
+	if (!(tmp102->CacheValid & (1 << reg)))
+	{
+		tmp102->ErrorCode = TMP102_ERR_NOERROR;
+		tmp102->RegisterCache[reg] = TMP102_Read16(tmp102, reg);
+		if (tmp102->ErrorCode != TMP102_ERR_NOERROR)
+		{
+			return tmp102->RegisterCache[reg];
+		}
+		tmp102->CacheValid |= (1 << reg);
+
+		if (reg == TMP102_REG_CONFIG)
+		{
+			tempConfig.i = tmp102->RegisterCache[reg];
+			tmp102->Configuration = tempConfig.conf;
+		}
+	}
+
+	return tmp102->RegisterCache[reg];
+}
+
+/*
+ * Put new register value to cache, it is written to TMP102 at once
+ * or on TMP102CacheFlush if writes are deferred
+ *
+ * @param[*tmp102] - TMP102 sensor structure
+ * @param[reg] - predefined registers address
+ * @param[value] - value to write
+ * @return - void
+ */
+static void TMP102_CacheWrite(TMP102_t *tmp102, uint8_t reg, uint16_t value)
+{
+	configConverter tempConfig;
+
+	if (reg == TMP102_REG_CONFIG)
+	{
+		tempConfig.i = value;
+
+		// limit registers change format with extended mode, read them again when needed
+		if (tempConfig.conf.TMP102_EM != tmp102->Configuration.TMP102_EM)
+		{
+			tmp102->CacheValid &= (tmp102->CacheDirty | (1 << TMP102_REG_CONFIG));
+		}
+		tmp102->Configuration = tempConfig.conf;
+	}
+
+	tmp102->RegisterCache[reg] = value;
+	tmp102->CacheValid |= (1 << reg);
+	tmp102->CacheDirty |= (1 << reg);
+
+	if (!tmp102->CacheDeferred)
+	{
+		TMP102CacheFlush(tmp102);
+	}
+	else
+	{
+		tmp102->ErrorCode = TMP102_ERR_NOERROR;
+	}
+}
+
+/*
+ * Read all registers to cache, pending writes are kept
+ *
+ * @param[*tmp102] - TMP102 sensor structure
+ * @return - void
+ */
+void TMP102CacheRefresh(TMP102_t *tmp102)
+{
+	uint8_t i;
+
+	// mark all clean registers as unknown, then read them in order
+	tmp102->CacheValid &= tmp102->CacheDirty;
+	for (i = 0; i < TMP102_REG_COUNT; i++)
+	{
+		TMP102_CacheRead(tmp102, TMP102_CacheOrder[i]);
+	}
+}
+
+/*
+ * Collect register writes in cache until TMP102CacheFlush
+ *
+ * @param[*tmp102] - TMP102 sensor structure
+ * @return - void
+ */
+void TMP102CacheDefer(TMP102_t *tmp102)
+{
+	tmp102->CacheDeferred = 1;
+}
+
+/*
+ * Write all changed registers to TMP102, one transaction per register
+ * no matter how many times it was edited
+ *
+ * @param[*tmp102] - TMP102 sensor structure
+ * @return - status @error
+ */
+uint8_t TMP102CacheFlush(TMP102_t *tmp102)
+{
+	uint8_t i;
+	uint8_t reg;
+
+	tmp102->CacheDeferred = 0;
+	tmp102->ErrorCode = TMP102_ERR_NOERROR;
+
+	for (i = 0; i < TMP102_REG_COUNT; i++)
+	{
+		reg = TMP102_CacheOrder[i];
+
+		// temperature register is read-only
+		if (reg == TMP102_REG_TEMP || !(tmp102->CacheDirty & (1 << reg)))
+		{
+			continue;
+		}
+
+		TMP102_Write16(tmp102, reg, tmp102->RegisterCache[reg]);
+		if (tmp102->ErrorCode != TMP102_ERR_NOERROR)
+		{
+			// keep dirty, next flush will try again
+			return tmp102->ErrorCode;
+		}
+		tmp102->CacheDirty &= ~(1 << reg);
+	}
+
+	return tmp102->ErrorCode;
+}
+
+/*
+ * Convert raw temperature register bytes to signed value,
+ * used when register was read outside of driver (DMA)
+ *
+ * @param[*tmp102] - TMP102 sensor structure
+ * @param[*value] - 2 bytes read from temperature register
+ * @return - temperature in LSB (0.0625 deg C)
+ */
+int16_t TMP102RawToCounts(TMP102_t *tmp102, const uint8_t *value)
+{
+	int16_t val;
+
+	// 12 bit mode - normal
+	if (tmp102->Configuration.TMP102_EM == 0)
+	{
+		val = (value[0] << 4) | (value[1] >> 4);
+		TMP102_CHECKSIGN_12BIT(val);
+	}
+	else
+	//13 bit mode - extended
+	{
+		val = (value[0] << 5) | (value[1] >> 3);
+		TMP102_CHECKSIGN_13BIT(val);
+	}
+
+	return val;
+}
+
+/*
+ * Read temperature register, when read fails last good value is used and sensor is stale
+ *
+ * @param[*tmp102] - TMP102 sensor structure
+ * @return - temperature in LSB (0.0625 deg C)
+ */
+static int16_t TMP102_ReadTemp(TMP102_t *tmp102)
+{
+	int16_t val;
+
+	// format of temperature depends on extended mode bit
+	tmp102->ErrorCode = TMP102_ERR_NOERROR;
+	TMP102_CacheRead(tmp102, TMP102_REG_CONFIG);
+	val = (int16_t) TMP102_Read16(tmp102, TMP102_REG_TEMP);
+
+	if (tmp102->ErrorCode != TMP102_ERR_NOERROR)
+	{
+		tmp102->Stale = 1;
+		val = tmp102->RegisterCache[TMP102_REG_TEMP];
+	}
+	else
+	{
+		tmp102->Stale = 0;
+		tmp102->RegisterCache[TMP102_REG_TEMP] = val;
+	}
+
+	// 12 bit mode - normal
+	if (tmp102->Configuration.TMP102_EM == 0)
+	{
+		TMP102_CHECKSIGN_12BIT(val);
+	}
+	else
+	//13 bit mode - extended
+	{
+		TMP102_CHECKSIGN_13BIT(val);
+	}
+
+	return val;
+}
+
+/*
+ * Read temperature register, in interrupt mode it also clears ALERT pin
+ *
+ * @param[*tmp102] - TMP102 sensor structure
+ * @return - temperature in LSB (0.0625 deg C), last good value when Stale is set
+ */
+int16_t TMP102GetTempCounts(TMP102_t *tmp102)
+{
+	return TMP102_ReadTemp(tmp102);
+}
+
+#if (TMP102_USE_FLOATNUMBERS == 1)
+/*
+ * Calculate temperature and return float value
+ *
+ * @param[*tmp102] - TMP102 sensor structure
+ * @return - temperature calculated from register, last good value when Stale is set
+ */
+float TMP102GetTempFloat(TMP102_t *tmp102)
+{
+	// define variables
+	int16_t val = 0;
+	float temp_c = 0;
+
+	// read temp data from register, configuration is read only if it is not cached
+	val = TMP102_ReadTemp(tmp102);
+
+	// Convert to float temperature value (Celsius)
+	temp_c = (float) (val * 0.0625);
+
+	return temp_c;
+}
+#endif
+
+/*
+ * Calculate temperature and return integer/decimal parts
+ *
+ * @param[*tmp102] - TMP102 sensor structure
+ * @param[*value] - array of 2 bytes, [0] integer part , [1] decimal part
+ * @return - void
+ */
+void TMP102GetTempInt(TMP102_t *tmp102, int8_t *value)
+{
+	// define variables
+	int16_t val;
+	// read temp data from register, configuration is read only if it is not cached
+	val = TMP102_ReadTemp(tmp102);
+
+	// Convert to float temperature value (Celsius)
+	value[0] = val * TMP102_RESOLUTION; // // integer part
+	value[1] = ((val * 100) * TMP102_RESOLUTION) - (value[0] * 100); // decimal part
+}
+
+/*
+ * Save configuration in TMP102 struct
+ *
+ * @param[*tmp102] - TMP102 sensor structure
+ * @return - void
+ */
+void TMP102GetConfiguration(TMP102_t *tmp102)
+{
+	// pending write is newer than register content
+	if (tmp102->CacheDirty & (1 << TMP102_REG_CONFIG))
+	{
+		return;
+	}
+
+	// read uint16 config register value and convert it to bitfield
+	tmp102->CacheValid &= ~(1 << TMP102_REG_CONFIG);
+	TMP102_CacheRead(tmp102, TMP102_REG_CONFIG);
+}
+
+/*
+ * Change configuration register of TMP102.
+ * Edits cached register, between TMP102CacheDefer and TMP102CacheFlush
+ * all changes are written in one transaction.
+ *
+ * @param[*tmp102] - TMP102 sensor structure
+ * @param[command] - predefined command TMP102_WRITE_XXX @commands
+ * @param[value] - predefined register values TMP102_CR_XXX @config
+ * @return - status msg
+ */
+uint8_t TMP102WriteConfig(TMP102_t *tmp102, TMP102writeConfig command,
+		uint16_t value)
+{
+	// raw config value, from cache if known
+	uint16_t config;
+	tmp102->ErrorCode = TMP102_ERR_NOERROR;
+	config = TMP102_CacheRead(tmp102, TMP102_REG_CONFIG);
+	if (tmp102->ErrorCode != TMP102_ERR_NOERROR)
+	{
+		return tmp102->ErrorCode;
+	}
+
+	// CONTROL REGISTER :
+	// MSB [CR1][CR0][AL][EM][0][0][0][0][OS][R1][R0][F1][F0][POL][TM][SD] LSB
+	//     [7]  [6]  [5] [4] [3][2][1][0] [7] [6] [5] [4] [3] [2] [1] [0]
+
+	TMP102_CHECK_REGISTER_2BIT(value, tmp102->ErrorCode);
+	// select command
+	switch (command)
+	{
+
+	case TMP102_WRITE_SHUTDOWN:
+
+		TMP102_CHECK_REGISTER_1BIT(value, tmp102->ErrorCode)
+		;
+		TMP102_EDITCONIFG_1BIT(config, value, TMP102_CR_OFFSET_SD)
+		;
+		break;
+
+	case TMP102_WRITE_THERMOSTATMODE:
+
+		TMP102_CHECK_REGISTER_1BIT(value, tmp102->ErrorCode)
+		;
+		TMP102_EDITCONIFG_1BIT(config, value, TMP102_CR_OFFSET_TM)
+		;
+		break;
+
+	case TMP102_WRITE_POLARITY:
+
+		TMP102_CHECK_REGISTER_1BIT(value, tmp102->ErrorCode)
+		;
+		TMP102_EDITCONIFG_1BIT(config, value, TMP102_CR_OFFSET_POL)
+		;
+		break;
+
+	case TMP102_WRITE_FALUTQUEUE:
+
+		TMP102_EDITCONIFG_2BIT(config, value, TMP102_CR_OFFSET_FQ)
+		;
+		break;
+
+	case TMP102_WRITE_EXTENDEDMODE:
+
+		TMP102_CHECK_REGISTER_1BIT(value, tmp102->ErrorCode)
+		;
+		TMP102_EDITCONIFG_1BIT(config, value, TMP102_CR_OFFSET_EM)
+		;
+		break;
+
+	case TMP102_WRITE_CONV_RATE:
+
+		TMP102_EDITCONIFG_2BIT(config, value, TMP102_CR_OFFSET_CR)
+		;
+		break;
+
+	case TMP102_WRITE_ONESHOT:
+
+		TMP102_CHECK_REGISTER_1BIT(value, tmp102->ErrorCode)
+		;
+		TMP102_EDITCONIFG_1BIT(config, value, TMP102_CR_OFFSET_OS)
+		;
+		break;
+	}
+
+	// write new config to cache, structure is updated with it
+	TMP102_CacheWrite(tmp102, TMP102_REG_CONFIG, config);
+	return tmp102->ErrorCode;
+}
+
+/*
+ * Start single conversion, device has to be in shutdown mode.
+ * Uses configuration saved in structure, so it is one i2c write only.
+ * Result is ready after TMP102_CONVERSION_TIME.
+ *
+ * @param[*tmp102] - TMP102 sensor structure
+ * @return - void
+ */
+void TMP102StartOneShot(TMP102_t *tmp102)
+{
+	configConverter tempConfig;
+
+	tempConfig.conf = tmp102->Configuration;
+	tempConfig.conf.TMP102_SD = TMP102_CR_MODE_SHUTDOWN;
+	tempConfig.conf.TMP102_OS = TMP102_CR_ONESHOT;
+
+	TMP102_Write16(tmp102, TMP102_REG_CONFIG, tempConfig.i);
+}
+
+/*
+ * Check if one-shot conversion is finished, OS bit reads 0 during conversion
+ *
+ * @param[*tmp102] - TMP102 sensor structure
+ * @return - 1 conversion done, 0 conversion in progress
+ */
+uint8_t TMP102IsConversionDone(TMP102_t *tmp102)
+{
+	configConverter tempConfig;
+
+	tempConfig.i = TMP102_Read16(tmp102, TMP102_REG_CONFIG);
+
+	return tempConfig.conf.TMP102_OS;
+}
+
+#if (TMP102_USE_FLOATNUMBERS == 1)
+/*
+ * Set THIGH/TLOW and switch ALERT pin to interrupt mode, active low.
+ * ALERT goes active when temperature exceeds THIGH, is cleared by reading any register,
+ * and goes active again when temperature falls below TLOW.
+ *
+ * @param[*tmp102] - TMP102 sensor structure
+ * @param[Low] - TLOW in deg C
+ * @param[High] - THIGH in deg C
+ * @param[FaultQueue] - consecutive faults needed for alert @Fault queue
+ * @return - status @error
+ */
+uint8_t TMP102ConfigureAlert(TMP102_t *tmp102, float Low, float High,
+		uint8_t FaultQueue)
+{
+	if (Low >= High)
+	{
+		tmp102->ErrorCode = TMP102_ERR_WRONGMINMAXVALUES;
+		return tmp102->ErrorCode;
+	}
+
+	TMP102GetMinMaxTemp(tmp102);
+
+	// keep TLOW < THIGH after every single write
+	if (Low > tmp102->MaxTemperature)
+	{
+		TMP102WriteMinMaxTempFloat(tmp102, High, TMP102_MAX);
+		TMP102WriteMinMaxTempFloat(tmp102, Low, TMP102_MIN);
+	}
+	else
+	{
+		TMP102WriteMinMaxTempFloat(tmp102, Low, TMP102_MIN);
+		TMP102WriteMinMaxTempFloat(tmp102, High, TMP102_MAX);
+	}
+
+	if (tmp102->ErrorCode != TMP102_ERR_NOERROR)
+	{
+		return tmp102->ErrorCode;
+	}
+
+	// one write for all alert bits
+	TMP102CacheDefer(tmp102);
+	TMP102WriteConfig(tmp102, TMP102_WRITE_FALUTQUEUE, FaultQueue);
+	TMP102WriteConfig(tmp102, TMP102_WRITE_POLARITY, TMP102_CR_POLARITY_LOW);
+	TMP102WriteConfig(tmp102, TMP102_WRITE_THERMOSTATMODE,
+			TMP102_CR_THERMOSTAT_IT);
+	return TMP102CacheFlush(tmp102);
+}
+#endif
+
+/*
+ * Read from min and max temp registers and save it to struct,
+ * registers are read from bus only if they are not cached
+ *
+ * @param[*tmp102] - TMP102 sensor structure
+ * @return - void
+ */
+void TMP102GetMinMaxTemp(TMP102_t *tmp102)
+{
+	// define variables
+	int16_t val_max, val_min;
+
+	// read temp data from register
+	val_max = (int16_t) TMP102_CacheRead(tmp102, TMP102_REG_MAXTEMP);
+	val_min = (int16_t) TMP102_CacheRead(tmp102, TMP102_REG_MINTEMP);
+
+	// Convert to 2's complement, since temperature can be negative
+
+	// 12 bit mode - normal
+	if (tmp102->Configuration.TMP102_EM == 0)
+	{
+		TMP102_CHECKSIGN_12BIT(val_min);
+		TMP102_CHECKSIGN_12BIT(val_max);
+	}
+	else
+	//13 bit mode - extended
+	{
+		TMP102_CHECKSIGN_13BIT(val_min);
+		TMP102_CHECKSIGN_13BIT(val_max);
+	}
+
+#if(TMP102_USE_FLOATNUMBERS == 1)
+	// Convert to float temperature value (Celsius)
+	tmp102->MaxTemperature = (float) (val_max * TMP102_RESOLUTION);
+	tmp102->MinTemperature = (float) (val_min * TMP102_RESOLUTION);
+#else
+	tmp102->MaxTemperatureIntegerPart = (val_max * TMP102_RESOLUTION);
+	tmp102->MaxTemperatureDecimalPart = abs(((val_max - (tmp102->MaxTemperatureIntegerPart / TMP102_RESOLUTION)) * 100) * TMP102_RESOLUTION);
+	tmp102->MinTemperatureIntegerPart = (val_min * TMP102_RESOLUTION);
+	tmp102->MinTemperatureDecimalPart = abs(((val_min - (tmp102->MinTemperatureIntegerPart / TMP102_RESOLUTION)) * 100) * TMP102_RESOLUTION);
+#endif
+
+}
+
+/*
+ * Write new maximum and minimum temperature that will set the alarm
+ * using floats
+ *
+ * @param[*tmp102] - TMP102 sensor structure
+ * @param[temp] - temperature value to edit
+ * @param[MinOrMax] - TMP102_MIN or TMP102_MAX @defines
+ * @return - status
+ */
+#if (TMP102_USE_FLOATNUMBERS == 1)
+uint8_t TMP102WriteMinMaxTempFloat(TMP102_t *tmp102, float temp,
+		uint8_t MinOrMax)
+{
+
+	// value send to function is too high or too low
+	// limits : -128 - +128 C
+	if (fabs(temp) > 128)
+	{
+		tmp102->ErrorCode = TMP102_ERR_TEMPOUTOFLIMITS;
+		return tmp102->ErrorCode;
+	}
+
+	uint16_t reg_value;
+
+	// count from float to digital min temperature
+	if (temp > 0)
+	{
+		reg_value = (uint16_t) (temp / TMP102_RESOLUTION);
+	}
+	else
+	{
+		reg_value = (uint16_t) (fabs(temp) / TMP102_RESOLUTION);
+		reg_value = ~reg_value;
+		reg_value += 1;
+	}
+
+	// write to min or max register
+	if (MinOrMax == TMP102_MIN)
+	{
+		TMP102_CacheWrite(tmp102, TMP102_REG_MINTEMP, reg_value);
+	}
+	else if (MinOrMax == TMP102_MAX)
+	{
+		TMP102_CacheWrite(tmp102, TMP102_REG_MAXTEMP, reg_value);
+	}
+
+	if (tmp102->ErrorCode != TMP102_ERR_NOERROR)
+	{
+		return tmp102->ErrorCode;
+	}
+
+	// read values in the registers
+	TMP102GetMinMaxTemp(tmp102);
+
+	// compare boundries
+	if (tmp102->MinTemperature > tmp102->MaxTemperature)
+	{
+		tmp102->ErrorCode = TMP102_ERR_WRONGMINMAXVALUES;
+		return tmp102->ErrorCode;
+	}
+
+	// check if the value written match value in the registers
+	// if value returned is not bigger/smaller than 0.0625 (resolution) then operation was successful
+	if (MinOrMax == TMP102_MIN)
+	{
+		if (fabs(tmp102->MinTemperature - temp) > TMP102_RESOLUTION)
+		{
+			tmp102->ErrorCode = TMP102_ERR_WRITEUNSUCCESSFUL;
+			return tmp102->ErrorCode;
+		}
+
+	}
+	else if (MinOrMax == TMP102_MAX)
+
+	{
+		if (fabs(tmp102->MaxTemperature - temp) > TMP102_RESOLUTION)
+		{
+			tmp102->ErrorCode = TMP102_ERR_WRITEUNSUCCESSFUL;
+			return tmp102->ErrorCode;
+		}
+	}
+
+	tmp102->ErrorCode = TMP102_ERR_NOERROR;
+	return tmp102->ErrorCode;
+
+}
+#else
+
+/*
+ * Write new maximum and minimum temperature that will set the alarm
+ * using int numbers
+ * i have my doubts about using this function, using floats seems more user-friendly
+ *
+ * @param[*tmp102] - TMP102 sensor structure
+ * @param[IntegerPart] - Integer part of temperature [-128 to 128]
+ * @param[DecimalPart] - Decimal part of temperature [0 to 99]
+ * @param[MinOrMax] - TMP102_MIN or TMP102_MAX (which boundary we edit) @defines
+ * @return - status
+ */
+uint8_t TMP102WriteMinMaxTempInt(TMP102_t *tmp102, int8_t IntegerPart, uint8_t DecimalPart, uint8_t MinOrMax)
+{
+	// putting arguments to this function can be confusing, i want user to define if sign is positive/negative in integer part
+	// but to make it look more "human friendly" i leave decimal number as always positive
+	// so now user can put in the function something like TMP102WriteMinMaxTempInt(tmp102, -20,65 , TEMP102_MIN)
+	// which make it look that the value is -20.65 (not like -20,-65 which would be true because decimal part is also negative in this case)
+
+
+	// lets work on 2 decimal digits
+	if (DecimalPart > 99)
+		{
+		DecimalPart /= 10;
+		}
+
+
+	uint16_t reg_value;
+
+	// calculate user value to TMP102 value
+	if (IntegerPart > 0)
+	{
+		reg_value = (IntegerPart / TMP102_RESOLUTION) + (DecimalPart / (100 * TMP102_RESOLUTION));
+	}
+	else
+	{
+		reg_value = (abs(IntegerPart) / TMP102_RESOLUTION) + (DecimalPart / (100 * TMP102_RESOLUTION)) ;
+		reg_value = ~reg_value;
+		reg_value += 1;
+	}
+
+	// write to min or max register
+	if (MinOrMax == TMP102_MIN)
+	{
+		TMP102_CacheWrite(tmp102, TMP102_REG_MINTEMP, reg_value);
+	}
+	else if (MinOrMax == TMP102_MAX)
+	{
+		TMP102_CacheWrite(tmp102, TMP102_REG_MAXTEMP, reg_value);
+	}
+
+	if (tmp102->ErrorCode != TMP102_ERR_NOERROR)
+	{
+		return tmp102->ErrorCode;
+	}
+
+	// read values in the registers to check
+	TMP102GetMinMaxTemp(tmp102);
+
+
+	// compare boundries
+#if(TMP102_USE_FLOATNUMBERS == 1)
+		if (tmp102->MinTemperature > tmp102->MaxTemperature)
+#else
+		// decimal part has no sign, it makes negative value smaller
+		if (tmp102->MinTemperatureIntegerPart > tmp102->MaxTemperatureIntegerPart
+				|| (tmp102->MinTemperatureIntegerPart == tmp102->MaxTemperatureIntegerPart
+						&& ((tmp102->MinTemperatureIntegerPart < 0) ?
+								tmp102->MinTemperatureDecimalPart < tmp102->MaxTemperatureDecimalPart :
+								tmp102->MinTemperatureDecimalPart > tmp102->MaxTemperatureDecimalPart)))
+#endif
+		{
+			tmp102->ErrorCode = TMP102_ERR_WRONGMINMAXVALUES;
+			return tmp102->ErrorCode;
+		}
+
+	// check if the value written match value in the registers
+	if (MinOrMax == TMP102_MIN)
+	{
+		if (tmp102->MinTemperatureIntegerPart != IntegerPart || abs(tmp102->MinTemperatureDecimalPart - DecimalPart) > (TMP102_RESOLUTION * 100))
+		{
+			tmp102->ErrorCode = TMP102_ERR_WRITEUNSUCCESSFUL;
+			return tmp102->ErrorCode;
+		}
+
+	}
+	else if (MinOrMax == TMP102_MAX)
+
+	{
+		if (tmp102->MaxTemperatureIntegerPart != IntegerPart || abs(tmp102->MaxTemperatureDecimalPart - DecimalPart) > (TMP102_RESOLUTION * 100))
+		{
+			tmp102->ErrorCode = TMP102_ERR_WRITEUNSUCCESSFUL;
+			return tmp102->ErrorCode;
+		}
+	}
+
+	tmp102->ErrorCode = TMP102_ERR_NOERROR;
+	return tmp102->ErrorCode;
+}
+#endif
+
+/*
+ * Assign i2c handler and device address. Read starting configuration and Min/Max temperature from registers and save it in structure.
+ * More configuration options defined by user.
+ *
+ * @param[*tmp102] - TMP102 sensor structure
+ * @param[*initI2CHandle] - i2c handler
+ * @param[initDeviceAddress] - device address @address
+ * @return - void
+ */
+void TMP102Init(TMP102_t *tmp102, I2C_HandleTypeDef *initI2CHandle,
+		uint8_t initDeviceAddress)
+{
+
+	// Read basic information
+	tmp102->I2CHandle = initI2CHandle;
+	tmp102->DeviceAdress = initDeviceAddress;
+	tmp102->CacheValid = 0;
+	tmp102->CacheDirty = 0;
+	tmp102->CacheDeferred = 0;
+
+	// Read all registers
+	TMP102CacheRefresh(tmp102);
+
+	// Write new config - defined by user, sent as one write
+	TMP102CacheDefer(tmp102);
+	TMP102WriteConfig(tmp102, TMP102_WRITE_CONV_RATE, TMP102_CR_CONV_RATE_8Hz);
+	TMP102WriteConfig(tmp102, TMP102_WRITE_SHUTDOWN, TMP102_CR_MODE_CONTINUOS);
+	TMP102WriteConfig(tmp102, TMP102_WRITE_EXTENDEDMODE,
+	TMP102_CR_EXTENDED_ON);
+	TMP102CacheFlush(tmp102);
+
+	TMP102GetMinMaxTemp(tmp102);
+}
+
+/*
+ * Sensor interface (sensor.h), TMP102_t is in Sensor->Device
+ */
+static uint8_t TMP102_SensorInit(Sensor_t *Sensor)
+{
+	TMP102Init(&Sensor->Device.TMP102, Sensor->I2CHandle, Sensor->Address);
+
+	return (Sensor->Device.TMP102.ErrorCode == TMP102_ERR_NOERROR) ?
+			SENSOR_OK : SENSOR_ERR_BUS;
+}
+
+static uint8_t TMP102_SensorStartSample(Sensor_t *Sensor)
+{
+	TMP102StartOneShot(&Sensor->Device.TMP102);
+
+	return (Sensor->Device.TMP102.ErrorCode == TMP102_ERR_NOERROR) ?
+			SENSOR_OK : SENSOR_ERR_BUS;
+}
+
+static HAL_StatusTypeDef TMP102_SensorReadRaw(Sensor_t *Sensor, uint8_t *Raw)
+{
+	return I2CBus_MemRead(Sensor->I2CHandle, (Sensor->Address << 1),
+			TMP102_REG_TEMP, Raw, 2);
+}
+
+static HAL_StatusTypeDef TMP102_SensorReadRawDMA(Sensor_t *Sensor, uint8_t *Raw)
+{
+	return HAL_I2C_Mem_Read_DMA(Sensor->I2CHandle, (Sensor->Address << 1),
+			TMP102_REG_TEMP, 1, Raw, 2);
+}
+
+static int16_t TMP102_SensorConvert(Sensor_t *Sensor, const uint8_t *Raw)
+{
+	return TMP102RawToCounts(&Sensor->Device.TMP102, Raw);
+}
+
+static uint8_t TMP102_SensorSetPowerMode(Sensor_t *Sensor, uint8_t Mode)
+{
+	return (TMP102WriteConfig(&Sensor->Device.TMP102, TMP102_WRITE_SHUTDOWN,
+			(Mode == SENSOR_POWER_ONESHOT) ?
+					TMP102_CR_MODE_SHUTDOWN : TMP102_CR_MODE_CONTINUOS)
+			== TMP102_ERR_NOERROR) ? SENSOR_OK : SENSOR_ERR_BUS;
+}
+
+static uint8_t TMP102_SensorSetRate(Sensor_t *Sensor, uint32_t Period)
+{
+	uint16_t Rate;
+
+	// slowest conversion rate which still gives new value for every read
+	if (Period >= 4000)
+	{
+		Rate = TMP102_CR_CONV_RATE_025Hz;
+	}
+	else if (Period >= 1000)
+	{
+		Rate = TMP102_CR_CONV_RATE_1Hz;
+	}
+	else if (Period >= 250)
+	{
+		Rate = TMP102_CR_CONV_RATE_4Hz;
+	}
+	else
+	{
+		Rate = TMP102_CR_CONV_RATE_8Hz;
+	}
+
+	return (TMP102WriteConfig(&Sensor->Device.TMP102, TMP102_WRITE_CONV_RATE, Rate)
+			== TMP102_ERR_NOERROR) ? SENSOR_OK : SENSOR_ERR_BUS;
+}
+
+#if (TMP102_USE_FLOATNUMBERS == 1)
+static uint8_t TMP102_SensorSetAlert(Sensor_t *Sensor, int16_t Low, int16_t High)
+{
+	return (TMP102ConfigureAlert(&Sensor->Device.TMP102, Low * TMP102_RESOLUTION,
+			High * TMP102_RESOLUTION, TMP102_CR_FALUTQUEUE_2F)
+			== TMP102_ERR_NOERROR) ? SENSOR_OK : SENSOR_ERR_BUS;
+}
+#endif
+
+const Sensor_Driver_t TMP102_Driver =
+{
+	.Name = "TMP102",
+	.Unit = "deg C",
+	.Quantity = SENSOR_QUANTITY_TEMPERATURE,
+	.Resolution = 62500,						// 0.0625 deg C
+	.FirstAddress = TMP102_ADDRESS,
+	.AddressCount = 4,							// ADD0 to GND, V+, SDA, SCL
+	.RawSize = 2,
+	.TestRegister = TMP102_REG_MINTEMP,			// OS bit of config changes in one-shot mode
+	.ConversionTime = TMP102_CONVERSION_TIME,
+	.Init = TMP102_SensorInit,
+	.StartSample = TMP102_SensorStartSample,
+	.ReadRaw = TMP102_SensorReadRaw,
+	.ReadRawDMA = TMP102_SensorReadRawDMA,
+	.Convert = TMP102_SensorConvert,
+	.SetPowerMode = TMP102_SensorSetPowerMode,
+	.SetRate = TMP102_SensorSetRate,
+#if (TMP102_USE_FLOATNUMBERS == 1)
+	.SetAlert = TMP102_SensorSetAlert,
+#else
+	.SetAlert = NULL,
+#endif
+};
@@ -0,0 +1,779 @@
+/*
+ * tmp102_array.c
+ *
+ *  Created on: 19 October 2026
+ */
+
+/* All sensors found by i2c scan are handled together, each through its driver (sensor.h).
+ * Raw samples are read back-to-back, every finished DMA transfer starts the next one
+ * from callback.
+ *
+ * In one-shot mode sensors stay in shutdown. Read request triggers one conversion on
+ * every sensor, TMP102ArrayProcess starts DMA chain when conversion time has passed.
+ *
+ * With adaptive sampling read period is TMP102_ARRAY_PERIOD_SLOW until temperature
+ * starts to change, then TMP102_ARRAY_PERIOD_FAST until it is stable again.
+ *
+ * For user to configure in CubeMX :
+ * I2Cx_RX DMA, Normal mode, Peripheral to memory, byte width
+ * I2Cx event and error interrupt, DMA stream global interrupt
+ *
+ * put TMP102Array_MemRxCpltCallback in HAL_I2C_MemRxCpltCallback in main.c
+ * put TMP102Array_ErrorCallback in HAL_I2C_ErrorCallback in main.c, after I2CBus_ErrorCallback
+ *
+ * Sensor which was not read in last round is stale, its newest sample is old.
+ * DMA chain which does not finish in time is aborted and the bus is recovered (i2cbus.c).
+ *
+ * if using ALERT pin : GPIO EXTI falling edge with pull-up (ALERT is open drain),
+ * put TMP102Array_EXTICallback in HAL_GPIO_EXTI_Callback in main.c
+ * ALERT lines of all sensors can be connected together.
+ */
+
+#include "main.h"
+#include "string.h"
+#include "utils.h"
+#include "log.h"
+#include "stdlib.h"
+#include "i2cbus.h"
+#include "tmp102_array.h"
+
+/*
+ * Start DMA read of raw sample of current sensor
+ *
+ * @param[*array] - sensor array structure
+ * @return - HAL status
+ */
+static HAL_StatusTypeDef TMP102ArrayReadCurrent(TMP102Array_t *array)
+{
+	TMP102ArraySensor_t *Entry = &array->Sensors[array->Current];
+
+	// transfer would fail on stuck bus, sensors wait for next round
+	if (I2CBus_IsRecoveryPending())
+	{
+		return HAL_BUSY;
+	}
+
+	return Entry->Sensor.Driver->ReadRawDMA(&Entry->Sensor, Entry->RawBuffer);
+}
+
+/*
+ * Move to next sensor in chain, finish chain after last sensor
+ *
+ * @param[*array] - sensor array structure
+ * @return - void
+ */
+static void TMP102ArrayNext(TMP102Array_t *array)
+{
+	array->Current++;
+
+	while (array->Current < array->SensorCount)
+	{
+		if (TMP102ArrayReadCurrent(array) == HAL_OK)
+		{
+			return;
+		}
+		// bus busy - skip sensor in this round
+		array->Sensors[array->Current].ErrorCount++;
+		array->Sensors[array->Current].Stale = 1;
+		array->Current++;
+	}
+
+	array->State = TMP102_ARRAY_IDLE;
+	array->RoundDone = 1;
+}
+
+/*
+ * End DMA chain which did not finish, sensors not read in this round are stale
+ *
+ * @param[*array] - sensor array structure
+ * @return - void
+ */
+static void TMP102ArrayAbort(TMP102Array_t *array)
+{
+	while (array->Current < array->SensorCount)
+	{
+		array->Sensors[array->Current].ErrorCount++;
+		array->Sensors[array->Current].Stale = 1;
+		array->Current++;
+	}
+
+	array->State = TMP102_ARRAY_IDLE;
+	array->RoundDone = 1;
+}
+
+/*
+ * Change read period of sampler and conversion rate of sensors in continuous mode
+ *
+ * @param[*array] - sensor array structure
+ * @param[Period] - TMP102_ARRAY_PERIOD_SLOW or TMP102_ARRAY_PERIOD_FAST
+ * @param[Slope] - slope that caused the change, for log
+ * @return - void
+ */
+static void TMP102ArrayChangeRate(TMP102Array_t *array, uint32_t Period,
+		int32_t Slope)
+{
+	uint8_t i;
+
+	array->ReadPeriod = Period;
+	array->StableCount = 0;
+
+	// one-shot sensors convert only on request, conversion rate does not matter
+	if (!array->OneShot)
+	{
+		for (i = 0; i < array->SensorCount; i++)
+		{
+			Sensor_t *Sensor = &array->Sensors[i].Sensor;
+			Sensor->Driver->SetRate(Sensor, Period);
+		}
+	}
+
+	LOG_INFO(LOG_MSG_TMP102_RATE_CHANGED, (unsigned long) Period, (long) Slope);
+}
+
+/*
+ * Check slope of all sensors after each round and switch between slow and fast rate.
+ * Fast rate is kept until slope is under TMP102_ARRAY_SLOPE_STABLE for
+ * TMP102_ARRAY_STABLE_COUNT rounds, so noise around one threshold does not toggle it.
+ *
+ * @param[*array] - sensor array structure
+ * @return - void
+ */
+static void TMP102ArrayAdaptRate(TMP102Array_t *array)
+{
+	uint8_t i;
+	int32_t Slope;
+	int32_t MaxSlope = 0;
+
+	for (i = 0; i < array->SensorCount; i++)
+	{
+		Slope = abs(TMP102ArrayGetSlope(array, i));
+		if (Slope > MaxSlope)
+		{
+			MaxSlope = Slope;
+		}
+	}
+
+	if (array->ReadPeriod != TMP102_ARRAY_PERIOD_FAST)
+	{
+		if (MaxSlope >= TMP102_ARRAY_SLOPE_FAST)
+		{
+			TMP102ArrayChangeRate(array, TMP102_ARRAY_PERIOD_FAST, MaxSlope);
+		}
+		return;
+	}
+
+	if (MaxSlope < TMP102_ARRAY_SLOPE_STABLE)
+	{
+		array->StableCount++;
+		if (array->StableCount >= TMP102_ARRAY_STABLE_COUNT)
+		{
+			TMP102ArrayChangeRate(array, TMP102_ARRAY_PERIOD_SLOW, MaxSlope);
+		}
+	}
+	else
+	{
+		array->StableCount = 0;
+	}
+}
+
+/*
+ * Start DMA chain from first sensor
+ *
+ * @param[*array] - sensor array structure
+ * @return - void
+ */
+static void TMP102ArrayStartChain(TMP102Array_t *array)
+{
+	array->State = TMP102_ARRAY_READING;
+	array->Current = 0;
+	array->SampleTime = HAL_GetTick();
+
+	if (TMP102ArrayReadCurrent(array) != HAL_OK)
+	{
+		array->Sensors[0].ErrorCount++;
+		array->Sensors[0].Stale = 1;
+		TMP102ArrayNext(array);
+	}
+}
+
+/*
+ * Find sensors on addresses of all drivers and initialize them.
+ * Uses result of I2C scan, so I2CScanStart has to be finished before.
+ *
+ * @param[*array] - sensor array structure
+ * @param[*initI2CHandle] - i2c handler
+ * @return - number of sensors found
+ */
+uint8_t TMP102ArrayInit(TMP102Array_t *array, I2C_HandleTypeDef *initI2CHandle)
+{
+	uint8_t Addresses[SENSOR_MAX_ACTIVE];
+	uint8_t AddressCount;
+	uint8_t i;
+	const Sensor_Driver_t *Driver;
+
+	memset(array, 0, sizeof(TMP102Array_t));
+	array->I2CHandle = initI2CHandle;
+
+	AddressCount = Sensor_GetAddresses(Addresses, SENSOR_MAX_ACTIVE);
+	for (i = 0; i < AddressCount && array->SensorCount < TMP102_ARRAY_MAX_SENSORS;
+			i++)
+	{
+		if (I2CScanIsDevicePresent(Addresses[i]))
+		{
+			Sensor_Init(&array->Sensors[array->SensorCount].Sensor,
+					Sensor_FindDriver(Addresses[i]), initI2CHandle, Addresses[i]);
+			array->SensorCount++;
+		}
+	}
+
+	// nothing found - keep default sensor, so application works as before
+	if (array->SensorCount == 0)
+	{
+		Driver = Sensor_GetDefaultDriver();
+		Sensor_Init(&array->Sensors[0].Sensor, Driver, initI2CHandle,
+				Driver->FirstAddress);
+		array->SensorCount = 1;
+	}
+
+	// one-shot round waits for the slowest sensor
+	for (i = 0; i < array->SensorCount; i++)
+	{
+		Driver = array->Sensors[i].Sensor.Driver;
+		if (Driver->ConversionTime > array->ConversionTime)
+		{
+			array->ConversionTime = Driver->ConversionTime;
+		}
+	}
+
+	return array->SensorCount;
+}
+
+/*
+ * Switch all sensors between one-shot and continuous conversion
+ *
+ * @param[*array] - sensor array structure
+ * @param[Enable] - 1 one-shot, 0 continuous
+ * @return - 1 mode changed, 0 sampler busy
+ */
+uint8_t TMP102ArraySetOneShot(TMP102Array_t *array, uint8_t Enable)
+{
+	uint8_t i;
+
+	if (array->State != TMP102_ARRAY_IDLE)
+	{
+		return 0;
+	}
+
+	for (i = 0; i < array->SensorCount; i++)
+	{
+		Sensor_t *Sensor = &array->Sensors[i].Sensor;
+		Sensor->Driver->SetPowerMode(Sensor,
+				Enable ? SENSOR_POWER_ONESHOT : SENSOR_POWER_CONTINUOUS);
+	}
+	array->OneShot = Enable;
+
+	return 1;
+}
+
+/*
+ * Start reading all sensors, results are ready when sampler is idle again
+ *
+ * @param[*array] - sensor array structure
+ * @return - 1 read started, 0 previous read not finished
+ */
+uint8_t TMP102ArrayStartRead(TMP102Array_t *array)
+{
+	uint8_t i;
+
+	if (array->State != TMP102_ARRAY_IDLE)
+	{
+		return 0;
+	}
+
+	array->LastReadTime = HAL_GetTick();
+
+	if (array->OneShot)
+	{
+		// trigger all sensors at once, they convert in parallel
+		for (i = 0; i < array->SensorCount; i++)
+		{
+			Sensor_t *Sensor = &array->Sensors[i].Sensor;
+			Sensor->Driver->StartSample(Sensor);
+		}
+		array->ConversionStart = HAL_GetTick();
+		array->State = TMP102_ARRAY_CONVERTING;
+	}
+	else
+	{
+		TMP102ArrayStartChain(array);
+	}
+
+	return 1;
+}
+
+/*
+ * Set fixed read period, adaptive sampling is turned off
+ *
+ * @param[*array] - sensor array structure
+ * @param[Period] - ms between reads, 0 - only TMP102ArrayStartRead
+ * @return - void
+ */
+void TMP102ArraySetPeriod(TMP102Array_t *array, uint32_t Period)
+{
+	array->Adaptive = 0;
+	array->ReadPeriod = Period;
+}
+
+/*
+ * Turn on adaptive sampling, it starts with slow rate
+ *
+ * @param[*array] - sensor array structure
+ * @param[Enable] - 1 adaptive, 0 sampler stopped
+ * @return - void
+ */
+void TMP102ArraySetAdaptive(TMP102Array_t *array, uint8_t Enable)
+{
+	array->Adaptive = Enable;
+	array->ReadPeriod = 0;
+
+	if (Enable)
+	{
+		TMP102ArrayChangeRate(array, TMP102_ARRAY_PERIOD_SLOW, 0);
+	}
+}
+
+/*
+ * Temperature slope of sensor from reference sample at least TMP102_ARRAY_SLOPE_WINDOW
+ * old to newest sample, 0 until sensor was read for that long
+ *
+ * @param[*array] - sensor array structure
+ * @param[Index] - sensor number
+ * @return - slope in LSB (0.0625 deg C) per minute
+ */
+int32_t TMP102ArrayGetSlope(TMP102Array_t *array, uint8_t Index)
+{
+	if (Index >= array->SensorCount)
+	{
+		return 0;
+	}
+
+	TMP102ArraySensor_t *Entry = &array->Sensors[Index];
+	TMP102Sample_t *Newest;
+	TMP102Sample_t *Base = NULL;
+	uint32_t Time = 0;
+	uint8_t i;
+
+	if (Entry->HistoryCount == 0)
+	{
+		return 0;
+	}
+
+	Newest = &Entry->History[(Entry->HistoryHead + TMP102_ARRAY_HISTORY_SIZE - 1)
+			% TMP102_ARRAY_HISTORY_SIZE];
+
+	// youngest reference sample which is old enough, from newest to oldest
+	for (i = 1; i <= Entry->SlopeCount; i++)
+	{
+		Base = &Entry->SlopeBase[(Entry->SlopeHead + TMP102_ARRAY_SLOPE_POINTS - i)
+				% TMP102_ARRAY_SLOPE_POINTS];
+		Time = Newest->Timestamp - Base->Timestamp;
+		if (Time >= TMP102_ARRAY_SLOPE_WINDOW)
+		{
+			break;
+		}
+	}
+
+	if (Time < TMP102_ARRAY_SLOPE_WINDOW)
+	{
+		return 0;
+	}
+
+	return (int32_t) (((int64_t) (Newest->Value - Base->Value) * 60000) / (int64_t) Time);
+}
+
+/*
+ * Keep sample as slope reference when last one is TMP102_ARRAY_SLOPE_STEP old
+ *
+ * @param[*Entry] - sensor in array
+ * @param[*Sample] - new sample
+ * @return - void
+ */
+static void TMP102ArraySaveSlopeBase(TMP102ArraySensor_t *Entry, TMP102Sample_t *Sample)
+{
+	TMP102Sample_t *Last = &Entry->SlopeBase[(Entry->SlopeHead + TMP102_ARRAY_SLOPE_POINTS - 1)
+			% TMP102_ARRAY_SLOPE_POINTS];
+
+	if (Entry->SlopeCount > 0 && Sample->Timestamp - Last->Timestamp < TMP102_ARRAY_SLOPE_STEP)
+	{
+		return;
+	}
+
+	Entry->SlopeBase[Entry->SlopeHead] = *Sample;
+	Entry->SlopeHead = (Entry->SlopeHead + 1) % TMP102_ARRAY_SLOPE_POINTS;
+	if (Entry->SlopeCount < TMP102_ARRAY_SLOPE_POINTS)
+	{
+		Entry->SlopeCount++;
+	}
+}
+
+/*
+ * Put in main loop, starts periodic reads, starts DMA chain when one-shot
+ * conversion is finished and adapts read period after each round
+ *
+ * @param[*array] - sensor array structure
+ * @return - void
+ */
+void TMP102ArrayProcess(TMP102Array_t *array)
+{
+	if (array->State == TMP102_ARRAY_CONVERTING)
+	{
+		if ((HAL_GetTick() - array->ConversionStart) >= array->ConversionTime)
+		{
+			TMP102ArrayStartChain(array);
+		}
+		return;
+	}
+
+	if (array->State == TMP102_ARRAY_READING)
+	{
+		// interrupt does not come when bus is stuck, peripheral is released by recovery
+		if ((HAL_GetTick() - array->SampleTime) > I2CBus_Timeout(array->I2CHandle,
+				array->SensorCount * (SENSOR_MAX_RAW_SIZE + I2CBUS_MEM_OVERHEAD))
+				+ array->SensorCount * I2CBUS_TRANSFER_MARGIN)
+		{
+			I2CBus_Recover(array->I2CHandle);
+			TMP102ArrayAbort(array);
+		}
+		return;
+	}
+
+	// bus is free, rate change can write to sensors
+	if (array->RoundDone)
+	{
+		array->RoundDone = 0;
+		if (array->Adaptive)
+		{
+			TMP102ArrayAdaptRate(array);
+		}
+	}
+
+	if (array->ReadPeriod != 0
+			&& (HAL_GetTick() - array->LastReadTime) >= array->ReadPeriod)
+	{
+		TMP102ArrayStartRead(array);
+	}
+}
+
+/*
+ * Check if sampler uses i2c bus or waits for conversion
+ *
+ * @param[*array] - sensor array structure
+ * @return - 1 busy, 0 idle
+ */
+uint8_t TMP102ArrayIsBusy(TMP102Array_t *array)
+{
+	return (array->State != TMP102_ARRAY_IDLE);
+}
+
+/*
+ * Get driver structure of sensor
+ *
+ * @param[*array] - sensor array structure
+ * @param[Index] - sensor number
+ * @return - pointer to sensor, NULL if there is no such sensor
+ */
+Sensor_t* TMP102ArrayGetSensor(TMP102Array_t *array, uint8_t Index)
+{
+	if (Index >= array->SensorCount)
+	{
+		return NULL;
+	}
+
+	return &array->Sensors[Index].Sensor;
+}
+
+/*
+ * Switch i2c bus to new speed, it is kept only if all sensors work at it
+ *
+ * @param[*array] - sensor array structure
+ * @param[Speed] - bus speed in Hz
+ * @return - result @select (i2cbus.h), speed in use is in I2CHandle->Init.ClockSpeed
+ */
+uint8_t TMP102ArraySelectSpeed(TMP102Array_t *array, uint32_t Speed)
+{
+	uint8_t Devices[TMP102_ARRAY_MAX_SENSORS];
+	uint8_t Registers[TMP102_ARRAY_MAX_SENSORS];
+	uint8_t i;
+
+	if (array->State == TMP102_ARRAY_READING)
+	{
+		return I2CBUS_SELECT_BUSY;
+	}
+
+	for (i = 0; i < array->SensorCount; i++)
+	{
+		Devices[i] = array->Sensors[i].Sensor.Address;
+		Registers[i] = array->Sensors[i].Sensor.Driver->TestRegister;
+	}
+
+	return I2CBus_SelectSpeed(array->I2CHandle, Speed, Devices, Registers,
+			array->SensorCount);
+}
+
+/*
+ * Check if last read of sensor failed
+ *
+ * @param[*array] - sensor array structure
+ * @param[Index] - sensor number
+ * @return - 1 newest sample is old or there is no such sensor, 0 sample is fresh
+ */
+uint8_t TMP102ArrayIsStale(TMP102Array_t *array, uint8_t Index)
+{
+	if (Index >= array->SensorCount)
+	{
+		return 1;
+	}
+
+	return array->Sensors[Index].Stale;
+}
+
+/*
+ * Copy history of sensor, newest sample first
+ *
+ * @param[*array] - sensor array structure
+ * @param[Index] - sensor number
+ * @param[*Buffer] - buffer for samples
+ * @param[MaxCount] - size of buffer
+ * @return - number of samples copied
+ */
+uint8_t TMP102ArrayGetHistory(TMP102Array_t *array, uint8_t Index,
+		TMP102Sample_t *Buffer, uint8_t MaxCount)
+{
+	if (Index >= array->SensorCount)
+	{
+		return 0;
+	}
+
+	TMP102ArraySensor_t *Entry = &array->Sensors[Index];
+	uint8_t Count = Entry->HistoryCount;
+	uint8_t Position = Entry->HistoryHead;
+	uint8_t i;
+
+	if (Count > MaxCount)
+	{
+		Count = MaxCount;
+	}
+
+	for (i = 0; i < Count; i++)
+	{
+		Position = (Position + TMP102_ARRAY_HISTORY_SIZE - 1)
+				% TMP102_ARRAY_HISTORY_SIZE;
+		Buffer[i] = Entry->History[Position];
+	}
+
+	return Count;
+}
+
+#if (TMP102_USE_FLOATNUMBERS == 1)
+/*
+ * Last value of sensor
+ *
+ * @param[*array] - sensor array structure
+ * @param[Index] - sensor number
+ * @return - value in units of sensor driver, 0 if there is no sample
+ */
+float TMP102ArrayGetFloat(TMP102Array_t *array, uint8_t Index)
+{
+	TMP102Sample_t Sample;
+	float Value;
+
+	if (TMP102ArrayGetHistory(array, Index, &Sample, 1) == 0
+			|| Sensor_ToFloat(&array->Sensors[Index].Sensor, Sample.Value, &Value)
+					!= SENSOR_OK)
+	{
+		return 0;
+	}
+
+	return Value;
+}
+#endif
+
+/*
+ * Configure thresholds and interrupt mode on all temperature sensors with ALERT output,
+ * thresholds are integers so it works also without TMP102_USE_FLOATNUMBERS
+ *
+ * @param[*array] - sensor array structure
+ * @param[GPIO_Pin] - EXTI pin connected to ALERT
+ * @param[LowMilli] - TLOW in thousandths of deg C
+ * @param[HighMilli] - THIGH in thousandths of deg C
+ * @return - @status of first failing sensor
+ */
+uint8_t TMP102ArrayConfigureAlert(TMP102Array_t *array, uint16_t GPIO_Pin,
+		int32_t LowMilli, int32_t HighMilli)
+{
+	TMP102ArraySensor_t *Entry;
+	uint8_t i;
+	uint8_t Status;
+
+	if (array->State != TMP102_ARRAY_IDLE)
+	{
+		return SENSOR_ERR_BUS;
+	}
+
+	for (i = 0; i < array->SensorCount; i++)
+	{
+		Entry = &array->Sensors[i];
+		Entry->AlertEnabled = 0;
+		Entry->AlertActive = 0;
+
+		if (Entry->Sensor.Driver->SetAlert == NULL
+				|| Entry->Sensor.Driver->Quantity != SENSOR_QUANTITY_TEMPERATURE)
+		{
+			continue;
+		}
+
+		Entry->AlertLow = Sensor_FromMilli(&Entry->Sensor, LowMilli);
+		Entry->AlertHigh = Sensor_FromMilli(&Entry->Sensor, HighMilli);
+		Status = Entry->Sensor.Driver->SetAlert(&Entry->Sensor, Entry->AlertLow,
+				Entry->AlertHigh);
+		if (Status != SENSOR_OK)
+		{
+			return Status;
+		}
+		Entry->AlertEnabled = 1;
+	}
+
+	array->AlertPending = 0;
+	array->AlertPin = GPIO_Pin;
+
+	return SENSOR_OK;
+}
+
+/*
+ * Put in main loop, reads sensors after ALERT edge and finds which threshold was crossed.
+ * Reading sample also clears ALERT in interrupt mode.
+ *
+ * @param[*array] - sensor array structure
+ * @param[*Events] - buffer for TMP102_ARRAY_MAX_SENSORS events
+ * @return - number of events
+ */
+uint8_t TMP102ArrayCheckAlert(TMP102Array_t *array, TMP102AlertEvent_t *Events)
+{
+	uint8_t i;
+	uint8_t Count = 0;
+	TMP102ArraySensor_t *Entry;
+	uint8_t Raw[SENSOR_MAX_RAW_SIZE];
+	int16_t Value;
+
+	// wait for DMA chain to free the bus
+	if (!array->AlertPending || array->State != TMP102_ARRAY_IDLE)
+	{
+		return 0;
+	}
+
+	array->AlertPending = 0;
+
+	for (i = 0; i < array->SensorCount; i++)
+	{
+		Entry = &array->Sensors[i];
+		if (!Entry->AlertEnabled)
+		{
+			continue;
+		}
+
+		if (Entry->Sensor.Driver->ReadRaw(&Entry->Sensor, Raw) != HAL_OK)
+		{
+			Entry->ErrorCount++;
+			Entry->Stale = 1;
+			continue;
+		}
+		Value = Entry->Sensor.Driver->Convert(&Entry->Sensor, Raw);
+
+		if (!Entry->AlertActive && Value >= Entry->AlertHigh)
+		{
+			Entry->AlertActive = 1;
+			Events[Count].Type = TMP102_ALERT_HIGH;
+		}
+		else if (Entry->AlertActive && Value < Entry->AlertLow)
+		{
+			Entry->AlertActive = 0;
+			Events[Count].Type = TMP102_ALERT_LOW;
+		}
+		else
+		{
+			// this sensor did not cause the alert
+			continue;
+		}
+
+		Events[Count].Address = Entry->Sensor.Address;
+		Events[Count].Sample.Value = Value;
+		Events[Count].Sample.Timestamp = HAL_GetTick();
+		Count++;
+	}
+
+	return Count;
+}
+
+/*
+ * Callback to put in HAL_GPIO_EXTI_Callback
+ *
+ * @param[*array] - sensor array structure
+ * @param[GPIO_Pin] - pin that caused interrupt
+ * @return - void
+ */
+void TMP102Array_EXTICallback(TMP102Array_t *array, uint16_t GPIO_Pin)
+{
+	if (array->AlertPin != 0 && array->AlertPin == GPIO_Pin)
+	{
+		array->AlertPending = 1;
+	}
+}
+
+/*
+ * Callback to put in HAL_I2C_MemRxCpltCallback
+ *
+ * @param[*array] - sensor array structure
+ * @param[*hi2c] - i2c handle
+ * @return - void
+ */
+void TMP102Array_MemRxCpltCallback(TMP102Array_t *array, I2C_HandleTypeDef *hi2c)
+{
+	if (array->State != TMP102_ARRAY_READING || hi2c != array->I2CHandle)
+	{
+		return;
+	}
+
+	TMP102ArraySensor_t *Entry = &array->Sensors[array->Current];
+
+	// save sample to history
+	Entry->History[Entry->HistoryHead].Value = Entry->Sensor.Driver->Convert(
+			&Entry->Sensor, Entry->RawBuffer);
+	Entry->History[Entry->HistoryHead].Timestamp = array->SampleTime;
+	TMP102ArraySaveSlopeBase(Entry, &Entry->History[Entry->HistoryHead]);
+	Entry->HistoryHead = (Entry->HistoryHead + 1) % TMP102_ARRAY_HISTORY_SIZE;
+	if (Entry->HistoryCount < TMP102_ARRAY_HISTORY_SIZE)
+	{
+		Entry->HistoryCount++;
+	}
+	Entry->Stale = 0;
+	TMP102ArrayNext(array);
+}
+
+/*
+ * Callback to put in HAL_I2C_ErrorCallback
+ *
+ * @param[*array] - sensor array structure
+ * @param[*hi2c] - i2c handle
+ * @return - void
+ */
+void TMP102Array_ErrorCallback(TMP102Array_t *array, I2C_HandleTypeDef *hi2c)
+{
+	if (array->State != TMP102_ARRAY_READING || hi2c != array->I2CHandle)
+	{
+		return;
+	}
+
+	array->Sensors[array->Current].ErrorCount++;
+	array->Sensors[array->Current].Stale = 1;
+	TMP102ArrayNext(array);
+}
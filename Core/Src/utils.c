@@ -1,57 +1,173 @@
-/*
- * utils.c
- *
- *  Created on: 10 May, 2023
- *      Author: Ezrah Buki
- */
-
-#include "main.h"
-#include "utils.h"
-#include "usart.h"
-#include "string.h"
-#include "stdio.h"
-
-void UartLogBT (char *Msg) {
-	HAL_UART_Transmit(&huart1, (uint8_t*)Msg, strlen(Msg), 100);
-}
-
-void UartLogPC (char *Msg) {
-	HAL_UART_Transmit(&huart2, (uint8_t*)Msg, strlen(Msg), 100);
-}
-
-void I2CScan (I2C_HandleTypeDef* i2chandle)
-{
-
- 	HAL_StatusTypeDef result;
-  	uint8_t i;
-	char Msg[64];
-	uint16_t Len;
-
-	Len = sprintf(Msg,"Scanning i2c bus...");
-	HAL_UART_Transmit(&huart2, (uint8_t*) Msg, Len, 1000);
-
-  	for (i=0; i<127; i++)
-  	{
-  	  /*
-  	   * the HAL wants a left aligned i2c address
-  	   * &hi2c1 is the handle
-  	   * (uint16_t)(i<<1) is the i2c address left aligned
-  	   * retries 2
-  	   * timeout 2
-  	   */
-
-  	  result = HAL_I2C_IsDeviceReady(i2chandle, (uint16_t)(i<<1), 2, 2);
-  	  if (result != HAL_OK) // HAL_ERROR or HAL_BUSY or HAL_TIMEOUT
-  	  {
-  		HAL_UART_Transmit(&huart2, (uint8_t*)".", 1, 1000);
-  	  }
-  	  if (result == HAL_OK)
-  	  {
-  		Len = sprintf(Msg,"\r\nDevice found! Address : 0x%X\r\n", i);
-  		HAL_UART_Transmit(&huart2, (uint8_t*) Msg, Len, 1000);
-  	  }
-  	}
-
-  	Len = sprintf(Msg,"Scan finished\r\n");
-  	HAL_UART_Transmit(&huart2, (uint8_t*) Msg, Len, 1000);
-}
+/*
+ * utils.c
+ *
+ *  Created on: 10 May, 2023
+ *      Author: Ezrah Buki
+ */
+
+#include "main.h"
+#include "utils.h"
+#include "usart.h"
+#include "string.h"
+#include "stdio.h"
+#include "log.h"
+
+// bluetooth uart is used only through transmit queue of JDY-09
+void UartLogBT (JDY09_t *jdy09, char *Msg) {
+	JDY09_SendData(jdy09, (uint8_t*)Msg);
+}
+
+void UartLogPC (char *Msg) {
+	Log_WaitIdle();
+	HAL_UART_Transmit(&huart2, (uint8_t*)Msg, strlen(Msg), 100);
+}
+
+void I2CScan (I2C_HandleTypeDef* i2chandle)
+{
+
+ 	HAL_StatusTypeDef result;
+  	uint8_t i;
+  	uint8_t found = 0;
+
+  	for (i=0; i<127; i++)
+  	{
+  	  /*
+  	   * the HAL wants a left aligned i2c address
+  	   * &hi2c1 is the handle
+  	   * (uint16_t)(i<<1) is the i2c address left aligned
+  	   * retries 2
+  	   * timeout 2
+  	   */
+
+  	  result = HAL_I2C_IsDeviceReady(i2chandle, (uint16_t)(i<<1), 2, 2);
+  	  if (result == HAL_OK)
+  	  {
+  		LOG_INFO(LOG_MSG_I2C_DEVICE_FOUND, (unsigned long) i);
+  		found++;
+  	  }
+  	}
+
+  	LOG_INFO(LOG_MSG_I2C_SCAN_DONE, (unsigned long) found);
+}
+
+// state of background scan
+static I2CScan_t Scan;
+// only address is sent, no data is transmitted
+static uint8_t ScanDummy;
+
+/*
+ * Start probe of next address, finish scan when all addresses are done
+ */
+static void I2CScanProbeNext (void)
+{
+	uint8_t Address;
+	uint8_t Count;
+
+	Count = (Scan.AddressList != NULL) ? Scan.ListLenght : I2CSCAN_LAST_ADDRESS;
+
+	while (Scan.Index < Count)
+	{
+		// full scan skips general call address 0
+		Address = (Scan.AddressList != NULL) ? Scan.AddressList[Scan.Index] : Scan.Index + 1;
+
+		// address only transfer - ACK ends in TxCplt callback, NACK in Error callback
+		if (HAL_I2C_Master_Transmit_IT(Scan.I2CHandle, (uint16_t)(Address << 1), &ScanDummy, 0) == HAL_OK)
+		{
+			return;
+		}
+
+		// bus not ready, skip address
+		Scan.Index++;
+	}
+
+	Scan.Busy = 0;
+	LOG_INFO(LOG_MSG_I2C_SCAN_DONE, (unsigned long) Scan.DevicesFound);
+}
+
+/*
+ * Start scan of i2c bus in background, result is reported in log
+ * i2c event and error interrupts have to be enabled
+ *
+ * @param[i2chandle] - i2c handle
+ * @param[AddressList] - 7 bit addresses to probe, NULL for full scan
+ * @param[ListLenght] - number of addresses in AddressList
+ * @return - void
+ */
+void I2CScanStart (I2C_HandleTypeDef* i2chandle, const uint8_t* AddressList, uint8_t ListLenght)
+{
+	// scan already running
+	if (Scan.Busy)
+	{
+		return;
+	}
+
+	memset(&Scan, 0, sizeof(Scan));
+	Scan.I2CHandle = i2chandle;
+	Scan.AddressList = AddressList;
+	Scan.ListLenght = ListLenght;
+	Scan.Busy = 1;
+
+	I2CScanProbeNext();
+}
+
+/*
+ * Check if background scan is still running
+ *
+ * @return - 1 scan in progress, 0 done
+ */
+uint8_t I2CScanIsBusy (void)
+{
+	return Scan.Busy;
+}
+
+/*
+ * Check result of last scan
+ *
+ * @param[Address] - 7 bit address
+ * @return - 1 device answered, 0 no device
+ */
+uint8_t I2CScanIsDevicePresent (uint8_t Address)
+{
+	Address &= 0x7F;
+	return (Scan.DeviceMap[Address >> 3] >> (Address & 7)) & 1;
+}
+
+/*
+ * Callback to put in HAL_I2C_MasterTxCpltCallback, device acknowledged address
+ *
+ * @param[i2chandle] - i2c handle
+ * @return - void
+ */
+void I2CScan_TxCpltCallback (I2C_HandleTypeDef* i2chandle)
+{
+	if (!Scan.Busy || i2chandle != Scan.I2CHandle)
+	{
+		return;
+	}
+
+	uint8_t Address = (Scan.AddressList != NULL) ? Scan.AddressList[Scan.Index] : Scan.Index + 1;
+
+	Scan.DeviceMap[Address >> 3] |= 1 << (Address & 7);
+	Scan.DevicesFound++;
+	LOG_INFO(LOG_MSG_I2C_DEVICE_FOUND, (unsigned long) Address);
+
+	Scan.Index++;
+	I2CScanProbeNext();
+}
+
+/*
+ * Callback to put in HAL_I2C_ErrorCallback, no device on address
+ *
+ * @param[i2chandle] - i2c handle
+ * @return - void
+ */
+void I2CScan_ErrorCallback (I2C_HandleTypeDef* i2chandle)
+{
+	if (!Scan.Busy || i2chandle != Scan.I2CHandle)
+	{
+		return;
+	}
+
+	Scan.Index++;
+	I2CScanProbeNext();
+}
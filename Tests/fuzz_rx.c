@@ -0,0 +1,411 @@
+/*
+ * fuzz_rx.c
+ *
+ *  Created on: 19 October 2026
+ */
+
+/* Fuzz of receive path and command parser on host.
+ *
+ * Bytes go to JDY09_RxCpltCallbackDMA in chunks of DMA buffer size, lines are taken
+ * and parsed like in main loop and all queued commands are executed.
+ * Files in arguments are replayed first (regress/rx), then random input is made
+ * from command words and random bytes.
+ *
+ * Checked after every chunk:
+ *  - LinesRecieved is the number of line ends in ring buffer before current line
+ *  - line given to parser is at most JDY09_MAX_LINE_LENGHT + end of line
+ * Uart refuses some transmissions (HAL_BUSY), at the end all pool blocks have to be free,
+ * frame refused too many times is dropped.
+ * Memory errors are found by -fsanitize=address,undefined (Makefile).
+ *
+ * usage: fuzz_rx [-s seed] [-n chunks] [input files]
+ */
+
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+#include "main.h"
+#include "usart.h"
+#include "i2c.h"
+#include "JDY-09.h"
+#include "parse.h"
+#include "pool.h"
+#include "pages.h"
+#include "report.h"
+#include "log.h"
+#include "host_hal.h"
+#include "parse_stubs.h"
+
+#define FUZZ_DEFAULT_SEED				1
+#define FUZZ_DEFAULT_CHUNKS				200000
+#define FUZZ_MAX_FILE					4096
+#define FUZZ_REPLAY_DRAIN				3		// chunks between drains, 3 chunks overflow ring buffer
+
+static JDY09_t Fuzz_JDY09;
+static TMP102Array_t Fuzz_Array;
+static uint32_t Fuzz_Lines;
+static uint32_t Fuzz_State;
+
+// pieces of valid and nearly valid commands
+static const char *const Fuzz_Words[] = {
+	"WAKEUP;", "MEASURE;", "DISPLAY;", "HELP;", "SLEEP;", "HISTORY;", "CLOCK;", "MEM;",
+	"CRASH;", "I2C;", "I2C=400;", "I2C=", "PAGES;", "PAGES=T,MIN:8,MAX;", "PAGES=",
+	"DUMP;", "DUMP=0,4;", "DUMP=", "REPORT=0.25,60;", "REPORT=0.5,10,50;", "REPORT=",
+	":", ",", ";", ";;", "=", "\n", "\r\n", "-", "0", "99999999999", "0.", ".5"
+};
+
+/*
+ * xorshift32, the same seed gives the same input on every host
+ */
+static uint32_t Fuzz_Random(void)
+{
+	Fuzz_State ^= Fuzz_State << 13;
+	Fuzz_State ^= Fuzz_State >> 17;
+	Fuzz_State ^= Fuzz_State << 5;
+
+	return Fuzz_State;
+}
+
+/*
+ * Check line counter against content of ring buffer
+ */
+static void Fuzz_CheckLines(void)
+{
+	uint32_t Count = 0;
+	uint16_t i;
+
+	for (i = Fuzz_JDY09.RingBuffer.Tail; i != Fuzz_JDY09.LineStart; i = (i + 1) % RING_BUFFER_SIZE)
+	{
+		if (Fuzz_JDY09.RingBuffer.buffer[i] == ENDLINE)
+		{
+			Count++;
+		}
+	}
+
+	if (Count != Fuzz_JDY09.LinesRecieved)
+	{
+		printf("FAIL: %lu line ends in ring buffer, LinesRecieved %u\n",
+				(unsigned long) Count, Fuzz_JDY09.LinesRecieved);
+		exit(1);
+	}
+}
+
+/*
+ * Take all received lines and run them like main loop
+ */
+static void Fuzz_Drain(void)
+{
+	uint8_t Line[JDY09_MAX_LINE_LENGHT + 2];
+	uint8_t i;
+
+	while (JDY09_CheckPendingMessages(&Fuzz_JDY09, Line) == JDY09_MESSAGEPENDING)
+	{
+		JDY09_ClearMsgPendingFlag(&Fuzz_JDY09);
+
+		if (strlen((char*) Line) > JDY09_MAX_LINE_LENGHT + 1)
+		{
+			printf("FAIL: line of %lu bytes\n", (unsigned long) strlen((char*) Line));
+			exit(1);
+		}
+		Fuzz_Lines++;
+
+		Parser_Parse(Line);
+		for (i = 0; i <= PARSE_CMD_QUEUE_SIZE && Parser_IsBusy(); i++)
+		{
+			Parser_Execute(&Fuzz_Array);
+		}
+		Fuzz_CheckLines();
+	}
+
+	// main loop sends error of unfinished line and terminal text queued in log
+	JDY09_TxProcess(&Fuzz_JDY09);
+	Log_Process();
+	Log_TxCpltCallback(&huart2);
+}
+
+/*
+ * Send everything queued, no pool block may stay taken
+ */
+static void Fuzz_CheckPool(void)
+{
+	uint8_t i;
+
+	if (JDY09_WaitTxIdle(&Fuzz_JDY09, JDY09_UART_TIMEOUET) != JDY09_OK)
+	{
+		printf("FAIL: transmit queue not empty\n");
+		exit(1);
+	}
+
+	for (i = 0; i < POOL_CLASSES; i++)
+	{
+		if (Pool_GetClass(i)->Used != 0)
+		{
+			printf("FAIL: %u blocks of %u B not given back\n", Pool_GetClass(i)->Used,
+					Pool_GetClass(i)->BlockSize);
+			exit(1);
+		}
+	}
+}
+
+/*
+ * Feed bytes in DMA sized chunks
+ */
+static void Fuzz_Feed(const uint8_t *Data, uint32_t Size, uint32_t DrainEvery)
+{
+	uint32_t Chunks = 0;
+	uint16_t Chunk;
+
+	while (Size > 0)
+	{
+		Chunk = (Size > JDY09_RECIEVEBUFFERSIZE) ? JDY09_RECIEVEBUFFERSIZE : Size;
+		memcpy(Fuzz_JDY09.RecieveBufferDMA, Data, Chunk);
+		JDY09_RxCpltCallbackDMA(&Fuzz_JDY09, &huart1, Chunk);
+		Fuzz_CheckLines();
+
+		Data += Chunk;
+		Size -= Chunk;
+		if (++Chunks % DrainEvery == 0)
+		{
+			Fuzz_Drain();
+		}
+	}
+}
+
+/*
+ * Line longer than parse buffer is cut and its rest is removed from ring buffer
+ */
+static void Fuzz_WriteDataToBuffer(void)
+{
+	Ringbuffer_t Ring;
+	uint8_t Buffer[8];
+	const char *Input = "0123456789\nAB\n";
+	uint8_t Byte;
+
+	RB_Flush(&Ring);
+	for (; *Input != 0; Input++)
+	{
+		RB_Write(&Ring, *Input);
+	}
+
+	Parse_WriteDataToBuffer(&Ring, Buffer, sizeof(Buffer));
+	if (strcmp((char*) Buffer, "012345\n") != 0)
+	{
+		printf("FAIL: cut line \"%s\"\n", Buffer);
+		exit(1);
+	}
+	Parse_WriteDataToBuffer(&Ring, Buffer, sizeof(Buffer));
+	if (strcmp((char*) Buffer, "AB\n") != 0 || RB_Read(&Ring, &Byte) == RB_OK)
+	{
+		printf("FAIL: next line \"%s\"\n", Buffer);
+		exit(1);
+	}
+}
+
+/*
+ * Line with more commands than queue can take is refused as too long, not BUSY,
+ * line which fits only in empty queue is BUSY and not queued at all
+ */
+static void Fuzz_QueueFull(void)
+{
+	uint8_t Line[] = "MEM;CLOCK;MEM;CLOCK;MEM;CLOCK;MEM;CLOCK;MEM;\n";
+	uint8_t Full[] = "MEM;CLOCK;MEM;CLOCK;MEM;CLOCK;MEM;CLOCK;\n";
+	uint8_t Two[] = "MEM;;CLOCK;\n";
+	uint8_t i;
+
+	if (Parser_Parse(Line) != PARSE_ERROR_TOO_MANY || Parser_IsBusy())
+	{
+		printf("FAIL: line longer than queue not refused\n");
+		exit(1);
+	}
+
+	if (Parser_Parse(Full) != PARSE_OK || Parser_Parse(Two) != PARSE_BUSY)
+	{
+		printf("FAIL: full queue not BUSY\n");
+		exit(1);
+	}
+	for (i = 0; i < PARSE_CMD_QUEUE_SIZE; i++)
+	{
+		Parser_Execute(&Fuzz_Array);
+	}
+	if (Parser_IsBusy())
+	{
+		printf("FAIL: part of line queued on BUSY\n");
+		exit(1);
+	}
+	Fuzz_CheckPool();
+}
+
+/*
+ * Frame refused by uart every time is dropped after JDY09_TX_MAX_RETRIES, queue goes on
+ */
+static void Fuzz_TxRefused(void)
+{
+	uint8_t *Frame = Pool_Alloc(8);
+	uint32_t Dropped = Fuzz_JDY09.TxStats.RetryDrops;
+	uint8_t i;
+
+	JDY09_Transmit(&Fuzz_JDY09, Frame, 8, 0);
+	Host_UartBusy = 1;
+	for (i = 0; i < JDY09_TX_MAX_RETRIES; i++)
+	{
+		JDY09_TxProcess(&Fuzz_JDY09);
+	}
+	Host_UartBusy = 0;
+
+	if (Fuzz_JDY09.TxCount != 0 || Fuzz_JDY09.TxStats.RetryDrops != Dropped + 1)
+	{
+		printf("FAIL: refused frame not dropped\n");
+		exit(1);
+	}
+	Fuzz_CheckPool();
+}
+
+/*
+ * Alert during a line is sent in its own frame, not inside command responses
+ */
+static void Fuzz_AlertMidBatch(void)
+{
+	uint8_t Line[] = "CLOCK;MEM;\n";
+	uint8_t Capture[1024];
+	TMP102Sample_t Sample = { 0 };
+
+	Host_UartCapture = Capture;
+	Host_UartCaptureSize = sizeof(Capture) - 1;
+	Host_UartCaptured = 0;
+
+	Parser_Parse(Line);
+	Parser_Execute(&Fuzz_Array);
+	Report_Queue(TMP102_ALERT_HIGH, 0x48, &Sample);
+	Parser_SendReports();
+	Parser_Execute(&Fuzz_Array);
+	JDY09_WaitTxIdle(&Fuzz_JDY09, JDY09_UART_TIMEOUET);
+
+	Host_UartCapture = NULL;
+	Capture[Host_UartCaptured] = 0;
+
+	if (strncmp((char*) Capture, "A HIGH", 6) != 0 || strstr((char*) Capture, "Clock") == NULL
+			|| Report_PeekAlert(0, &(Report_Entry_t) { 0 }))
+	{
+		printf("FAIL: alert not in own frame \"%.40s\"\n", Capture);
+		exit(1);
+	}
+	Fuzz_CheckPool();
+}
+
+/*
+ * Replay one regression input
+ */
+static void Fuzz_Replay(const char *Path)
+{
+	static uint8_t Data[FUZZ_MAX_FILE];
+	FILE *File = fopen(Path, "rb");
+	size_t Size;
+
+	if (File == NULL)
+	{
+		printf("FAIL: can not open %s\n", Path);
+		exit(1);
+	}
+	Size = fread(Data, 1, sizeof(Data), File);
+	fclose(File);
+
+	Fuzz_Feed(Data, Size, FUZZ_REPLAY_DRAIN);
+	Fuzz_Drain();
+	Fuzz_CheckPool();
+	printf("replay %s: %lu bytes\n", Path, (unsigned long) Size);
+}
+
+int main(int argc, char **argv)
+{
+	uint32_t Seed = FUZZ_DEFAULT_SEED;
+	uint32_t Chunks = FUZZ_DEFAULT_CHUNKS;
+	uint8_t Data[JDY09_RECIEVEBUFFERSIZE];
+	uint32_t i, n;
+	int Arg;
+
+	for (Arg = 1; Arg + 1 < argc && argv[Arg][0] == '-'; Arg += 2)
+	{
+		if (strcmp(argv[Arg], "-s") == 0)
+		{
+			Seed = strtoul(argv[Arg + 1], NULL, 0);
+		}
+		else if (strcmp(argv[Arg], "-n") == 0)
+		{
+			Chunks = strtoul(argv[Arg + 1], NULL, 0);
+		}
+	}
+
+	Pool_Init();
+	Pages_Init();
+	Report_Reset();
+	JDY09_Init(&Fuzz_JDY09, &huart1, BT_STATE_GPIO_Port, BT_STATE_Pin);
+	Parser_Init(&Fuzz_JDY09);
+	Fuzz_Array.I2CHandle = &hi2c1;
+	Stub_AddSensor(&Fuzz_Array, 0x48, 400);
+
+	Fuzz_WriteDataToBuffer();
+	Fuzz_QueueFull();
+	Fuzz_TxRefused();
+	Fuzz_AlertMidBatch();
+
+	for (; Arg < argc; Arg++)
+	{
+		Fuzz_Replay(argv[Arg]);
+	}
+
+	Fuzz_State = Seed ? Seed : FUZZ_DEFAULT_SEED;
+	for (i = 0; i < Chunks; i++)
+	{
+		uint16_t Size = Fuzz_Random() % JDY09_RECIEVEBUFFERSIZE + 1;
+
+		for (n = 0; n < Size; )
+		{
+			uint32_t Pick = Fuzz_Random() % 100;
+
+			if (Pick < 30)
+			{
+				const char *Word = Fuzz_Words[Fuzz_Random() % (sizeof(Fuzz_Words) / sizeof(Fuzz_Words[0]))];
+
+				for (; *Word != 0 && n < Size; Word++)
+				{
+					Data[n++] = *Word;
+				}
+			}
+			else if (Pick < 35)
+			{
+				Data[n++] = ENDLINE;
+			}
+			else if (Pick < 37)
+			{
+				Data[n++] = 0;
+			}
+			else
+			{
+				Data[n++] = Fuzz_Random();
+			}
+		}
+
+		Fuzz_Feed(Data, Size, UINT32_MAX);
+		if (Fuzz_Random() % 3 == 0)
+		{
+			Host_UartBusy = (Fuzz_Random() % 8 == 0);
+			Fuzz_Drain();
+		}
+	}
+	Host_UartBusy = 0;
+	Fuzz_Drain();
+	Fuzz_CheckPool();
+
+	printf("ok seed %lu: %lu lines, overflow %lu, dropped %lu, truncated %lu\n",
+			(unsigned long) Seed, (unsigned long) Fuzz_Lines,
+			(unsigned long) Fuzz_JDY09.RxStats.OverflowBytes,
+			(unsigned long) Fuzz_JDY09.RxStats.DroppedLines,
+			(unsigned long) Fuzz_JDY09.RxStats.TruncatedLines);
+	printf("tx %lu frames, %lu bytes, retries %lu, dropped %lu (%lu refused)\n",
+			(unsigned long) Fuzz_JDY09.TxStats.Frames, (unsigned long) Host_UartBytes,
+			(unsigned long) Fuzz_JDY09.TxStats.Retries,
+			(unsigned long) Fuzz_JDY09.TxStats.Dropped,
+			(unsigned long) Fuzz_JDY09.TxStats.RetryDrops);
+
+	return 0;
+}
@@ -0,0 +1,96 @@
+/*
+ * history_decode.c
+ *
+ *  Created on: 19 October 2026
+ */
+
+/* Receiving side of HISTORY command, decodes lines
+ *   H 0x<address> <base64 of batch>
+ * to samples with Decode_Base64 and Decode_DeltaBatch of encode.c.
+ *
+ * Built with HISTORY_DECODE_MAIN it is a tool which reads terminal output from stdin
+ * and prints one sample per line: address, tick in ms, value in LSB.
+ */
+
+#include "stdio.h"
+#include "string.h"
+#include "encode.h"
+#include "history_decode.h"
+
+/*
+ * Decode one line of HISTORY response
+ *
+ * @param[*Line] - line, end of line characters are ignored
+ * @param[*Address] - sensor address
+ * @param[*Values] - samples in LSB, oldest first
+ * @param[*Timestamps] - ticks of samples in ms, oldest first
+ * @param[MaxCount] - size of Values and Timestamps
+ * @param[*Count] - number of samples decoded
+ * @param[*BatchSize] - size of binary batch carried by the line
+ * @return - @status
+ */
+uint8_t HistoryDecode_Line(const char *Line, uint8_t *Address, int16_t *Values,
+		uint32_t *Timestamps, uint8_t MaxCount, uint8_t *Count, uint16_t *BatchSize)
+{
+	uint8_t Batch[HISTORY_DECODE_MAX_BATCH];
+	unsigned int Addr;
+	int Used = 0;
+	uint16_t Lenght;
+
+	if (sscanf(Line, "H 0x%2X %n", &Addr, &Used) != 1 || Used == 0)
+	{
+		return HISTORY_DECODE_NOT_HISTORY;
+	}
+	Line += Used;
+
+	Lenght = Decode_Base64(Line, strcspn(Line, "\r\n"), Batch, sizeof(Batch));
+	if (Lenght == 0)
+	{
+		return HISTORY_DECODE_ERR_TEXT;
+	}
+
+	*Address = (uint8_t) Addr;
+	*BatchSize = Lenght;
+	*Count = Decode_DeltaBatch(Batch, Lenght, Values, Timestamps, MaxCount);
+
+	// only empty history may give 0 samples
+	if (*Count == 0 && !(Lenght == 1 && Batch[0] == 0))
+	{
+		return HISTORY_DECODE_ERR_BATCH;
+	}
+
+	return HISTORY_DECODE_OK;
+}
+
+#ifdef HISTORY_DECODE_MAIN
+int main(void)
+{
+	char Line[ENCODE_BASE64_SIZE(HISTORY_DECODE_MAX_BATCH) + 16];
+	int16_t Values[255];
+	uint32_t Timestamps[255];
+	uint8_t Address, Count, i;
+	uint16_t BatchSize;
+
+	while (fgets(Line, sizeof(Line), stdin) != NULL)
+	{
+		switch (HistoryDecode_Line(Line, &Address, Values, Timestamps, 255, &Count, &BatchSize))
+		{
+		case HISTORY_DECODE_OK:
+			for (i = 0; i < Count; i++)
+			{
+				printf("0x%02X %lu %d\n", Address, (unsigned long) Timestamps[i], Values[i]);
+			}
+			break;
+
+		case HISTORY_DECODE_NOT_HISTORY:
+			break;
+
+		default:
+			fprintf(stderr, "broken line: %s", Line);
+			break;
+		}
+	}
+
+	return 0;
+}
+#endif
@@ -0,0 +1,26 @@
+/*
+ * history_decode.h
+ *
+ *  Created on: 19 October 2026
+ */
+
+#ifndef TESTS_HISTORY_DECODE_H_
+#define TESTS_HISTORY_DECODE_H_
+
+#include "stdint.h"
+
+/*
+ * Status @status
+ */
+#define HISTORY_DECODE_OK				0
+#define HISTORY_DECODE_NOT_HISTORY		1	// line is not H frame
+#define HISTORY_DECODE_ERR_TEXT			2	// broken base64 text or batch too long
+#define HISTORY_DECODE_ERR_BATCH		3	// batch is broken or has too many samples
+
+// Longest batch in one line, bytes
+#define HISTORY_DECODE_MAX_BATCH		256
+
+uint8_t HistoryDecode_Line(const char *Line, uint8_t *Address, int16_t *Values,
+		uint32_t *Timestamps, uint8_t MaxCount, uint8_t *Count, uint16_t *BatchSize);
+
+#endif /* TESTS_HISTORY_DECODE_H_ */
@@ -0,0 +1,167 @@
+/*
+ * host_hal.c
+ *
+ *  Created on: 19 October 2026
+ */
+
+/* Fakes of HAL functions and peripherals for host tests.
+ *
+ * Tick advances on every HAL_GetTick call, so timeouts of blocking code end quickly.
+ * UART transfers finish at once, Host_UartBusy makes DMA start fail as on a busy UART.
+ */
+
+#include "main.h"
+#include "usart.h"
+#include "tim.h"
+#include "i2c.h"
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+#include "host_hal.h"
+
+static GPIO_TypeDef Host_GPIOA, Host_GPIOB, Host_GPIOC;
+static USART_TypeDef Host_USART1, Host_USART2, Host_USART6;
+static TIM_TypeDef Host_TIM1;
+static I2C_TypeDef Host_I2C1;
+static DMA_Stream_TypeDef Host_DMA2_Stream2, Host_DMA2_Stream7;
+static DMA_HandleTypeDef Host_DmaRx1 = { .Instance = &Host_DMA2_Stream2 };
+static DMA_HandleTypeDef Host_DmaTx1 = { .Instance = &Host_DMA2_Stream7 };
+
+GPIO_TypeDef *GPIOA = &Host_GPIOA;
+GPIO_TypeDef *GPIOB = &Host_GPIOB;
+GPIO_TypeDef *GPIOC = &Host_GPIOC;
+USART_TypeDef *USART1 = &Host_USART1;
+USART_TypeDef *USART2 = &Host_USART2;
+USART_TypeDef *USART6 = &Host_USART6;
+TIM_TypeDef *TIM1 = &Host_TIM1;
+
+// peripherals are ready, as after MX_..._Init
+UART_HandleTypeDef huart1 = { .Instance = &Host_USART1, .hdmarx = &Host_DmaRx1,
+		.hdmatx = &Host_DmaTx1, .gState = HAL_UART_STATE_READY };
+UART_HandleTypeDef huart2 = { .Instance = &Host_USART2, .gState = HAL_UART_STATE_READY };
+TIM_HandleTypeDef htim1;
+I2C_HandleTypeDef hi2c1 = { .Instance = &Host_I2C1, .Init.ClockSpeed = 100000 };
+uint32_t SystemCoreClock = 84000000;
+
+uint32_t Host_Tick;
+uint8_t Host_UartBusy;
+uint32_t Host_UartBytes;
+uint8_t *Host_UartCapture;
+uint32_t Host_UartCaptureSize;
+uint32_t Host_UartCaptured;
+
+uint32_t HAL_GetTick(void)
+{
+	return Host_Tick++;
+}
+
+void HAL_Delay(uint32_t Delay)
+{
+	Host_Tick += Delay;
+}
+
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin)
+{
+	(void) GPIOx;
+	(void) GPIO_Pin;
+
+	return GPIO_PIN_SET;
+}
+
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState)
+{
+	(void) GPIOx;
+	(void) GPIO_Pin;
+	(void) PinState;
+}
+
+HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef *huart, uint8_t *pData,
+		uint16_t Size, uint32_t Timeout)
+{
+	(void) huart;
+	(void) pData;
+	(void) Timeout;
+
+	Host_UartBytes += Size;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UART_Transmit_DMA(UART_HandleTypeDef *huart, uint8_t *pData,
+		uint16_t Size)
+{
+	if (Host_UartBusy)
+	{
+		return HAL_BUSY;
+	}
+
+	if (huart == &huart1 && Host_UartCapture != NULL
+			&& Host_UartCaptured + Size <= Host_UartCaptureSize)
+	{
+		memcpy(&Host_UartCapture[Host_UartCaptured], pData, Size);
+		Host_UartCaptured += Size;
+	}
+
+	Host_UartBytes += Size;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UART_Transmit_IT(UART_HandleTypeDef *huart, uint8_t *pData,
+		uint16_t Size)
+{
+	return HAL_UART_Transmit_DMA(huart, pData, Size);
+}
+
+HAL_StatusTypeDef HAL_UARTEx_ReceiveToIdle_DMA(UART_HandleTypeDef *huart,
+		uint8_t *pData, uint16_t Size)
+{
+	(void) huart;
+	(void) pData;
+	(void) Size;
+
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UART_AbortReceive(UART_HandleTypeDef *huart)
+{
+	(void) huart;
+
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UART_Init(UART_HandleTypeDef *huart)
+{
+	(void) huart;
+
+	return HAL_OK;
+}
+
+uint32_t HAL_RCC_GetPCLK1Freq(void)
+{
+	return 42000000;
+}
+
+uint32_t HAL_RCC_GetPCLK2Freq(void)
+{
+	return 84000000;
+}
+
+HAL_StatusTypeDef HAL_TIM_Base_Start_IT(TIM_HandleTypeDef *htim)
+{
+	(void) htim;
+
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_Base_Stop_IT(TIM_HandleTypeDef *htim)
+{
+	(void) htim;
+
+	return HAL_OK;
+}
+
+// target resets here, in tests it is always a failure (e.g. double free of pool block)
+void Error_Handler(void)
+{
+	printf("FAIL: Error_Handler called from %p\n", __builtin_return_address(0));
+	abort();
+}
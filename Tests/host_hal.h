@@ -0,0 +1,19 @@
+/*
+ * host_hal.h
+ *
+ *  Created on: 19 October 2026
+ */
+
+#ifndef TESTS_HOST_HAL_H_
+#define TESTS_HOST_HAL_H_
+
+#include "stdint.h"
+
+extern uint32_t Host_Tick;			// advances on every HAL_GetTick
+extern uint8_t Host_UartBusy;		// 1 - UART DMA/IT transmit returns HAL_BUSY
+extern uint32_t Host_UartBytes;		// bytes sent on all UARTs
+extern uint8_t *Host_UartCapture;	// bytes sent on USART1 are copied here when not NULL
+extern uint32_t Host_UartCaptureSize;	// size of capture buffer
+extern uint32_t Host_UartCaptured;	// bytes in capture buffer
+
+#endif /* TESTS_HOST_HAL_H_ */
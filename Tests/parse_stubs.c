@@ -0,0 +1,200 @@
+/*
+ * parse_stubs.c
+ *
+ *  Created on: 19 October 2026
+ */
+
+/* Stand-ins of modules which talk to hardware, used by parser in host tests.
+ *
+ * Sensor array keeps only what TMP102Array_t holds, sensors are made by Stub_AddSensor
+ * with driver without hardware. Other modules report nothing happened.
+ */
+
+#include "string.h"
+#include "clockgov.h"
+#include "crash.h"
+#include "flashlog.h"
+#include "i2cbus.h"
+#include "memstat.h"
+#include "supervisor.h"
+#include "parse_stubs.h"
+
+static I2CBus_t Stub_I2CBus;
+
+static uint8_t Stub_SensorInit(Sensor_t *Sensor)
+{
+	(void) Sensor;
+
+	return SENSOR_OK;
+}
+
+// takes place of TMP102 driver, sensor.c finds it by address
+const Sensor_Driver_t TMP102_Driver = {
+	.Name = "TMP102",
+	.Unit = "C",
+	.Quantity = SENSOR_QUANTITY_TEMPERATURE,
+	.Resolution = 62500,
+	.FirstAddress = 0x48,
+	.AddressCount = 4,
+	.RawSize = 2,
+	.TestRegister = 0x02,
+	.ConversionTime = 26,
+	.Init = Stub_SensorInit,
+};
+
+/*
+ * Add sensor with one sample to array
+ *
+ * @param[*Array] - sensor array
+ * @param[Address] - 7 bit address
+ * @param[Value] - sample in counts
+ * @return - void
+ */
+void Stub_AddSensor(TMP102Array_t *Array, uint8_t Address, int16_t Value)
+{
+	TMP102ArraySensor_t *Entry = &Array->Sensors[Array->SensorCount++];
+
+	Sensor_Init(&Entry->Sensor, &TMP102_Driver, Array->I2CHandle, Address);
+	Entry->History[0].Value = Value;
+	Entry->History[0].Timestamp = 1000;
+	Entry->HistoryHead = 1;
+	Entry->HistoryCount = 1;
+}
+
+Sensor_t* TMP102ArrayGetSensor(TMP102Array_t *array, uint8_t Index)
+{
+	if (Index >= array->SensorCount)
+	{
+		return NULL;
+	}
+
+	return &array->Sensors[Index].Sensor;
+}
+
+uint8_t TMP102ArrayIsStale(TMP102Array_t *array, uint8_t Index)
+{
+	return (Index >= array->SensorCount) || array->Sensors[Index].Stale;
+}
+
+uint8_t TMP102ArrayGetHistory(TMP102Array_t *array, uint8_t Index, TMP102Sample_t *Buffer, uint8_t MaxCount)
+{
+	TMP102ArraySensor_t *Entry;
+	uint8_t i;
+
+	if (Index >= array->SensorCount)
+	{
+		return 0;
+	}
+	Entry = &array->Sensors[Index];
+
+	for (i = 0; i < Entry->HistoryCount && i < MaxCount; i++)
+	{
+		Buffer[i] = Entry->History[(Entry->HistoryHead + TMP102_ARRAY_HISTORY_SIZE - 1 - i)
+				% TMP102_ARRAY_HISTORY_SIZE];
+	}
+
+	return i;
+}
+
+uint8_t TMP102ArraySelectSpeed(TMP102Array_t *array, uint32_t Speed)
+{
+	if (array->SensorCount == 0)
+	{
+		array->I2CHandle->Init.ClockSpeed = I2CBUS_SPEED_STANDARD;
+		return I2CBUS_SELECT_NOT_VERIFIED;
+	}
+	array->I2CHandle->Init.ClockSpeed = Speed;
+
+	return I2CBUS_SELECT_OK;
+}
+
+uint8_t ClockGov_GetLevel(void)
+{
+	return CLOCKGOV_LEVEL_RUN;
+}
+
+uint32_t ClockGov_GetResidency(uint8_t Level)
+{
+	(void) Level;
+
+	return 0;
+}
+
+uint32_t ClockGov_GetSwitches(void)
+{
+	return 0;
+}
+
+void Crash_ClearReportPending(void)
+{
+}
+
+uint32_t Crash_GetCount(void)
+{
+	return 0;
+}
+
+uint8_t Crash_GetLast(Crash_Record_t *Record)
+{
+	memset(Record, 0, sizeof(Crash_Record_t));
+
+	return 0;
+}
+
+const char *Crash_TypeName(uint32_t Type)
+{
+	(void) Type;
+
+	return "NONE";
+}
+
+uint32_t FlashLog_GetCount(void)
+{
+	return 0;
+}
+
+uint8_t FlashLog_Read(uint32_t Index, FlashLog_Record_t *Record)
+{
+	(void) Index;
+	(void) Record;
+
+	return FLASHLOG_ERR_RANGE;
+}
+
+uint8_t I2CBus_Benchmark(I2C_HandleTypeDef *hi2c, uint8_t Device, uint8_t Reg,
+		uint32_t *ReadTime)
+{
+	(void) hi2c;
+	(void) Device;
+	(void) Reg;
+	(void) ReadTime;
+
+	return I2CBUS_BENCHMARK_BUSY;
+}
+
+const I2CBus_t *I2CBus_GetStats(void)
+{
+	return &Stub_I2CBus;
+}
+
+void MemStat_GetUsage(MemStat_Usage_t *Usage)
+{
+	memset(Usage, 0, sizeof(MemStat_Usage_t));
+}
+
+void Supervisor_Sleep(void)
+{
+}
+
+void Supervisor_GetBootTime(uint32_t *BootTime, uint32_t *FirstSampleTime)
+{
+	*BootTime = 0;
+	*FirstSampleTime = 0;
+}
+
+const char *Supervisor_TaskName(uint8_t Task)
+{
+	(void) Task;
+
+	return "TASK";
+}
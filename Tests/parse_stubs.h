@@ -0,0 +1,14 @@
+/*
+ * parse_stubs.h
+ *
+ *  Created on: 19 October 2026
+ */
+
+#ifndef TESTS_PARSE_STUBS_H_
+#define TESTS_PARSE_STUBS_H_
+
+#include "tmp102_array.h"
+
+void Stub_AddSensor(TMP102Array_t *Array, uint8_t Address, int16_t Value);
+
+#endif /* TESTS_PARSE_STUBS_H_ */
@@ -0,0 +1,274 @@
+/*
+ * stm32f4xx_hal.h
+ *
+ * Host stand-in for the HAL, only types, constants and prototypes used by
+ * the modules built for host tests. Fakes of the functions are in host_hal.c.
+ */
+#ifndef STUB_HAL_H
+#define STUB_HAL_H
+#include <stdint.h>
+#include <stddef.h>
+#define __IO volatile
+typedef enum {HAL_OK=0,HAL_ERROR,HAL_BUSY,HAL_TIMEOUT} HAL_StatusTypeDef;
+typedef enum {GPIO_PIN_RESET=0,GPIO_PIN_SET} GPIO_PinState;
+typedef enum {RESET=0,SET=!RESET} FlagStatus;
+typedef enum {DISABLE=0,ENABLE} FunctionalState;
+typedef struct {volatile uint32_t MODER,OTYPER,OSPEEDR,PUPDR,IDR,ODR,BSRR,LCKR,AFR[2];} GPIO_TypeDef;
+typedef struct {uint32_t Pin,Mode,Pull,Speed,Alternate;} GPIO_InitTypeDef;
+typedef struct {volatile uint32_t SR,DR,BRR,CR1,CR2,CR3,GTPR;} USART_TypeDef;
+typedef struct {volatile uint32_t CR1,CR2,OAR1,OAR2,DR,SR1,SR2,CCR,TRISE,FLTR;} I2C_TypeDef;
+typedef struct {volatile uint32_t CR1,CR2,SMCR,DIER,SR,EGR,CCMR1,CCMR2,CCER,CNT,PSC,ARR;} TIM_TypeDef;
+typedef struct {volatile uint32_t CR,NDTR,PAR,M0AR,M1AR,FCR;} DMA_Stream_TypeDef;
+typedef struct {volatile uint32_t KR,PR,RLR,SR;} IWDG_TypeDef;
+typedef struct {volatile uint32_t CR,CSR;} PWR_TypeDef;
+typedef struct {volatile uint32_t CR,PLLCFGR,CFGR,CIR,AHB1RSTR,AHB2RSTR,r1,r2,APB1RSTR,APB2RSTR,r3,r4,AHB1ENR,AHB2ENR,r5,r6,APB1ENR,APB2ENR,r7,r8,AHB1LPENR,AHB2LPENR,r9,r10,APB1LPENR,APB2LPENR,r11,r12,BDCR,CSR;} RCC_TypeDef;
+typedef struct {volatile uint32_t CPUID,ICSR,VTOR,AIRCR,SCR,CCR; volatile uint8_t SHP[12]; volatile uint32_t SHCSR,CFSR,HFSR,DFSR,MMFAR,BFAR,AFSR;} SCB_Type;
+typedef struct {volatile uint32_t CTRL,CYCCNT;} DWT_Type;
+typedef struct {volatile uint32_t DHCSR,DCRSR,DCRDR,DEMCR;} CoreDebug_Type;
+typedef struct {volatile uint32_t ACR,KEYR,OPTKEYR,SR,CR,OPTCR;} FLASH_TypeDef;
+extern GPIO_TypeDef *GPIOA,*GPIOB,*GPIOC,*GPIOH;
+extern USART_TypeDef *USART1,*USART2,*USART6;
+extern I2C_TypeDef *I2C1; extern TIM_TypeDef *TIM1; extern DMA_Stream_TypeDef *DMA2_Stream2,*DMA2_Stream7,*DMA1_Stream0,*DMA1_Stream6;
+extern IWDG_TypeDef *IWDG; extern RCC_TypeDef *RCC; extern SCB_Type *SCB; extern DWT_Type *DWT; extern CoreDebug_Type *CoreDebug; extern PWR_TypeDef *PWR; extern FLASH_TypeDef *FLASH;
+#define GPIO_PIN_1 0x2u
+#define GPIO_PIN_2 0x4u
+#define GPIO_PIN_3 0x8u
+#define GPIO_PIN_5 0x20u
+#define GPIO_PIN_6 0x40u
+#define GPIO_PIN_7 0x80u
+#define GPIO_PIN_8 0x100u
+#define GPIO_PIN_9 0x200u
+#define GPIO_PIN_10 0x400u
+#define GPIO_PIN_13 0x2000u
+#define GPIO_PIN_14 0x4000u
+#define GPIO_MODE_INPUT 0
+#define GPIO_MODE_OUTPUT_PP 1
+#define GPIO_MODE_OUTPUT_OD 0x11
+#define GPIO_MODE_AF_OD 0x12
+#define GPIO_MODE_AF_PP 2
+#define GPIO_MODE_IT_RISING 0x10110000u
+#define GPIO_MODE_IT_FALLING 0x10210000u
+#define GPIO_MODE_IT_RISING_FALLING 0x10310000u
+#define GPIO_NOPULL 0
+#define GPIO_PULLUP 1
+#define GPIO_SPEED_FREQ_LOW 0
+#define GPIO_SPEED_FREQ_VERY_HIGH 3
+#define GPIO_AF4_I2C1 4
+#define GPIO_AF7_USART1 7
+#define GPIO_AF7_USART2 7
+typedef enum {FLASH_IRQn=4,EXTI0_IRQn=6,EXTI3_IRQn=9,EXTI9_5_IRQn=23,TIM1_UP_TIM10_IRQn=25,I2C1_EV_IRQn=31,I2C1_ER_IRQn=32,USART1_IRQn=37,USART2_IRQn=38,DMA2_Stream2_IRQn=58,DMA1_Stream0_IRQn=11,DMA1_Stream6_IRQn=17,DMA2_Stream7_IRQn=70} IRQn_Type;
+typedef struct {uint32_t Channel,Direction,PeriphInc,MemInc,PeriphDataAlignment,MemDataAlignment,Mode,Priority,FIFOMode;} DMA_InitTypeDef;
+typedef struct __DMA_HandleTypeDef {DMA_Stream_TypeDef *Instance; DMA_InitTypeDef Init; void *Parent;} DMA_HandleTypeDef;
+typedef enum {HAL_UART_STATE_RESET=0,HAL_UART_STATE_READY=0x20} HAL_UART_StateTypeDef;
+typedef struct {uint32_t BaudRate,WordLength,StopBits,Parity,Mode,HwFlowCtl,OverSampling;} UART_InitTypeDef;
+typedef struct __UART_HandleTypeDef {USART_TypeDef *Instance; UART_InitTypeDef Init; DMA_HandleTypeDef *hdmatx,*hdmarx; volatile HAL_UART_StateTypeDef gState; volatile uint32_t RxState; volatile uint32_t ErrorCode;} UART_HandleTypeDef;
+typedef enum {HAL_I2C_STATE_RESET=0,HAL_I2C_STATE_READY=0x20,HAL_I2C_STATE_BUSY=0x24} HAL_I2C_StateTypeDef;
+typedef struct {uint32_t ClockSpeed,DutyCycle,OwnAddress1,AddressingMode,DualAddressMode,OwnAddress2,GeneralCallMode,NoStretchMode;} I2C_InitTypeDef;
+typedef struct __I2C_HandleTypeDef {I2C_TypeDef *Instance; I2C_InitTypeDef Init; volatile HAL_I2C_StateTypeDef State; volatile uint32_t ErrorCode; DMA_HandleTypeDef *hdmatx,*hdmarx;} I2C_HandleTypeDef;
+#define HAL_I2C_ERROR_NONE 0u
+#define HAL_I2C_ERROR_BERR 1u
+#define HAL_I2C_ERROR_ARLO 2u
+#define HAL_I2C_ERROR_AF 4u
+#define HAL_I2C_ERROR_OVR 8u
+#define HAL_I2C_ERROR_TIMEOUT 0x20u
+#define I2C_DUTYCYCLE_2 0
+#define I2C_DUTYCYCLE_16_9 0x4000
+#define I2C_ADDRESSINGMODE_7BIT 0x4000
+#define I2C_DUALADDRESS_DISABLE 0
+#define I2C_GENERALCALL_DISABLE 0
+#define I2C_NOSTRETCH_DISABLE 0
+#define I2C_MEMADD_SIZE_8BIT 1
+#define I2C_FLAG_BUSY 0x00100002u
+#define __HAL_I2C_GET_FLAG(h,f) (((h)->Instance->SR2 & 2u) == 2u)
+#define I2C_CR1_SWRST (1u<<15)
+#define I2C_CR1_PE 1u
+typedef struct {uint32_t Prescaler,CounterMode,Period,ClockDivision,RepetitionCounter,AutoReloadPreload;} TIM_Base_InitTypeDef;
+typedef struct {TIM_TypeDef *Instance; TIM_Base_InitTypeDef Init;} TIM_HandleTypeDef;
+typedef struct {uint32_t ClockSource;} TIM_ClockConfigTypeDef;
+typedef struct {uint32_t MasterOutputTrigger,MasterSlaveMode;} TIM_MasterConfigTypeDef;
+typedef struct {uint32_t OCMode,Pulse,OCPolarity,OCNPolarity,OCFastMode,OCIdleState,OCNIdleState;} TIM_OC_InitTypeDef;
+typedef struct {uint32_t OffStateRunMode,OffStateIDLEMode,LockLevel,DeadTime,BreakState,BreakPolarity,AutomaticOutput;} TIM_BreakDeadTimeConfigTypeDef;
+typedef struct {uint32_t PLLState,PLLSource,PLLM,PLLN,PLLP,PLLQ;} RCC_PLLInitTypeDef;
+typedef struct {uint32_t OscillatorType,HSEState,LSEState,HSIState,HSICalibrationValue,LSIState; RCC_PLLInitTypeDef PLL;} RCC_OscInitTypeDef;
+typedef struct {uint32_t ClockType,SYSCLKSource,AHBCLKDivider,APB1CLKDivider,APB2CLKDivider;} RCC_ClkInitTypeDef;
+typedef struct {uint32_t TypeErase,Banks,Sector,NbSectors,VoltageRange;} FLASH_EraseInitTypeDef;
+typedef struct {IWDG_TypeDef *Instance; struct {uint32_t Prescaler,Reload;} Init;} IWDG_HandleTypeDef;
+#define IWDG_PRESCALER_32 3
+#define IWDG_PRESCALER_64 4
+#define RCC_OSCILLATORTYPE_HSI 2
+#define RCC_OSCILLATORTYPE_LSI 8
+#define RCC_HSI_ON 1
+#define RCC_LSI_ON 1
+#define RCC_HSICALIBRATION_DEFAULT 16
+#define RCC_PLL_ON 2
+#define RCC_PLL_NONE 0
+#define RCC_PLL_OFF 1
+#define RCC_PLLSOURCE_HSI 0
+#define RCC_PLLP_DIV4 4
+#define RCC_CLOCKTYPE_HCLK 2
+#define RCC_CLOCKTYPE_SYSCLK 1
+#define RCC_CLOCKTYPE_PCLK1 4
+#define RCC_CLOCKTYPE_PCLK2 8
+#define RCC_SYSCLKSOURCE_PLLCLK 2
+#define RCC_SYSCLKSOURCE_HSI 0
+#define RCC_SYSCLK_DIV1 0
+#define RCC_SYSCLK_DIV2 0x80
+#define RCC_SYSCLK_DIV4 0x90
+#define RCC_SYSCLK_DIV8 0xA0
+#define RCC_HCLK_DIV1 0
+#define RCC_HCLK_DIV2 0x1000
+#define FLASH_LATENCY_0 0
+#define FLASH_LATENCY_2 2
+#define RCC_FLAG_IWDGRST 0x7D
+#define RCC_FLAG_SFTRST 0x7C
+#define RCC_FLAG_PORRST 0x7B
+#define __HAL_RCC_GET_FLAG(f) (RCC->CSR & (1u << ((f)&31)))
+#define __HAL_RCC_CLEAR_RESET_FLAGS() (RCC->CSR |= (1u<<24))
+#define PWR_REGULATOR_VOLTAGE_SCALE2 0x8000
+#define PWR_MAINREGULATOR_ON 0
+#define PWR_SLEEPENTRY_WFI 1
+#define UART_WORDLENGTH_8B 0
+#define UART_STOPBITS_1 0
+#define UART_PARITY_NONE 0
+#define UART_MODE_TX_RX 0xC
+#define UART_HWCONTROL_NONE 0
+#define UART_OVERSAMPLING_16 0
+#define UART_OVERSAMPLING_8 0x8000
+#define UART_BRR_SAMPLING16(p,b) ((p)/(b))
+#define UART_BRR_SAMPLING8(p,b) ((p)/(b))
+#define __HAL_UART_ENABLE(h) ((h)->Instance->CR1 |= 0x2000u)
+#define __HAL_UART_DISABLE(h) ((h)->Instance->CR1 &= ~0x2000u)
+#define DMA_IT_HT 8u
+#define __HAL_DMA_DISABLE_IT(h,i) ((h)->Instance->CR &= ~(i))
+#define DMA_CHANNEL_4 0
+#define DMA_PERIPH_TO_MEMORY 0
+#define DMA_MEMORY_TO_PERIPH 0x40
+#define DMA_PINC_DISABLE 0
+#define DMA_MINC_ENABLE 0x400
+#define DMA_PDATAALIGN_BYTE 0
+#define DMA_MDATAALIGN_BYTE 0
+#define DMA_NORMAL 0
+#define DMA_PRIORITY_LOW 0
+#define DMA_FIFOMODE_DISABLE 0
+#define TIM_COUNTERMODE_UP 0
+#define TIM_CLOCKDIVISION_DIV1 0
+#define TIM_AUTORELOAD_PRELOAD_DISABLE 0
+#define __HAL_TIM_SET_PRESCALER(h,p) ((h)->Instance->PSC = (p))
+#define __HAL_TIM_SET_COUNTER(h,c) ((h)->Instance->CNT = (c))
+#define __HAL_TIM_GET_COUNTER(h) ((h)->Instance->CNT)
+#define FLASH_TYPEERASE_SECTORS 0
+#define FLASH_VOLTAGE_RANGE_3 2
+#define FLASH_TYPEPROGRAM_BYTE 0
+#define FLASH_TYPEPROGRAM_HALFWORD 1
+#define FLASH_TYPEPROGRAM_WORD 2
+#define FLASH_SECTOR_5 5
+#define FLASH_SECTOR_6 6
+#define FLASH_SECTOR_7 7
+#define SCB_CFSR_MEMFAULTSR_Msk 0xFFu
+#define SCB_SHCSR_USGFAULTENA_Msk (1u<<18)
+#define SCB_SHCSR_BUSFAULTENA_Msk (1u<<17)
+#define SCB_SHCSR_MEMFAULTENA_Msk (1u<<16)
+#define CoreDebug_DEMCR_TRCENA_Msk (1u<<24)
+#define DWT_CTRL_CYCCNTENA_Msk 1u
+#define UNUSED(x) ((void)(x))
+#define __weak __attribute__((weak))
+#define __NOP() do{}while(0)
+#define __WFI() do{}while(0)
+#define __DSB() do{}while(0)
+#define __ISB() do{}while(0)
+static inline void __disable_irq(void){}
+static inline void __enable_irq(void){}
+static inline uint32_t __get_PRIMASK(void){return 0;}
+static inline void __set_PRIMASK(uint32_t p){(void)p;}
+static inline uint32_t __get_MSP(void){return 0;}
+static inline uint32_t __get_PSP(void){return 0;}
+void NVIC_SystemReset(void);
+#define HAL_MAX_DELAY 0xFFFFFFFFu
+uint32_t HAL_GetTick(void); void HAL_Delay(uint32_t); void HAL_IncTick(void); void HAL_SuspendTick(void); void HAL_ResumeTick(void);
+HAL_StatusTypeDef HAL_Init(void); HAL_StatusTypeDef HAL_InitTick(uint32_t);
+#define uwTickPrio 0
+void HAL_GPIO_Init(GPIO_TypeDef*,GPIO_InitTypeDef*); void HAL_GPIO_DeInit(GPIO_TypeDef*,uint32_t);
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef*,uint16_t); void HAL_GPIO_WritePin(GPIO_TypeDef*,uint16_t,GPIO_PinState); void HAL_GPIO_TogglePin(GPIO_TypeDef*,uint16_t);
+void HAL_GPIO_EXTI_IRQHandler(uint16_t); void HAL_GPIO_EXTI_Callback(uint16_t);
+void HAL_NVIC_SetPriority(IRQn_Type,uint32_t,uint32_t); void HAL_NVIC_EnableIRQ(IRQn_Type); void HAL_NVIC_DisableIRQ(IRQn_Type);
+HAL_StatusTypeDef HAL_UART_Init(UART_HandleTypeDef*); HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef*,uint8_t*,uint16_t,uint32_t);
+HAL_StatusTypeDef HAL_UART_Transmit_DMA(UART_HandleTypeDef*,uint8_t*,uint16_t); HAL_StatusTypeDef HAL_UART_Transmit_IT(UART_HandleTypeDef*,uint8_t*,uint16_t);
+HAL_StatusTypeDef HAL_UART_Receive_IT(UART_HandleTypeDef*,uint8_t*,uint16_t); HAL_StatusTypeDef HAL_UARTEx_ReceiveToIdle_DMA(UART_HandleTypeDef*,uint8_t*,uint16_t);
+HAL_StatusTypeDef HAL_UART_AbortReceive(UART_HandleTypeDef*); HAL_StatusTypeDef HAL_UART_Abort(UART_HandleTypeDef*); void HAL_UART_IRQHandler(UART_HandleTypeDef*);
+HAL_UART_StateTypeDef HAL_UART_GetState(UART_HandleTypeDef*);
+HAL_StatusTypeDef HAL_DMA_Init(DMA_HandleTypeDef*); HAL_StatusTypeDef HAL_DMA_DeInit(DMA_HandleTypeDef*); void HAL_DMA_IRQHandler(DMA_HandleTypeDef*);
+#define __HAL_LINKDMA(h,f,d) do{(h)->f=&(d);(d).Parent=(h);}while(0)
+HAL_StatusTypeDef HAL_I2C_Init(I2C_HandleTypeDef*); HAL_StatusTypeDef HAL_I2C_DeInit(I2C_HandleTypeDef*);
+HAL_StatusTypeDef HAL_I2C_IsDeviceReady(I2C_HandleTypeDef*,uint16_t,uint32_t,uint32_t);
+HAL_StatusTypeDef HAL_I2C_Mem_Read(I2C_HandleTypeDef*,uint16_t,uint16_t,uint16_t,uint8_t*,uint16_t,uint32_t);
+HAL_StatusTypeDef HAL_I2C_Mem_Write(I2C_HandleTypeDef*,uint16_t,uint16_t,uint16_t,uint8_t*,uint16_t,uint32_t);
+HAL_StatusTypeDef HAL_I2C_Mem_Read_IT(I2C_HandleTypeDef*,uint16_t,uint16_t,uint16_t,uint8_t*,uint16_t);
+HAL_StatusTypeDef HAL_I2C_Mem_Read_DMA(I2C_HandleTypeDef*,uint16_t,uint16_t,uint16_t,uint8_t*,uint16_t);
+HAL_StatusTypeDef HAL_I2C_Mem_Write_IT(I2C_HandleTypeDef*,uint16_t,uint16_t,uint16_t,uint8_t*,uint16_t);
+HAL_StatusTypeDef HAL_I2C_Master_Transmit_IT(I2C_HandleTypeDef*,uint16_t,uint8_t*,uint16_t);
+HAL_StatusTypeDef HAL_I2C_Master_Transmit(I2C_HandleTypeDef*,uint16_t,uint8_t*,uint16_t,uint32_t);
+HAL_I2C_StateTypeDef HAL_I2C_GetState(I2C_HandleTypeDef*); uint32_t HAL_I2C_GetError(I2C_HandleTypeDef*);
+void HAL_I2C_EV_IRQHandler(I2C_HandleTypeDef*); void HAL_I2C_ER_IRQHandler(I2C_HandleTypeDef*);
+HAL_StatusTypeDef HAL_TIM_Base_Init(TIM_HandleTypeDef*); HAL_StatusTypeDef HAL_TIM_Base_Start_IT(TIM_HandleTypeDef*); HAL_StatusTypeDef HAL_TIM_Base_Stop_IT(TIM_HandleTypeDef*);
+HAL_StatusTypeDef HAL_TIM_ConfigClockSource(TIM_HandleTypeDef*,TIM_ClockConfigTypeDef*); HAL_StatusTypeDef HAL_TIM_OC_Init(TIM_HandleTypeDef*);
+HAL_StatusTypeDef HAL_TIMEx_MasterConfigSynchronization(TIM_HandleTypeDef*,TIM_MasterConfigTypeDef*); HAL_StatusTypeDef HAL_TIM_OC_ConfigChannel(TIM_HandleTypeDef*,TIM_OC_InitTypeDef*,uint32_t);
+HAL_StatusTypeDef HAL_TIMEx_ConfigBreakDeadTime(TIM_HandleTypeDef*,TIM_BreakDeadTimeConfigTypeDef*); void HAL_TIM_IRQHandler(TIM_HandleTypeDef*);
+#define TIM_CLOCKSOURCE_INTERNAL 0
+#define TIM_TRGO_UPDATE 0x20
+#define TIM_MASTERSLAVEMODE_DISABLE 0
+#define TIM_OCMODE_TIMING 0
+#define TIM_OCPOLARITY_HIGH 0
+#define TIM_OCNPOLARITY_HIGH 0
+#define TIM_OCFAST_DISABLE 0
+#define TIM_OCIDLESTATE_RESET 0
+#define TIM_OCNIDLESTATE_RESET 0
+#define TIM_CHANNEL_1 0
+#define TIM_OSSR_DISABLE 0
+#define TIM_OSSI_DISABLE 0
+#define TIM_LOCKLEVEL_OFF 0
+#define TIM_BREAK_DISABLE 0
+#define TIM_BREAKPOLARITY_HIGH 0
+#define TIM_AUTOMATICOUTPUT_DISABLE 0
+HAL_StatusTypeDef HAL_RCC_OscConfig(RCC_OscInitTypeDef*); HAL_StatusTypeDef HAL_RCC_ClockConfig(RCC_ClkInitTypeDef*,uint32_t);
+uint32_t HAL_RCC_GetPCLK1Freq(void); uint32_t HAL_RCC_GetPCLK2Freq(void); uint32_t HAL_RCC_GetHCLKFreq(void); uint32_t HAL_RCC_GetSysClockFreq(void);
+extern uint32_t SystemCoreClock; void SystemCoreClockUpdate(void);
+#define __HAL_RCC_PWR_CLK_ENABLE() do{}while(0)
+#define __HAL_PWR_VOLTAGESCALING_CONFIG(x) do{}while(0)
+#define __HAL_RCC_GPIOA_CLK_ENABLE() do{}while(0)
+#define __HAL_RCC_GPIOB_CLK_ENABLE() do{}while(0)
+#define __HAL_RCC_GPIOC_CLK_ENABLE() do{}while(0)
+#define __HAL_RCC_GPIOH_CLK_ENABLE() do{}while(0)
+#define __HAL_RCC_DMA1_CLK_ENABLE() do{}while(0)
+#define __HAL_RCC_DMA2_CLK_ENABLE() do{}while(0)
+#define __HAL_RCC_I2C1_CLK_ENABLE() do{}while(0)
+#define __HAL_RCC_I2C1_CLK_DISABLE() do{}while(0)
+#define __HAL_RCC_I2C1_FORCE_RESET() do{}while(0)
+#define __HAL_RCC_I2C1_RELEASE_RESET() do{}while(0)
+#define __HAL_RCC_USART1_CLK_ENABLE() do{}while(0)
+#define __HAL_RCC_USART1_CLK_DISABLE() do{}while(0)
+#define __HAL_RCC_USART2_CLK_ENABLE() do{}while(0)
+#define __HAL_RCC_USART2_CLK_DISABLE() do{}while(0)
+#define __HAL_RCC_TIM1_CLK_ENABLE() do{}while(0)
+#define __HAL_RCC_TIM1_CLK_DISABLE() do{}while(0)
+#define __HAL_RCC_SYSCFG_CLK_ENABLE() do{}while(0)
+void HAL_PWR_EnterSLEEPMode(uint32_t,uint8_t);
+HAL_StatusTypeDef HAL_IWDG_Init(IWDG_HandleTypeDef*); HAL_StatusTypeDef HAL_IWDG_Refresh(IWDG_HandleTypeDef*);
+HAL_StatusTypeDef HAL_FLASH_Unlock(void); HAL_StatusTypeDef HAL_FLASH_Lock(void);
+HAL_StatusTypeDef HAL_FLASH_Program(uint32_t,uint32_t,uint64_t); HAL_StatusTypeDef HAL_FLASHEx_Erase(FLASH_EraseInitTypeDef*,uint32_t*);
+HAL_StatusTypeDef HAL_FLASHEx_Erase_IT(FLASH_EraseInitTypeDef*); void HAL_FLASH_IRQHandler(void);
+void HAL_FLASH_EndOfOperationCallback(uint32_t); void HAL_FLASH_OperationErrorCallback(uint32_t);
+#endif
+#define DMA_CHANNEL_1 0x02000000U
+#define __HAL_RCC_DMA1_CLK_ENABLE() do{}while(0)
+#define RCC_CFGR_PPRE2 0xE000u
+#define RCC_CFGR_PPRE2_DIV2 0x8000u
+#define RCC_OSCILLATORTYPE_NONE 0
+#ifndef STUB_NVIC
+#define STUB_NVIC
+typedef struct {volatile uint32_t ISER[8]; uint32_t r0[24]; volatile uint32_t ICER[8]; uint32_t r1[24]; volatile uint32_t ISPR[8];} NVIC_Type;
+extern NVIC_Type *NVIC;
+#define __HAL_DBGMCU_FREEZE_IWDG() do{}while(0)
+#endif
+#ifndef GPIO_SPEED_FREQ_HIGH
+#define GPIO_SPEED_FREQ_HIGH 2
+#endif
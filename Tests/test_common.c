@@ -0,0 +1,25 @@
+/*
+ * test_common.c
+ *
+ *  Created on: 19 October 2026
+ */
+
+/* Helpers shared by host tests.
+ */
+
+#include "stdio.h"
+#include "stdlib.h"
+#include "test_common.h"
+
+/*
+ * Report failed check and end the test
+ *
+ * @param[*Msg] - what failed
+ * @param[Arg] - value which shows where it failed
+ * @return - does not return
+ */
+void Test_Fail(const char *Msg, uint32_t Arg)
+{
+	printf("FAIL: %s %lu\n", Msg, (unsigned long) Arg);
+	exit(1);
+}
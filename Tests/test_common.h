@@ -0,0 +1,14 @@
+/*
+ * test_common.h
+ *
+ *  Created on: 19 October 2026
+ */
+
+#ifndef TESTS_TEST_COMMON_H_
+#define TESTS_TEST_COMMON_H_
+
+#include "stdint.h"
+
+void Test_Fail(const char *Msg, uint32_t Arg) __attribute__((noreturn));
+
+#endif /* TESTS_TEST_COMMON_H_ */
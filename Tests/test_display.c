@@ -0,0 +1,191 @@
+/*
+ * test_display.c
+ *
+ *  Created on: 19 October 2026
+ */
+
+/* Rendering of values on segment display.
+ *
+ * Frames are turned back to text ('.' after digit with separator, ' ' for blank digit)
+ * and compared with expected text.
+ *
+ *  - negative values, minus right before the number
+ *  - values between -1 and 1, leading zero stays and sign is kept
+ *  - decimals which do not fit are rounded half away from zero, also when rounding
+ *    adds integer digit
+ *  - values which do not fit at all and floats out of range or NaN give Err
+ *  - Display_ShowFloat rounds hundredths, frame is written only when it changes
+ */
+
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+#include "math.h"
+#include "display.h"
+#include "test_common.h"
+
+static uint8_t Test_Frame[DISPLAY_MAX_DIGITS];
+static uint32_t Test_FrameWrites;
+
+static void Test_BackendInit(void)
+{
+}
+
+static void Test_BackendWriteFrame(const uint8_t *Frame, uint8_t Digits)
+{
+	memcpy(Test_Frame, Frame, Digits);
+	Test_FrameWrites++;
+}
+
+static void Test_BackendSetBrightness(uint8_t Brightness)
+{
+	(void) Brightness;
+}
+
+static const Display_Backend_t Test_Backend = {
+	.Name = "TEST",
+	.Digits = 4,
+	.Init = Test_BackendInit,
+	.WriteFrame = Test_BackendWriteFrame,
+	.SetBrightness = Test_BackendSetBrightness,
+};
+
+/*
+ * Frame as text, digits and letters which are rendered by display.c
+ */
+static void Test_FrameText(const uint8_t *Frame, uint8_t Digits, char *Text)
+{
+	static const uint8_t Segments[] = {
+		0x3f, 0x06, 0x5b, 0x4f, 0x66, 0x6d, 0x7d, 0x07, 0x7f, 0x6f,
+		0x40, 0x79, 0x50, 0x00
+	};
+	static const char Chars[] = "0123456789-Er ";
+	uint8_t i, j;
+
+	for (i = 0; i < Digits; i++)
+	{
+		*Text = '?';
+		for (j = 0; j < sizeof(Segments); j++)
+		{
+			if ((Frame[i] & ~DISPLAY_SEG_SEPARATOR) == Segments[j])
+			{
+				*Text = Chars[j];
+			}
+		}
+		Text++;
+		if (Frame[i] & DISPLAY_SEG_SEPARATOR)
+		{
+			*Text++ = '.';
+		}
+	}
+	*Text = 0;
+}
+
+/*
+ * Render hundredths on display of Digits and compare with expected text
+ */
+static void Test_Fixed(int32_t Value, uint8_t Digits, const char *Expected, uint8_t Status)
+{
+	uint8_t Frame[DISPLAY_MAX_DIGITS];
+	char Text[2 * DISPLAY_MAX_DIGITS + 1];
+
+	if (Display_RenderFixed(Value, Digits, Frame) != Status)
+	{
+		Test_Fail("wrong status of value", (uint32_t) Value);
+	}
+	Test_FrameText(Frame, Digits, Text);
+	if (strcmp(Text, Expected) != 0)
+	{
+		printf("%ld on %u digits: \"%s\", expected \"%s\"\n", (long) Value, Digits, Text,
+				Expected);
+		Test_Fail("wrong frame of value", (uint32_t) Value);
+	}
+}
+
+/*
+ * Show float on test backend and compare written frame with expected text
+ */
+static void Test_Float(Display_t *Display, float Value, const char *Expected, uint8_t Status)
+{
+	char Text[2 * DISPLAY_MAX_DIGITS + 1];
+
+	if (Display_ShowFloat(Display, Value) != Status)
+	{
+		Test_Fail("wrong status of float, hundredths", (uint32_t) (int32_t) (Value * 100));
+	}
+	Test_FrameText(Test_Frame, Test_Backend.Digits, Text);
+	if (strcmp(Text, Expected) != 0)
+	{
+		printf("%f: \"%s\", expected \"%s\"\n", (double) Value, Text, Expected);
+		Test_Fail("wrong frame of float, hundredths", (uint32_t) (int32_t) (Value * 100));
+	}
+}
+
+int main(void)
+{
+	Display_t Display;
+	uint32_t Writes;
+
+	// positive, all decimals fit
+	Test_Fixed(0, 4, " 0.00", DISPLAY_OK);
+	Test_Fixed(2512, 4, "25.12", DISPLAY_OK);
+	Test_Fixed(2512, 6, "  25.12", DISPLAY_OK);
+	Test_Fixed(1, 4, " 0.01", DISPLAY_OK);
+
+	// negative and between -1 and 0
+	Test_Fixed(-2512, 6, " -25.12", DISPLAY_OK);
+	Test_Fixed(-5, 4, "-0.05", DISPLAY_OK);
+	Test_Fixed(-99, 6, "  -0.99", DISPLAY_OK);
+
+	// decimals which do not fit are rounded, half away from zero
+	Test_Fixed(12345, 4, "123.5", DISPLAY_OK);
+	Test_Fixed(12344, 4, "123.4", DISPLAY_OK);
+	Test_Fixed(-2512, 4, "-25.1", DISPLAY_OK);
+	Test_Fixed(-2515, 4, "-25.2", DISPLAY_OK);
+	Test_Fixed(-12345, 4, "-123", DISPLAY_OK);
+	Test_Fixed(-12350, 4, "-124", DISPLAY_OK);
+
+	// rounding adds integer digit, one more decimal is dropped
+	Test_Fixed(99996, 4, "1000", DISPLAY_OK);
+	Test_Fixed(9996, 3, "100", DISPLAY_OK);
+	Test_Fixed(-9996, 4, "-100", DISPLAY_OK);
+	Test_Fixed(-99950, 4, " Err", DISPLAY_ERR_RANGE);
+
+	// value rounded to zero has no minus
+	Test_Fixed(-4, 2, "0.0", DISPLAY_OK);
+	Test_Fixed(-40, 2, " 0", DISPLAY_OK);
+	Test_Fixed(-50, 2, "-1", DISPLAY_OK);
+
+	// does not fit at all
+	Test_Fixed(1000000, 4, " Err", DISPLAY_ERR_RANGE);
+	Test_Fixed(-100000, 4, " Err", DISPLAY_ERR_RANGE);
+	Test_Fixed(INT32_MAX, 6, "   Err", DISPLAY_ERR_RANGE);
+	Test_Fixed(INT32_MIN, 6, "   Err", DISPLAY_ERR_RANGE);
+
+	// floats are rounded to hundredths, not cut
+	Display_Init(&Display, &Test_Backend);
+	Test_Float(&Display, 123.45f, "123.5", DISPLAY_OK);
+	Test_Float(&Display, 0.0625f, " 0.06", DISPLAY_OK);
+	Test_Float(&Display, 25.0625f, "25.06", DISPLAY_OK);
+	Test_Float(&Display, 25.9375f, "25.94", DISPLAY_OK);
+	Test_Float(&Display, -0.0625f, "-0.06", DISPLAY_OK);
+	Test_Float(&Display, -0.004f, " 0.00", DISPLAY_OK);
+	Test_Float(&Display, -25.9375f, "-25.9", DISPLAY_OK);
+	Test_Float(&Display, 0.999f, " 1.00", DISPLAY_OK);
+	Test_Float(&Display, 151.0f, " Err", DISPLAY_ERR_RANGE);
+	Test_Float(&Display, -150.5f, " Err", DISPLAY_ERR_RANGE);
+	Test_Float(&Display, NAN, " Err", DISPLAY_ERR_RANGE);
+
+	// same hundredths are not rendered nor written again
+	Test_Float(&Display, 21.5f, "21.50", DISPLAY_OK);
+	Writes = Test_FrameWrites;
+	Test_Float(&Display, 21.501f, "21.50", DISPLAY_OK);
+	if (Test_FrameWrites != Writes)
+	{
+		Test_Fail("same frame written again, writes", Test_FrameWrites);
+	}
+
+	printf("ok rounding, sign and range of rendered values\n");
+
+	return 0;
+}
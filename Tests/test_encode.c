@@ -0,0 +1,381 @@
+/*
+ * test_encode.c
+ *
+ *  Created on: 19 October 2026
+ */
+
+/* Round trip of delta encoded history.
+ *
+ *  - random batches through Encode_DeltaBatch and Decode_DeltaBatch, also full scale
+ *    jumps of value and wrap of tick
+ *  - every shorter prefix of a batch is refused by decoder
+ *  - base64 of random bytes of every lenght decodes back, broken text is refused
+ *  - HISTORY command runs in parser for sensors with empty, single, steady, fast and
+ *    full scale histories, the terminal output is decoded by history_decode.c and has
+ *    to give the same samples
+ *  - trace fixture (trace/) is cut to batches of TMP102_ARRAY_HISTORY_SIZE like HISTORY
+ *    sends it, batch and text sizes are compared with raw samples and Encode_DeltaBatch
+ *    is timed with clock()
+ * Size of every HISTORY frame is printed: batch bytes, line characters and raw
+ * binary samples (4 bytes tick + 2 bytes value).
+ *
+ * usage: test_encode [trace file]
+ */
+
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+#include "time.h"
+#include "main.h"
+#include "usart.h"
+#include "i2c.h"
+#include "JDY-09.h"
+#include "parse.h"
+#include "pool.h"
+#include "encode.h"
+#include "host_hal.h"
+#include "parse_stubs.h"
+#include "history_decode.h"
+#include "test_common.h"
+
+#define TEST_BATCHES					100000
+#define TEST_CAPTURE_SIZE				4096
+#define TEST_TRACE_MAX					4096	// samples read from trace file
+#define TEST_TRACE_PASSES				2000	// encodings of whole trace for timing
+
+static JDY09_t Test_JDY09;
+static TMP102Array_t Test_Array;
+static uint8_t Test_Capture[TEST_CAPTURE_SIZE];
+static uint32_t Test_State = 1;
+
+static uint32_t Test_Random(void)
+{
+	Test_State ^= Test_State << 13;
+	Test_State ^= Test_State >> 17;
+	Test_State ^= Test_State << 5;
+
+	return Test_State;
+}
+
+/*
+ * Random batches, some with full scale steps of value and tick
+ */
+static void Test_RoundTrip(void)
+{
+	int16_t Values[TMP102_ARRAY_HISTORY_SIZE], Decoded[TMP102_ARRAY_HISTORY_SIZE];
+	uint32_t Timestamps[TMP102_ARRAY_HISTORY_SIZE], DecodedTime[TMP102_ARRAY_HISTORY_SIZE];
+	uint8_t Batch[ENCODE_BATCH_SIZE(TMP102_ARRAY_HISTORY_SIZE)];
+	uint32_t Batches, Time;
+	uint16_t Lenght, Prefix;
+	uint8_t Count, i;
+	int16_t Value;
+
+	for (Batches = 0; Batches < TEST_BATCHES; Batches++)
+	{
+		Count = Test_Random() % (TMP102_ARRAY_HISTORY_SIZE + 1);
+		Value = (int16_t) (Test_Random() % 4096) - 2048;
+		Time = (Batches % 5 == 0) ? 0xFFFFF000 : Test_Random();
+
+		for (i = 0; i < Count; i++)
+		{
+			if (Batches % 10 == 0)
+			{
+				Value = (int16_t) Test_Random();
+			}
+			else if (Batches % 10 == 1)
+			{
+				Value = (i & 1) ? INT16_MIN : INT16_MAX;
+			}
+			else
+			{
+				Value += (int16_t) (Test_Random() % 7) - 3;
+			}
+			Time += (Batches % 7 == 0) ? Test_Random() : (125 + Test_Random() % 4000);
+			Values[i] = Value;
+			Timestamps[i] = Time;
+		}
+
+		Lenght = Encode_DeltaBatch(Values, Timestamps, Count, Batch, sizeof(Batch));
+		if (Lenght == 0)
+		{
+			Test_Fail("batch not encoded, samples", Count);
+		}
+		if (Decode_DeltaBatch(Batch, Lenght, Decoded, DecodedTime,
+				TMP102_ARRAY_HISTORY_SIZE) != Count)
+		{
+			Test_Fail("wrong sample count, batch", Batches);
+		}
+		for (i = 0; i < Count; i++)
+		{
+			if (Decoded[i] != Values[i] || DecodedTime[i] != Timestamps[i])
+			{
+				Test_Fail("sample differs, batch", Batches);
+			}
+		}
+
+		for (Prefix = 1; Count > 0 && Prefix < Lenght; Prefix++)
+		{
+			if (Decode_DeltaBatch(Batch, Prefix, Decoded, DecodedTime,
+					TMP102_ARRAY_HISTORY_SIZE) != 0)
+			{
+				Test_Fail("cut batch decoded, batch", Batches);
+			}
+		}
+	}
+	printf("ok %lu random batches\n", (unsigned long) Batches);
+}
+
+/*
+ * Base64 of every lenght up to one full batch, and text which has to be refused
+ */
+static void Test_Base64(void)
+{
+	uint8_t Data[ENCODE_BATCH_SIZE(TMP102_ARRAY_HISTORY_SIZE)];
+	uint8_t Decoded[sizeof(Data)];
+	char Text[ENCODE_BASE64_SIZE(sizeof(Data)) + 1];
+	uint16_t Lenght, Size, i;
+	static const char *Broken[] = { "QUJD", "QUI", "Q===", "QU=D", "QUJ*", "QQ==QUJD" };
+
+	for (Lenght = 1; Lenght <= sizeof(Data); Lenght++)
+	{
+		for (i = 0; i < Lenght; i++)
+		{
+			Data[i] = (uint8_t) Test_Random();
+		}
+		Size = Encode_Base64(Data, Lenght, Text);
+		if (Size != ENCODE_BASE64_SIZE(Lenght))
+		{
+			Test_Fail("wrong base64 size, bytes", Lenght);
+		}
+		if (Decode_Base64(Text, Size, Decoded, sizeof(Decoded)) != Lenght
+				|| memcmp(Data, Decoded, Lenght) != 0)
+		{
+			Test_Fail("base64 differs, bytes", Lenght);
+		}
+		if (Lenght > 1 && Decode_Base64(Text, Size, Decoded, Lenght - 1) != 0)
+		{
+			Test_Fail("base64 too long for buffer decoded, bytes", Lenght);
+		}
+	}
+
+	// RFC 4648 test vector, then broken ones (first one is good but 3 bytes do not fit)
+	Size = Encode_Base64((const uint8_t*) "foob", 4, Text);
+	if (Size != 8 || memcmp(Text, "Zm9vYg==", 8) != 0)
+	{
+		Test_Fail("wrong base64 of test vector, size", Size);
+	}
+	for (i = 0; i < sizeof(Broken) / sizeof(Broken[0]); i++)
+	{
+		if (Decode_Base64(Broken[i], strlen(Broken[i]), Decoded, (i == 0) ? 2 : 16) != 0)
+		{
+			Test_Fail("broken base64 decoded, case", i);
+		}
+	}
+	printf("ok base64 of 1 to %u bytes\n", (unsigned) sizeof(Data));
+}
+
+/*
+ * Fill history of sensor, oldest sample first
+ */
+static void Test_SetHistory(uint8_t Index, uint8_t Count, uint32_t Period, int16_t Start,
+		int16_t Step, uint8_t Noise)
+{
+	TMP102ArraySensor_t *Entry = &Test_Array.Sensors[Index];
+	uint32_t Time = 100000;
+	int16_t Value = Start;
+	uint8_t i;
+
+	for (i = 0; i < Count; i++)
+	{
+		Entry->History[i].Value = Value + (Noise ? (int16_t) (Test_Random() % 3) - 1 : 0);
+		Entry->History[i].Timestamp = Time;
+		Value += Step;
+		Time += Period;
+	}
+	Entry->HistoryHead = Count % TMP102_ARRAY_HISTORY_SIZE;
+	Entry->HistoryCount = Count;
+}
+
+/*
+ * HISTORY response decoded like on the receiving side
+ */
+static void Test_HistoryCommand(void)
+{
+	int16_t Values[TMP102_ARRAY_HISTORY_SIZE];
+	uint32_t Timestamps[TMP102_ARRAY_HISTORY_SIZE];
+	TMP102ArraySensor_t *Entry;
+	uint8_t Address, Count, Lines = 0, i;
+	uint16_t BatchSize;
+	uint8_t Command[] = "HISTORY;\n";
+	char *Line;
+	char *Next;
+
+	Test_Array.I2CHandle = &hi2c1;
+	for (i = 0; i < 4; i++)
+	{
+		Stub_AddSensor(&Test_Array, 0x48 + i, 0);
+	}
+	Test_SetHistory(0, 0, 0, 0, 0, 0);
+	Test_SetHistory(1, TMP102_ARRAY_HISTORY_SIZE, 4000, 400, 0, 1);
+	Test_SetHistory(2, TMP102_ARRAY_HISTORY_SIZE, 125, -40, 5, 1);
+	Test_SetHistory(3, 2, 0xFFFFFFFF, INT16_MIN, -1, 0);
+	Test_Array.Sensors[3].History[1].Value = INT16_MAX;
+
+	Host_UartCapture = Test_Capture;
+	Host_UartCaptureSize = sizeof(Test_Capture) - 1;
+	Parser_Parse(Command);
+	while (Parser_IsBusy())
+	{
+		Parser_Execute(&Test_Array);
+	}
+	if (JDY09_WaitTxIdle(&Test_JDY09, JDY09_UART_TIMEOUET) != JDY09_OK)
+	{
+		Test_Fail("transmit queue not empty", 0);
+	}
+	Host_UartCapture = NULL;
+	Test_Capture[Host_UartCaptured] = 0;
+
+	for (Line = (char*) Test_Capture; *Line != 0; Line = Next)
+	{
+		Next = strchr(Line, '\n');
+		Next = (Next != NULL) ? Next + 1 : Line + strlen(Line);
+		if (*Line == '\r')
+		{
+			Line++;
+		}
+
+		switch (HistoryDecode_Line(Line, &Address, Values, Timestamps,
+				TMP102_ARRAY_HISTORY_SIZE, &Count, &BatchSize))
+		{
+		case HISTORY_DECODE_NOT_HISTORY:
+			continue;
+		case HISTORY_DECODE_OK:
+			break;
+		default:
+			Test_Fail("broken line", Lines);
+		}
+
+		Entry = &Test_Array.Sensors[Lines];
+		if (Lines >= Test_Array.SensorCount || Address != Entry->Sensor.Address
+				|| Count != Entry->HistoryCount)
+		{
+			Test_Fail("unexpected line", Lines);
+		}
+		for (i = 0; i < Count; i++)
+		{
+			if (Values[i] != Entry->History[i].Value
+					|| Timestamps[i] != Entry->History[i].Timestamp)
+			{
+				Test_Fail("sample differs, sensor", Lines);
+			}
+		}
+		printf("size 0x%02X: %u samples, batch %u B, line %u chars, raw %u B\n", Address,
+				Count, BatchSize, (unsigned) (strcspn(Line, "\r\n") + 2), Count * 6);
+		Lines++;
+	}
+
+	if (Lines != Test_Array.SensorCount)
+	{
+		Test_Fail("missing lines, got", Lines);
+	}
+	printf("ok HISTORY of %u sensors\n", Lines);
+}
+
+/*
+ * Sizes and encode time of trace cut to HISTORY batches
+ */
+static void Test_Trace(const char *Path)
+{
+	static int16_t Values[TEST_TRACE_MAX];
+	static uint32_t Timestamps[TEST_TRACE_MAX];
+	int16_t Decoded[TMP102_ARRAY_HISTORY_SIZE];
+	uint32_t DecodedTime[TMP102_ARRAY_HISTORY_SIZE];
+	uint8_t Batch[ENCODE_BATCH_SIZE(TMP102_ARRAY_HISTORY_SIZE)];
+	uint32_t Count = 0, Batches = 0, Bytes = 0, Base64 = 0, Pass, i, j;
+	volatile uint32_t Sink = 0;
+	unsigned long Tick;
+	long Value;
+	char Line[64];
+	clock_t Start, Time;
+	uint8_t Size;
+	FILE *File = fopen(Path, "r");
+
+	if (File == NULL)
+	{
+		printf("FAIL: can not open %s\n", Path);
+		exit(1);
+	}
+	while (fgets(Line, sizeof(Line), File) != NULL && Count < TEST_TRACE_MAX)
+	{
+		if (sscanf(Line, "%lu %ld", &Tick, &Value) == 2)
+		{
+			Timestamps[Count] = (uint32_t) Tick;
+			Values[Count] = (int16_t) Value;
+			Count++;
+		}
+	}
+	fclose(File);
+	if (Count == 0)
+	{
+		Test_Fail("no samples in trace, lines", 0);
+	}
+
+	// sizes, every batch has to decode back
+	for (i = 0; i < Count; i += Size)
+	{
+		Size = (Count - i < TMP102_ARRAY_HISTORY_SIZE) ? Count - i : TMP102_ARRAY_HISTORY_SIZE;
+		j = Encode_DeltaBatch(&Values[i], &Timestamps[i], Size, Batch, sizeof(Batch));
+		if (Decode_DeltaBatch(Batch, j, Decoded, DecodedTime, TMP102_ARRAY_HISTORY_SIZE) != Size
+				|| memcmp(Decoded, &Values[i], Size * sizeof(Decoded[0])) != 0
+				|| memcmp(DecodedTime, &Timestamps[i], Size * sizeof(DecodedTime[0])) != 0)
+		{
+			Test_Fail("trace batch differs, sample", i);
+		}
+		Bytes += j;
+		Base64 += ENCODE_BASE64_SIZE(j);
+		Batches++;
+	}
+
+	// time of encoding only, sanitizers of host build are included
+	Start = clock();
+	for (Pass = 0; Pass < TEST_TRACE_PASSES; Pass++)
+	{
+		for (i = 0; i < Count; i += Size)
+		{
+			Size = (Count - i < TMP102_ARRAY_HISTORY_SIZE) ? Count - i : TMP102_ARRAY_HISTORY_SIZE;
+			Sink += Encode_DeltaBatch(&Values[i], &Timestamps[i], Size, Batch, sizeof(Batch));
+		}
+	}
+	Time = clock() - Start;
+
+	printf("trace %s: %lu samples in %lu batches\n", Path, (unsigned long) Count,
+			(unsigned long) Batches);
+	printf(" raw %lu B, batch %lu B (ratio %lu.%02lu), base64 %lu chars (ratio %lu.%02lu),"
+			" hex would be %lu chars\n",
+			(unsigned long) (Count * 6), (unsigned long) Bytes,
+			(unsigned long) (Count * 6 / Bytes), (unsigned long) (Count * 600 / Bytes % 100),
+			(unsigned long) Base64,
+			(unsigned long) (Count * 6 / Base64), (unsigned long) (Count * 600 / Base64 % 100),
+			(unsigned long) (2 * Bytes));
+	printf(" Encode_DeltaBatch %lu ns per batch of %u samples (host, %lu passes)\n",
+			(unsigned long) ((double) Time * 1e9 / CLOCKS_PER_SEC / ((double) Batches * Pass)),
+			TMP102_ARRAY_HISTORY_SIZE, (unsigned long) Pass);
+	printf("ok trace round trip\n");
+}
+
+int main(int argc, char **argv)
+{
+	Pool_Init();
+	JDY09_Init(&Test_JDY09, &huart1, BT_STATE_GPIO_Port, BT_STATE_Pin);
+	Parser_Init(&Test_JDY09);
+
+	Test_RoundTrip();
+	Test_Base64();
+	Test_HistoryCommand();
+	if (argc > 1)
+	{
+		Test_Trace(argv[1]);
+	}
+
+	return 0;
+}
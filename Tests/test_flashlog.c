@@ -0,0 +1,438 @@
+/*
+ * test_flashlog.c
+ *
+ *  Created on: 19 October 2026
+ */
+
+/* Flash log on simulated flash.
+ *
+ * Flash sectors of the log are mapped at their real address, so flashlog.c runs
+ * unchanged. Programming only clears bits and has to hit erased words, erase runs in
+ * background until Sim_FinishErase, like FLASH interrupt on target.
+ *
+ *  - empty flash is formatted, records survive reboot and get new boot number
+ *  - write cut by reset leaves slot which reads as FLASHLOG_ERR_EMPTY
+ *  - log rotates through all sectors, erase is started ahead and appends during it are
+ *    refused, readable records are always the newest appended ones in order
+ *  - reboot between end of erase and sector header, failed background erase
+ *  - failed format on boot keeps log off
+ *  - supervisor is held exactly while background erase runs
+ */
+
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+#include "sys/mman.h"
+#include "main.h"
+#include "flashlog.h"
+#include "supervisor.h"
+#include "test_common.h"
+
+#define TEST_LOG_SIZE					(FLASHLOG_SECTOR_COUNT * FLASHLOG_SECTOR_SIZE)
+#define TEST_APPENDS					(3 * FLASHLOG_SECTOR_COUNT * FLASHLOG_SECTOR_RECORDS)
+
+static uint8_t *Sim_Flash;
+static uint8_t Sim_Unlocked;
+static int32_t Sim_ErasePending = -1;		// sector erased in background
+static uint8_t Sim_EraseFail;				// next erase fails
+static uint32_t Sim_WordsLeft = UINT32_MAX;	// words programmed before reset
+static uint8_t Sim_Held;					// supervisor does not check deadlines
+
+static uint32_t *Test_Expected;				// times of stored records, oldest first
+static uint32_t Test_ExpectedCount;
+static uint32_t Test_Time;
+
+void Supervisor_Hold(void)
+{
+	if (Sim_Held)
+	{
+		Test_Fail("supervisor held twice", 0);
+	}
+	Sim_Held = 1;
+}
+
+void Supervisor_Release(void)
+{
+	if (!Sim_Held)
+	{
+		Test_Fail("supervisor released without hold", 0);
+	}
+	Sim_Held = 0;
+}
+
+HAL_StatusTypeDef HAL_FLASH_Unlock(void)
+{
+	Sim_Unlocked = 1;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_FLASH_Lock(void)
+{
+	Sim_Unlocked = 0;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_FLASH_Program(uint32_t TypeProgram, uint32_t Address, uint64_t Data)
+{
+	uint32_t *Word = (uint32_t*) (uintptr_t) Address;
+
+	if (TypeProgram != FLASH_TYPEPROGRAM_WORD || Address % 4 != 0
+			|| Address < FLASHLOG_FIRST_ADDRESS
+			|| Address >= FLASHLOG_FIRST_ADDRESS + TEST_LOG_SIZE)
+	{
+		Test_Fail("program outside log at", Address);
+	}
+	if (!Sim_Unlocked)
+	{
+		return HAL_ERROR;
+	}
+	// process lock is held by background erase
+	if (Sim_ErasePending >= 0)
+	{
+		return HAL_BUSY;
+	}
+	if (*Word != FLASHLOG_EMPTY)
+	{
+		Test_Fail("program of used word at", Address);
+	}
+	if (Sim_WordsLeft == 0)
+	{
+		return HAL_ERROR;
+	}
+	Sim_WordsLeft--;
+
+	*Word &= (uint32_t) Data;
+	return HAL_OK;
+}
+
+static uint8_t Sim_Sector(uint32_t Sector)
+{
+	if (Sector < FLASHLOG_FIRST_SECTOR || Sector >= FLASHLOG_FIRST_SECTOR + FLASHLOG_SECTOR_COUNT)
+	{
+		Test_Fail("erase outside log, sector", Sector);
+	}
+
+	return Sector - FLASHLOG_FIRST_SECTOR;
+}
+
+HAL_StatusTypeDef HAL_FLASHEx_Erase(FLASH_EraseInitTypeDef *pEraseInit, uint32_t *SectorError)
+{
+	uint8_t Sector = Sim_Sector(pEraseInit->Sector);
+
+	if (!Sim_Unlocked || Sim_ErasePending >= 0 || Sim_EraseFail)
+	{
+		*SectorError = pEraseInit->Sector;
+		return HAL_ERROR;
+	}
+
+	memset(&Sim_Flash[Sector * FLASHLOG_SECTOR_SIZE], 0xFF, FLASHLOG_SECTOR_SIZE);
+	*SectorError = 0xFFFFFFFF;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_FLASHEx_Erase_IT(FLASH_EraseInitTypeDef *pEraseInit)
+{
+	uint8_t Sector = Sim_Sector(pEraseInit->Sector);
+
+	if (!Sim_Unlocked || Sim_ErasePending >= 0)
+	{
+		return HAL_ERROR;
+	}
+
+	// content is undefined from now on
+	memset(&Sim_Flash[Sector * FLASHLOG_SECTOR_SIZE], 0x5A, FLASHLOG_SECTOR_SIZE);
+	Sim_ErasePending = Sector;
+	return HAL_OK;
+}
+
+void HAL_NVIC_SetPriority(IRQn_Type IRQn, uint32_t PreemptPriority, uint32_t SubPriority)
+{
+	(void) IRQn;
+	(void) PreemptPriority;
+	(void) SubPriority;
+}
+
+void HAL_NVIC_EnableIRQ(IRQn_Type IRQn)
+{
+	(void) IRQn;
+}
+
+void HAL_FLASH_EndOfOperationCallback(uint32_t ReturnValue)
+{
+	(void) ReturnValue;
+
+	FlashLog_EraseCpltCallback();
+}
+
+void HAL_FLASH_OperationErrorCallback(uint32_t ReturnValue)
+{
+	(void) ReturnValue;
+
+	FlashLog_EraseErrorCallback();
+}
+
+/*
+ * End of background erase, FLASH interrupt
+ */
+static void Sim_FinishErase(void)
+{
+	int32_t Sector = Sim_ErasePending;
+
+	if (Sector < 0)
+	{
+		return;
+	}
+	Sim_ErasePending = -1;
+
+	if (!Sim_Held)
+	{
+		Test_Fail("erase without supervisor hold, sector", Sector);
+	}
+
+	if (Sim_EraseFail)
+	{
+		HAL_FLASH_OperationErrorCallback(Sector + FLASHLOG_FIRST_SECTOR);
+	}
+	else
+	{
+		memset(&Sim_Flash[Sector * FLASHLOG_SECTOR_SIZE], 0xFF, FLASHLOG_SECTOR_SIZE);
+		HAL_FLASH_EndOfOperationCallback(0xFFFFFFFF);
+	}
+
+	if (Sim_Held)
+	{
+		Test_Fail("supervisor held after erase, sector", Sector);
+	}
+}
+
+/*
+ * Reset, interrupted erase leaves sector content undefined
+ */
+static uint8_t Test_Reboot(void)
+{
+	Sim_ErasePending = -1;
+	Sim_Unlocked = 0;
+	Sim_Held = 0;
+
+	return FlashLog_Init();
+}
+
+/*
+ * Append next record, it is expected in log when Append says so
+ */
+static uint8_t Test_Append(void)
+{
+	TMP102Sample_t Sample;
+	uint8_t Status;
+
+	Test_Time++;
+	Sample.Timestamp = Test_Time;
+	Sample.Value = (int16_t) Test_Time;
+
+	Status = FlashLog_Append(0x48, &Sample);
+	if (Status == FLASHLOG_OK)
+	{
+		Test_Expected[Test_ExpectedCount++] = Test_Time;
+	}
+
+	return Status;
+}
+
+/*
+ * Records which can be read are the newest expected ones, in order
+ *
+ * @return - number of records read
+ */
+static uint32_t Test_CheckLog(uint8_t Boot)
+{
+	FlashLog_Record_t Record;
+	uint32_t Count = FlashLog_GetCount();
+	uint32_t Read = 0;
+	uint32_t First = 0;
+	uint32_t i;
+
+	for (i = 0; i < Count; i++)
+	{
+		uint8_t Status = FlashLog_Read(i, &Record);
+
+		if (Status == FLASHLOG_ERR_EMPTY)
+		{
+			continue;
+		}
+		if (Status != FLASHLOG_OK)
+		{
+			Test_Fail("read failed, record", i);
+		}
+		if (Read == 0)
+		{
+			for (First = 0; First < Test_ExpectedCount && Test_Expected[First] != Record.Time; First++)
+			{
+			}
+		}
+		if (First + Read >= Test_ExpectedCount || Record.Time != Test_Expected[First + Read]
+				|| Record.Value != (int16_t) Record.Time || Record.Address != 0x48
+				|| Record.Boot > Boot)
+		{
+			Test_Fail("unexpected record", i);
+		}
+		Read++;
+	}
+
+	if (Read > 0 && First + Read != Test_ExpectedCount)
+	{
+		Test_Fail("newest records missing, read", Read);
+	}
+
+	return Read;
+}
+
+int main(void)
+{
+	FlashLog_Record_t Record;
+	uint32_t i, Busy = 0, Erases = 0, Wait = 0, Rotations, Read, Appends;
+	uint8_t Status;
+
+	Sim_Flash = mmap((void*) (uintptr_t) FLASHLOG_FIRST_ADDRESS, TEST_LOG_SIZE,
+			PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+	if (Sim_Flash != (uint8_t*) (uintptr_t) FLASHLOG_FIRST_ADDRESS)
+	{
+		Test_Fail("flash can not be mapped at", FLASHLOG_FIRST_ADDRESS);
+	}
+	// rotation phase and the checks after it
+	Test_Expected = malloc(2 * TEST_APPENDS * sizeof(uint32_t));
+
+	// format of empty flash fails, log stays off
+	memset(Sim_Flash, 0xFF, TEST_LOG_SIZE);
+	Sim_EraseFail = 1;
+	if (Test_Reboot() != FLASHLOG_ERR_FLASH || Test_Append() != FLASHLOG_ERR_FLASH)
+	{
+		Test_Fail("log works after failed format", 0);
+	}
+	Sim_EraseFail = 0;
+
+	// format, records survive reboot
+	if (Test_Reboot() != FLASHLOG_OK || FlashLog_GetCount() != 0)
+	{
+		Test_Fail("empty flash not formatted", 0);
+	}
+	for (i = 0; i < 100; i++)
+	{
+		if (Test_Append() != FLASHLOG_OK)
+		{
+			Test_Fail("append failed, record", i);
+		}
+	}
+	if (Test_Reboot() != FLASHLOG_OK || FlashLog_GetCount() != 100 || Test_CheckLog(0) != 100)
+	{
+		Test_Fail("records lost by reboot", FlashLog_GetCount());
+	}
+
+	// reset in the middle of record, boot without complete record keeps its number
+	Sim_WordsLeft = 1;
+	Test_Append();
+	Sim_WordsLeft = UINT32_MAX;
+	Test_Reboot();
+	if (FlashLog_GetCount() != 101 || FlashLog_Read(100, &Record) != FLASHLOG_ERR_EMPTY)
+	{
+		Test_Fail("cut record not found, count", FlashLog_GetCount());
+	}
+	if (Test_Append() != FLASHLOG_OK || FlashLog_Read(101, &Record) != FLASHLOG_OK
+			|| Record.Boot != 1 || Test_CheckLog(1) != 101)
+	{
+		Test_Fail("append after cut record", 0);
+	}
+	printf("ok format, reboot, cut record\n");
+
+	// rotation, every third erase ends before the active sector is full,
+	// others after one or two refused appends
+	Rotations = FlashLog_GetSequence();
+	Appends = TEST_APPENDS - Test_ExpectedCount;
+	for (i = 0; i < Appends; i++)
+	{
+		Status = Test_Append();
+		if (Status == FLASHLOG_ERR_BUSY)
+		{
+			Busy++;
+			if (Wait == 0 || --Wait == 0)
+			{
+				Sim_FinishErase();
+			}
+		}
+		else if (Status != FLASHLOG_OK)
+		{
+			Test_Fail("append failed, status", Status);
+		}
+		else if (Sim_ErasePending >= 0 && Wait == 0)
+		{
+			Wait = Erases++ % 3;
+			if (Wait == 0)
+			{
+				Sim_FinishErase();
+			}
+		}
+	}
+	Rotations = FlashLog_GetSequence() - Rotations;
+	Read = Test_CheckLog(2);
+	if (Rotations < 2 * FLASHLOG_SECTOR_COUNT || Read < FLASHLOG_SECTOR_RECORDS - FLASHLOG_ERASE_AHEAD)
+	{
+		Test_Fail("rotation, records readable", Read);
+	}
+	if (Test_Reboot() != FLASHLOG_OK || Test_CheckLog(3) != Read)
+	{
+		Test_Fail("records lost by reboot after rotation", 0);
+	}
+	printf("ok %lu rotations, %lu appends refused during erase, %lu records readable\n",
+			(unsigned long) Rotations, (unsigned long) Busy, (unsigned long) Read);
+
+	// fill active sector, erase ends but reset comes before header
+	while (FlashLog_GetCount() != FLASHLOG_SECTOR_RECORDS || Sim_ErasePending >= 0)
+	{
+		if (Test_Append() == FLASHLOG_ERR_BUSY)
+		{
+			Sim_FinishErase();
+		}
+	}
+	Rotations = FlashLog_GetSequence();
+	Test_Reboot();
+	while ((Status = Test_Append()) != FLASHLOG_OK)
+	{
+		if (Status != FLASHLOG_ERR_BUSY || Sim_ErasePending < 0)
+		{
+			Test_Fail("no erase after reboot, status", Status);
+		}
+		Sim_FinishErase();
+	}
+	if (FlashLog_GetSequence() != Rotations + 1
+			|| Test_CheckLog(4) < FLASHLOG_SECTOR_RECORDS - FLASHLOG_ERASE_AHEAD)
+	{
+		Test_Fail("rotation after reboot", FlashLog_GetSequence());
+	}
+
+	// background erase fails, it is started again when active sector is full
+	while (Sim_ErasePending < 0)
+	{
+		Test_Append();
+	}
+	Sim_EraseFail = 1;
+	Sim_FinishErase();
+	Sim_EraseFail = 0;
+	Rotations = FlashLog_GetSequence();
+	Busy = 0;
+	for (i = 0; i <= FLASHLOG_SECTOR_RECORDS && FlashLog_GetSequence() == Rotations; i++)
+	{
+		Status = Test_Append();
+		if (Status == FLASHLOG_ERR_FLASH)
+		{
+			Busy++;
+		}
+		Sim_FinishErase();
+	}
+	if (Busy != 1 || FlashLog_GetSequence() != Rotations + 1)
+	{
+		Test_Fail("no rotation after failed erase, errors", Busy);
+	}
+	Test_CheckLog(4);
+	printf("ok reboot before header, failed erase\n");
+
+	return 0;
+}
@@ -0,0 +1,204 @@
+/*
+ * test_i2cbus.c
+ *
+ *  Created on: 19 October 2026
+ */
+
+/* Benchmark of register read on host with a timing model of the bus.
+ *
+ * HAL_I2C_Mem_Read of the model advances DWT cycle counter by the time of the
+ * transfer on the wire (START, address with W, register, repeated START, address
+ * with R, data bytes, STOP, 9 bits per byte) and fixed cost of blocking HAL code.
+ * I2CBus_Benchmark is run at standard and fast speed and has to give the time of
+ * the model, also when it is not a whole number of ms.
+ *
+ *  - peripheral used by other transfer gives I2CBUS_BENCHMARK_BUSY, no read is made
+ *  - NACK of device gives I2CBUS_BENCHMARK_FAILED
+ * Time of one read at both speeds is printed.
+ */
+
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+#include "main.h"
+#include "i2c.h"
+#include "i2cbus.h"
+#include "pool.h"
+#include "test_common.h"
+
+// cost of blocking HAL_I2C_Mem_Read without bus time, flag polling of 5 bytes
+#define TEST_HAL_CYCLES					1500
+// START, repeated START and STOP
+#define TEST_CONDITION_BITS				3
+
+static DWT_Type Test_DWT;
+static CoreDebug_Type Test_CoreDebug;
+DWT_Type *DWT = &Test_DWT;
+CoreDebug_Type *CoreDebug = &Test_CoreDebug;
+
+static uint32_t Test_Reads;
+static uint8_t Test_Nack;
+
+/*
+ * Cycles of one register read in the model
+ */
+static uint32_t Test_ReadCycles(uint32_t Speed, uint16_t Size)
+{
+	uint32_t Bits = (Size + I2CBUS_MEM_OVERHEAD) * I2CBUS_BITS_PER_BYTE + TEST_CONDITION_BITS;
+
+	return (uint32_t) ((uint64_t) Bits * SystemCoreClock / Speed) + TEST_HAL_CYCLES;
+}
+
+HAL_StatusTypeDef HAL_I2C_Mem_Read(I2C_HandleTypeDef *hi2c, uint16_t DevAddress,
+		uint16_t MemAddress, uint16_t MemAddSize, uint8_t *pData, uint16_t Size,
+		uint32_t Timeout)
+{
+	(void) DevAddress;
+	(void) MemAddress;
+	(void) MemAddSize;
+	(void) Timeout;
+
+	Test_Reads++;
+	if (Test_Nack)
+	{
+		// address is not acknowledged, START, address and STOP are on the wire
+		hi2c->ErrorCode = HAL_I2C_ERROR_AF;
+		Test_DWT.CYCCNT += Test_ReadCycles(hi2c->Init.ClockSpeed, 0) / 3;
+		return HAL_ERROR;
+	}
+
+	hi2c->ErrorCode = HAL_I2C_ERROR_NONE;
+	memset(pData, 0x5A, Size);
+	Test_DWT.CYCCNT += Test_ReadCycles(hi2c->Init.ClockSpeed, Size);
+
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_I2C_Mem_Write(I2C_HandleTypeDef *hi2c, uint16_t DevAddress,
+		uint16_t MemAddress, uint16_t MemAddSize, uint8_t *pData, uint16_t Size,
+		uint32_t Timeout)
+{
+	(void) DevAddress;
+	(void) MemAddress;
+	(void) MemAddSize;
+	(void) pData;
+	(void) Timeout;
+
+	Test_DWT.CYCCNT += Test_ReadCycles(hi2c->Init.ClockSpeed, Size);
+
+	return HAL_OK;
+}
+
+uint32_t HAL_I2C_GetError(I2C_HandleTypeDef *hi2c)
+{
+	return hi2c->ErrorCode;
+}
+
+HAL_StatusTypeDef HAL_I2C_Init(I2C_HandleTypeDef *hi2c)
+{
+	hi2c->State = HAL_I2C_STATE_READY;
+
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_I2C_DeInit(I2C_HandleTypeDef *hi2c)
+{
+	hi2c->State = HAL_I2C_STATE_RESET;
+
+	return HAL_OK;
+}
+
+void HAL_GPIO_Init(GPIO_TypeDef *GPIOx, GPIO_InitTypeDef *GPIO_Init)
+{
+	(void) GPIOx;
+	(void) GPIO_Init;
+}
+
+void HAL_NVIC_EnableIRQ(IRQn_Type IRQn)
+{
+	(void) IRQn;
+}
+
+/*
+ * Benchmark at speed has to give time of the model
+ */
+static uint32_t Test_Speed(uint32_t Speed)
+{
+	uint32_t ReadTime = 0;
+	uint32_t Expected;
+
+	hi2c1.Init.ClockSpeed = Speed;
+	hi2c1.State = HAL_I2C_STATE_READY;
+
+	if (I2CBus_Benchmark(&hi2c1, 0x48, 0x03, &ReadTime) != I2CBUS_BENCHMARK_OK)
+	{
+		Test_Fail("benchmark failed, speed", Speed);
+	}
+	if ((DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk) == 0
+			|| (CoreDebug->DEMCR & CoreDebug_DEMCR_TRCENA_Msk) == 0)
+	{
+		Test_Fail("cycle counter not enabled, speed", Speed);
+	}
+
+	Expected = Test_ReadCycles(Speed, 2) / (SystemCoreClock / 1000000);
+	if (ReadTime + 1 < Expected || ReadTime > Expected)
+	{
+		printf("%lu us per read, model %lu us\n", (unsigned long) ReadTime,
+				(unsigned long) Expected);
+		Test_Fail("wrong read time, speed", Speed);
+	}
+	printf("read at %lu kHz: %lu us (bus %lu bits, HAL %u cycles)\n",
+			(unsigned long) (Speed / 1000), (unsigned long) ReadTime,
+			(unsigned long) ((2 + I2CBUS_MEM_OVERHEAD) * I2CBUS_BITS_PER_BYTE
+					+ TEST_CONDITION_BITS), TEST_HAL_CYCLES);
+
+	return ReadTime;
+}
+
+/*
+ * Busy peripheral and NACK are not reported as time
+ */
+static void Test_NotTimed(void)
+{
+	uint32_t ReadTime = 12345;
+
+	Test_Reads = 0;
+	hi2c1.State = HAL_I2C_STATE_BUSY;
+	if (I2CBus_Benchmark(&hi2c1, 0x48, 0x03, &ReadTime) != I2CBUS_BENCHMARK_BUSY
+			|| Test_Reads != 0 || ReadTime != 12345)
+	{
+		Test_Fail("busy peripheral timed, reads", Test_Reads);
+	}
+	hi2c1.State = HAL_I2C_STATE_READY;
+
+	Test_Nack = 1;
+	if (I2CBus_Benchmark(&hi2c1, 0x48, 0x03, &ReadTime) != I2CBUS_BENCHMARK_FAILED
+			|| ReadTime != 12345)
+	{
+		Test_Fail("NACK timed, reads", Test_Reads);
+	}
+	Test_Nack = 0;
+	if (I2CBus_GetStats()->Nacks != 1)
+	{
+		Test_Fail("NACK not counted, nacks", I2CBus_GetStats()->Nacks);
+	}
+}
+
+int main(void)
+{
+	uint32_t Standard, Fast;
+
+	Pool_Init();
+
+	Standard = Test_Speed(I2CBUS_SPEED_STANDARD);
+	Fast = Test_Speed(I2CBUS_SPEED_FAST);
+	// counter wraps during benchmark
+	Test_DWT.CYCCNT = 0xFFFFF000;
+	Test_Speed(I2CBUS_SPEED_FAST);
+	Test_NotTimed();
+
+	printf("ok benchmark, fast read %lu.%02lu times faster\n",
+			(unsigned long) (Standard / Fast), (unsigned long) (Standard * 100 / Fast % 100));
+
+	return 0;
+}
@@ -0,0 +1,138 @@
+#!/usr/bin/env python3
+#
+# memreport.py
+#
+#  Created on: 19 October 2026
+#
+# Per module memory report from GNU ld map file of the build, and stack of every
+# function from .su files when the build used -fstack-usage.
+#
+#   python3 Tools/memreport.py Debug/STM32F401RE_BT.map
+#   python3 Tools/memreport.py Debug/STM32F401RE_BT.map --su Debug --top 20
+#
+# Flash is .text, .rodata and initial values of .data, RAM is .data and .bss.
+# MEM; command on target reports the totals, this shows who takes them.
+
+import argparse
+import os
+import re
+import sys
+from collections import defaultdict
+
+# input section name -> column
+SECTIONS = (
+    ('.text', 'text'),
+    ('.rodata', 'rodata'),
+    ('.data', 'data'),
+    ('.bss', 'bss'),
+    ('COMMON', 'bss'),
+)
+
+# " .text.Func   0x08000190   0x2c ./Core/Src/main.o", name can be on line before
+ENTRY = re.compile(r'^\s+(0x[0-9a-fA-F]+)\s+(0x[0-9a-fA-F]+)\s+(\S.*)$')
+NAMED = re.compile(r'^\s(\S+)\s+(0x[0-9a-fA-F]+)\s+(0x[0-9a-fA-F]+)\s+(\S.*)$')
+ALONE = re.compile(r'^\s(\S+)\s*$')
+
+
+def column(section):
+    for prefix, name in SECTIONS:
+        if section == prefix or section.startswith(prefix + '.'):
+            return name
+    return None
+
+
+def module(path):
+    # archive members "libc_nano.a(lib_a-memcpy.o)" are kept by library
+    name = os.path.basename(path.strip())
+    match = re.match(r'(.*\.a)\(', name)
+    return match.group(1) if match else name
+
+
+def read_map(path):
+    sizes = defaultdict(lambda: defaultdict(int))
+    section = None
+    in_map = False
+
+    with open(path, errors='replace') as file:
+        for line in file:
+            if line.startswith('Linker script and memory map'):
+                in_map = True
+                continue
+            if not in_map or line.startswith('OUTPUT('):
+                continue
+
+            match = NAMED.match(line)
+            if match:
+                section, size, obj = match.group(1), int(match.group(3), 16), match.group(4)
+            else:
+                match = ALONE.match(line)
+                if match:
+                    section = match.group(1)
+                    continue
+                match = ENTRY.match(line)
+                if not match or section is None:
+                    continue
+                size, obj = int(match.group(2), 16), match.group(3)
+                # symbol lines "0x... name" have no size column
+            name = column(section)
+            if name is None or size == 0 or not obj.endswith(('.o', ')')):
+                continue
+            sizes[module(obj)][name] += size
+            section = None
+
+    return sizes
+
+
+def read_su(directory):
+    stack = []
+    for root, _, files in os.walk(directory):
+        for name in files:
+            if not name.endswith('.su'):
+                continue
+            with open(os.path.join(root, name)) as file:
+                for line in file:
+                    parts = line.rstrip('\n').split('\t')
+                    if len(parts) >= 2 and parts[1].isdigit():
+                        stack.append((int(parts[1]), parts[0], parts[2] if len(parts) > 2 else ''))
+    return sorted(stack, reverse=True)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Per module flash and RAM use')
+    parser.add_argument('map', help='linker map file')
+    parser.add_argument('--su', help='directory with .su files of -fstack-usage')
+    parser.add_argument('--top', type=int, default=15, help='functions listed by stack use')
+    args = parser.parse_args()
+
+    sizes = read_map(args.map)
+    if not sizes:
+        sys.exit('no input sections found in ' + args.map)
+
+    rows = []
+    for name, size in sizes.items():
+        flash = size['text'] + size['rodata'] + size['data']
+        ram = size['data'] + size['bss']
+        rows.append((ram, flash, name, size))
+    rows.sort(reverse=True)
+
+    print('%-32s %8s %8s %8s %8s %8s %8s' % ('module', 'text', 'rodata', 'data', 'bss', 'flash', 'ram'))
+    total = defaultdict(int)
+    for ram, flash, name, size in rows:
+        print('%-32s %8d %8d %8d %8d %8d %8d' % (name[:32], size['text'], size['rodata'],
+                                                  size['data'], size['bss'], flash, ram))
+        for key in ('text', 'rodata', 'data', 'bss'):
+            total[key] += size[key]
+    print('%-32s %8d %8d %8d %8d %8d %8d' % ('total', total['text'], total['rodata'], total['data'],
+                                              total['bss'],
+                                              total['text'] + total['rodata'] + total['data'],
+                                              total['data'] + total['bss']))
+
+    if args.su:
+        print()
+        print('%8s  %-10s %s' % ('stack', 'type', 'function'))
+        for size, function, kind in read_su(args.su)[:args.top]:
+            print('%8d  %-10s %s' % (size, kind, function))
+
+
+if __name__ == '__main__':
+    main()